@@ -28,6 +28,9 @@
 #include <fstream>
 #include <utility>
 #include <iterator>
+#include <atomic>
+#include <thread>
+#include <set>
 
 #include <wx/datetime.h>
 #include <wx/filename.h>
@@ -40,6 +43,7 @@
 #include <glm/ext.hpp>
 
 #include "common.h"
+#include "streamwrapper.h"
 #include "3d_cache.h"
 #include "3d_info.h"
 #include "sg/scenegraph.h"
@@ -50,7 +54,11 @@
 
 #define MASK_3D_CACHE "3D_CACHE"
 
+// name of the file holding the index of the model file digests
+#define HASH_INDEX_FILE "hashindex.txt"
+
 static wxCriticalSection lock3D_cache;
+static wxCriticalSection lock3D_index;
 
 static bool isSHA1Same( const unsigned char* shaA, const unsigned char* shaB )
 {
@@ -105,6 +113,45 @@ static const wxString sha1ToWXString( const unsigned char* aSHA1Sum )
 }
 
 
+static bool hexToSHA1( const std::string& aHex, unsigned char* aSHA1Sum )
+{
+    if( aHex.size() != 40 )
+        return false;
+
+    for( int i = 0; i < 20; ++i )
+    {
+        unsigned char uc = 0;
+
+        for( int j = 0; j < 2; ++j )
+        {
+            char c = aHex[ 2 * i + j ];
+            uc <<= 4;
+
+            if( c >= '0' && c <= '9' )
+                uc |= c - '0';
+            else if( c >= 'a' && c <= 'f' )
+                uc |= c - 'a' + 10;
+            else
+                return false;
+        }
+
+        aSHA1Sum[i] = uc;
+    }
+
+    return true;
+}
+
+
+static void getFileStamp( const wxString& aFileName, long long& aModTime, long long& aSize )
+{
+    wxFileName fname( aFileName );
+    wxDateTime fmdate = fname.GetModificationTime();
+
+    aModTime = fmdate.IsValid() ? fmdate.GetValue().GetValue() : 0;
+    aSize = (long long) fname.GetSize().GetValue();
+}
+
+
 class S3D_CACHE_ENTRY
 {
 private:
@@ -190,6 +237,9 @@ S3D_CACHE::~S3D_CACHE()
 {
     FlushCache();
 
+    if( m_DirtyCache )
+        saveHashIndex();
+
     if( m_FNResolver )
         delete m_FNResolver;
 
@@ -232,7 +282,7 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCach
             if( fmdate != mi->second->modTime )
             {
                 unsigned char hashSum[20];
-                getSHA1( full3Dpath, hashSum );
+                getFileSHA1( full3Dpath, hashSum );
                 mi->second->modTime = fmdate;
 
                 if( !isSHA1Same( hashSum, mi->second->sha1sum ) )
@@ -274,6 +324,60 @@ SCENEGRAPH* S3D_CACHE::Load( const wxString& aModelFile )
 }
 
 
+void S3D_CACHE::LoadModels( const std::vector< wxString >& aModelFileNames )
+{
+    std::vector< wxString > toHash;
+    std::set< wxString >    seen;
+
+    do
+    {
+        wxCriticalSectionLocker lock( lock3D_cache );
+
+        for( const wxString& name : aModelFileNames )
+        {
+            wxString fullPath = m_FNResolver->ResolvePath( name );
+
+            if( fullPath.empty() || m_CacheMap.count( fullPath ) )
+                continue;
+
+            if( seen.insert( fullPath ).second )
+                toHash.push_back( fullPath );
+        }
+    } while( 0 );
+
+    // Reading and hashing the model files is the costly part of the cache lookup
+    // and does not touch the cache itself, so it is done concurrently. The plugins
+    // and the scene graph are not reentrant: the models are then loaded serially.
+    if( toHash.size() > 1 )
+    {
+        std::atomic<size_t>      nextFile( 0 );
+        std::vector<std::thread> workers;
+        size_t parallelThreadCount = std::min<size_t>( toHash.size(),
+                std::max<size_t>( std::thread::hardware_concurrency(), 2 ) );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        {
+            workers.push_back( std::thread( [this, &toHash, &nextFile]()
+            {
+                unsigned char sha1sum[20];
+
+                for( size_t i = nextFile.fetch_add( 1 ); i < toHash.size();
+                     i = nextFile.fetch_add( 1 ) )
+                {
+                    getFileSHA1( toHash[i], sha1sum );
+                }
+            } ) );
+        }
+
+        for( auto& worker : workers )
+            worker.join();
+    }
+
+    for( const wxString& fullPath : toHash )
+        load( fullPath );
+}
+
+
 SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr )
 {
     if( aCachePtr )
@@ -281,7 +385,7 @@ SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY**
 
     unsigned char sha1sum[20];
 
-    if( !getSHA1( aFileName, sha1sum ) || m_CacheDir.empty() )
+    if( !getFileSHA1( aFileName, sha1sum ) || m_CacheDir.empty() )
     {
         // just in case we can't get a hash digest (for example, on access issues)
         // or we do not have a configured cache file directory, we create an
@@ -428,6 +532,116 @@ bool S3D_CACHE::getSHA1( const wxString& aFileName, unsigned char* aSHA1Sum )
 }
 
 
+bool S3D_CACHE::getFileSHA1( const wxString& aFileName, unsigned char* aSHA1Sum )
+{
+    if( aFileName.empty() || NULL == aSHA1Sum )
+        return getSHA1( aFileName, aSHA1Sum );
+
+    long long modTime;
+    long long size;
+    getFileStamp( aFileName, modTime, size );
+
+    do
+    {
+        wxCriticalSectionLocker lock( lock3D_index );
+        std::map< wxString, S3D_FILE_HASH >::const_iterator hi = m_HashIndex.find( aFileName );
+
+        if( hi != m_HashIndex.end() && hi->second.modTime == modTime
+            && hi->second.size == size )
+        {
+            memcpy( aSHA1Sum, hi->second.sha1sum, 20 );
+            return true;
+        }
+    } while( 0 );
+
+    // the file is hashed outside of the lock so that several files may be
+    // processed at the same time (see LoadModels)
+    if( !getSHA1( aFileName, aSHA1Sum ) )
+        return false;
+
+    S3D_FILE_HASH fh;
+    fh.modTime = modTime;
+    fh.size = size;
+    memcpy( fh.sha1sum, aSHA1Sum, 20 );
+
+    wxCriticalSectionLocker lock( lock3D_index );
+    m_HashIndex[aFileName] = fh;
+    m_DirtyCache = true;
+
+    return true;
+}
+
+
+void S3D_CACHE::loadHashIndex( void )
+{
+    wxString fname = m_CacheDir + wxT( HASH_INDEX_FILE );
+
+    if( m_CacheDir.empty() || !wxFileName::FileExists( fname ) )
+        return;
+
+    OPEN_ISTREAM( file, fname.ToUTF8() );
+
+    if( file.fail() )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] could not read hash index '%s'\n",
+            fname.GetData() );
+        return;
+    }
+
+    wxCriticalSectionLocker lock( lock3D_index );
+    std::string line;
+
+    // each line holds: SHA1 digest, file size, modification time, file name
+    while( std::getline( file, line ) )
+    {
+        std::istringstream istr( line );
+        std::string hex;
+        S3D_FILE_HASH fh;
+
+        if( !( istr >> hex >> fh.size >> fh.modTime ) || !hexToSHA1( hex, fh.sha1sum ) )
+            continue;
+
+        std::string name;
+        istr.get();
+
+        if( !std::getline( istr, name ) || name.empty() )
+            continue;
+
+        m_HashIndex[ wxString::FromUTF8Unchecked( name.c_str() ) ] = fh;
+    }
+
+    CLOSE_STREAM( file );
+}
+
+
+void S3D_CACHE::saveHashIndex( void )
+{
+    if( m_CacheDir.empty() )
+        return;
+
+    wxString fname = m_CacheDir + wxT( HASH_INDEX_FILE );
+    OPEN_OSTREAM( file, fname.ToUTF8() );
+
+    if( file.fail() )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] could not write hash index '%s'\n",
+            fname.GetData() );
+        return;
+    }
+
+    wxCriticalSectionLocker lock( lock3D_index );
+
+    for( const auto& hi : m_HashIndex )
+    {
+        file << sha1ToWXString( hi.second.sha1sum ).ToUTF8() << " " << hi.second.size << " ";
+        file << hi.second.modTime << " " << hi.first.ToUTF8() << "\n";
+    }
+
+    CLOSE_STREAM( file );
+    m_DirtyCache = false;
+}
+
+
 bool S3D_CACHE::loadCacheData( S3D_CACHE_ENTRY* aCacheItem )
 {
     wxString bname = aCacheItem->GetCacheBaseName();
@@ -635,6 +849,8 @@ bool S3D_CACHE::Set3DConfigDir( const wxString& aConfigDir )
     }
 
     m_CacheDir = cfgdir.GetPathWithSep();
+    loadHashIndex();
+
     return true;
 }
 
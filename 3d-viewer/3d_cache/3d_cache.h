@@ -31,6 +31,7 @@
 
 #include <list>
 #include <map>
+#include <vector>
 #include <wx/string.h>
 #include "kicad_string.h"
 #include "filename_resolver.h"
@@ -46,6 +47,18 @@ class  FILENAME_RESOLVER;
 class  S3D_PLUGIN_MANAGER;
 
 
+/**
+ * Size and modification time of a model file together with its SHA1 digest;
+ * used to avoid hashing again the files which did not change.
+ */
+struct S3D_FILE_HASH
+{
+    long long     modTime;      // file modification time (ms since the epoch)
+    long long     size;         // file size
+    unsigned char sha1sum[20];
+};
+
+
 class S3D_CACHE
 {
 private:
@@ -73,6 +86,9 @@ private:
     /// current KiCad project dir
     wxString m_ProjDir;
 
+    /// SHA1 digests of the model files, persisted in the cache directory
+    std::map< wxString, S3D_FILE_HASH > m_HashIndex;
+
     /** Find or create cache entry for file name
      *
      * Searches the cache list for the given filename and retrieves
@@ -97,6 +113,25 @@ private:
      */
     bool getSHA1( const wxString& aFileName, unsigned char* aSHA1Sum );
 
+    /**
+     * Function getFileSHA1
+     * retrieves the SHA1 hash of the given file from the hash index; the
+     * hash is only calculated if the file is not indexed or if its size
+     * or modification time changed since it was indexed.
+     *
+     * @param[in]   aFileName   file name (full path)
+     * @param[out]  aSHA1Sum    a 20 byte character array to hold the SHA1 hash
+     * @retval      true        success
+     * @retval      false       failure
+     */
+    bool getFileSHA1( const wxString& aFileName, unsigned char* aSHA1Sum );
+
+    // load the hash index from the cache directory
+    void loadHashIndex( void );
+
+    // save the hash index to the cache directory
+    void saveHashIndex( void );
+
     // load scene data from a cache file
     bool loadCacheData( S3D_CACHE_ENTRY* aCacheItem );
 
@@ -167,6 +202,17 @@ public:
      */
     SCENEGRAPH* Load( const wxString& aModelFile );
 
+    /**
+     * Function LoadModels
+     * loads a list of models into the cache. The files of the distinct models
+     * which are not in the cache yet are read and hashed concurrently, then
+     * their scene data is loaded. Subsequent calls to Load() or GetModel()
+     * for these models will be served from the cache.
+     *
+     * @param aModelFileNames [in] are the partial or full paths of the models
+     */
+    void LoadModels( const std::vector< wxString >& aModelFileNames );
+
     FILENAME_RESOLVER* GetResolver( void );
 
     /**
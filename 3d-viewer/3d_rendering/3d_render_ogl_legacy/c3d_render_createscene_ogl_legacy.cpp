@@ -643,6 +643,7 @@ void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
         aStatusTextReporter->Report( _( "Loading 3D models" ) );
 
     load_3D_models( aStatusTextReporter );
+    build_3D_model_instances();
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_end_models_Load_Time = GetRunningMicroSecs();
@@ -930,6 +931,25 @@ void C3D_RENDER_OGL_LEGACY::load_3D_models( REPORTER *aStatusTextReporter )
         (!m_settings.GetFlag( FL_MODULE_ATTRIBUTES_VIRTUAL )) )
         return;
 
+    // Load the models not yet in our map all at once, so the cache manager
+    // can read them concurrently
+    std::vector< wxString > modelFileNames;
+
+    for( const MODULE* module = m_settings.GetBoard()->m_Modules;
+         module;
+         module = module->Next() )
+    {
+        for( const auto& model : module->Models() )
+        {
+            if( !model.m_Filename.empty()
+                && m_3dmodel_map.find( model.m_Filename ) == m_3dmodel_map.end() )
+                modelFileNames.push_back( model.m_Filename );
+        }
+    }
+
+    if( !modelFileNames.empty() )
+        m_settings.Get3DCacheManager()->LoadModels( modelFileNames );
+
     // Go for all modules
     for( const MODULE* module = m_settings.GetBoard()->m_Modules;
          module;
@@ -981,3 +1001,4 @@ void C3D_RENDER_OGL_LEGACY::load_3D_models( REPORTER *aStatusTextReporter )
         }
     }
 }
+
@@ -68,6 +68,10 @@ C3D_RENDER_OGL_LEGACY::C3D_RENDER_OGL_LEGACY( CINFO3D_VISU &aSettings ) :
     m_last_grid_type = GRID3D_NONE;
 
     m_3dmodel_map.clear();
+
+    m_model_stats.m_instances = 0;
+    m_model_stats.m_drawCalls = 0;
+    m_model_stats.m_vertices  = 0;
 }
 
 
@@ -691,6 +695,10 @@ bool C3D_RENDER_OGL_LEGACY::Redraw( bool aIsMoving,
     // Render 3D Models (Non-transparent)
     // /////////////////////////////////////////////////////////////////////////
 
+    m_model_stats.m_instances = 0;
+    m_model_stats.m_drawCalls = 0;
+    m_model_stats.m_vertices  = 0;
+
     //setLight_Top( false );
     //setLight_Bottom( true );
     render_3D_models( false, false );
@@ -737,6 +745,10 @@ bool C3D_RENDER_OGL_LEGACY::Redraw( bool aIsMoving,
     //setLight_Bottom( false );
     render_3D_models( true, true );
 
+    wxLogTrace( m_logTrace,
+                wxT( "C3D_RENDER_OGL_LEGACY::Redraw models: %u instances, %u draw calls, %u vertices" ),
+                m_model_stats.m_instances, m_model_stats.m_drawCalls, m_model_stats.m_vertices );
+
 
     // Render Grid
     // /////////////////////////////////////////////////////////////////////////
@@ -893,6 +905,9 @@ void C3D_RENDER_OGL_LEGACY::ogl_free_all_display_lists()
 
     m_3dmodel_map.clear();
 
+    m_model_instances[0].clear();
+    m_model_instances[1].clear();
+
 
     delete m_ogl_disp_list_board;
     m_ogl_disp_list_board = 0;
@@ -977,118 +992,142 @@ void C3D_RENDER_OGL_LEGACY::render_solder_mask_layer( PCB_LAYER_ID aLayerID,
 }
 
 
-void C3D_RENDER_OGL_LEGACY::render_3D_models( bool aRenderTopOrBot,
-                                              bool aRenderTransparentOnly )
+void C3D_RENDER_OGL_LEGACY::build_3D_model_instances()
 {
-    // Go for all modules
-    if( m_settings.GetBoard()->m_Modules.GetCount() )
-    {
-        for( const MODULE* module = m_settings.GetBoard()->m_Modules;
-             module;
-             module = module->Next() )
-        {
-            if( !module->Models().empty() )
-                if( m_settings.ShouldModuleBeDisplayed( (MODULE_ATTR_T)module->GetAttributes() ) )
-                    if( ( aRenderTopOrBot && !module->IsFlipped()) ||
-                        (!aRenderTopOrBot &&  module->IsFlipped()) )
-                        render_3D_module( module, aRenderTransparentOnly );
-        }
-    }
-}
+    m_model_instances[0].clear();
+    m_model_instances[1].clear();
 
+    // index of each model in the instances lists
+    std::map< const C_OGL_3DMODEL*, unsigned int > modelIndex[2];
 
-void C3D_RENDER_OGL_LEGACY::render_3D_module( const MODULE* module,
-                                              bool aRenderTransparentOnly )
-{
-    if( !module->Models().empty() )
-    {
-        const double zpos = m_settings.GetModulesZcoord3DIU( module->IsFlipped() );
+    const float biuTo3Dunits = m_settings.BiuTo3Dunits();
+    const float modelunit_to_3d_units_factor = biuTo3Dunits * UNITS3D_TO_UNITSPCB;
 
-        glPushMatrix();
+    for( const MODULE* module = m_settings.GetBoard()->m_Modules;
+         module;
+         module = module->Next() )
+    {
+        if( module->Models().empty() ||
+            !m_settings.ShouldModuleBeDisplayed( (MODULE_ATTR_T)module->GetAttributes() ) )
+            continue;
 
-        wxPoint pos = module->GetPosition();
+        const int side = module->IsFlipped() ? 0 : 1;
+        const wxPoint pos = module->GetPosition();
 
-        glTranslatef(  pos.x * m_settings.BiuTo3Dunits(),
-                      -pos.y * m_settings.BiuTo3Dunits(),
-                       zpos );
+        // Same transform as the glTranslate / glRotate / glScale sequence
+        // used to place a module
+        glm::mat4 moduleMatrix = glm::translate( glm::mat4( 1.0f ),
+                SFVEC3F( pos.x * biuTo3Dunits,
+                        -pos.y * biuTo3Dunits,
+                         m_settings.GetModulesZcoord3DIU( module->IsFlipped() ) ) );
 
         if( module->GetOrientation() )
-            glRotated( (double) module->GetOrientation() / 10.0, 0.0, 0.0, 1.0 );
+            moduleMatrix = glm::rotate( moduleMatrix,
+                                        glm::radians( (float) module->GetOrientation() / 10.0f ),
+                                        SFVEC3F( 0.0f, 0.0f, 1.0f ) );
 
         if( module->IsFlipped() )
         {
-            glRotatef( 180.0f, 0.0f, 1.0f, 0.0f );
-            glRotatef( 180.0f, 0.0f, 0.0f, 1.0f );
+            moduleMatrix = glm::rotate( moduleMatrix, glm::pi<float>(),
+                                        SFVEC3F( 0.0f, 1.0f, 0.0f ) );
+            moduleMatrix = glm::rotate( moduleMatrix, glm::pi<float>(),
+                                        SFVEC3F( 0.0f, 0.0f, 1.0f ) );
         }
 
-        double modelunit_to_3d_units_factor = m_settings.BiuTo3Dunits() * UNITS3D_TO_UNITSPCB;
+        moduleMatrix = glm::scale( moduleMatrix, SFVEC3F( modelunit_to_3d_units_factor ) );
 
-        glScaled( modelunit_to_3d_units_factor,
-                  modelunit_to_3d_units_factor,
-                  modelunit_to_3d_units_factor );
+        for( const auto& model : module->Models() )
+        {
+            if( model.m_Filename.empty() )
+                continue;
 
-        // Get the list of model files for this model
-        auto sM = module->Models().begin();
-        auto eM = module->Models().end();
+            MAP_3DMODEL::const_iterator ii = m_3dmodel_map.find( model.m_Filename );
 
-        while( sM != eM )
-        {
-            if( !sM->m_Filename.empty() )
+            if( ii == m_3dmodel_map.end() || ii->second == NULL )
+                continue;
+
+            glm::mat4 modelMatrix = glm::translate( moduleMatrix,
+                    SFVEC3F( model.m_Offset.x, model.m_Offset.y, model.m_Offset.z ) );
+
+            modelMatrix = glm::rotate( modelMatrix, glm::radians( (float) -model.m_Rotation.z ),
+                                       SFVEC3F( 0.0f, 0.0f, 1.0f ) );
+            modelMatrix = glm::rotate( modelMatrix, glm::radians( (float) -model.m_Rotation.y ),
+                                       SFVEC3F( 0.0f, 1.0f, 0.0f ) );
+            modelMatrix = glm::rotate( modelMatrix, glm::radians( (float) -model.m_Rotation.x ),
+                                       SFVEC3F( 1.0f, 0.0f, 0.0f ) );
+
+            modelMatrix = glm::scale( modelMatrix,
+                    SFVEC3F( model.m_Scale.x, model.m_Scale.y, model.m_Scale.z ) );
+
+            auto inserted = modelIndex[side].insert(
+                    std::make_pair( ii->second, m_model_instances[side].size() ) );
+
+            if( inserted.second )
             {
-                // Check if the model is present in our cache map
-                if( m_3dmodel_map.find( sM->m_Filename ) != m_3dmodel_map.end() )
-                {
-                    // It is not present, try get it from cache
-                    const C_OGL_3DMODEL *modelPtr = m_3dmodel_map[ sM->m_Filename ];
+                OGL_MODEL_INSTANCES instances;
+                instances.m_model = ii->second;
+                m_model_instances[side].push_back( instances );
+            }
+
+            m_model_instances[side][inserted.first->second].m_transforms.push_back( modelMatrix );
+        }
+    }
+}
+
 
-                    if( modelPtr )
-                    {
-                        if( ( (!aRenderTransparentOnly) && modelPtr->Have_opaque() ) ||
-                            ( aRenderTransparentOnly && modelPtr->Have_transparent() ) )
-                        {
-                            glPushMatrix();
+void C3D_RENDER_OGL_LEGACY::render_3D_models( bool aRenderTopOrBot,
+                                              bool aRenderTransparentOnly )
+{
+    // All the instances of a model are rendered in a row, using the transforms
+    // computed when the scene was loaded
+    const LIST_MODEL_INSTANCES& instancesList = m_model_instances[aRenderTopOrBot ? 1 : 0];
+    const bool showBBox = m_settings.GetFlag( FL_RENDER_OPENGL_SHOW_MODEL_BBOX );
 
-                            glTranslatef( sM->m_Offset.x, sM->m_Offset.y, sM->m_Offset.z );
+    for( const OGL_MODEL_INSTANCES& instances : instancesList )
+    {
+        const C_OGL_3DMODEL* modelPtr = instances.m_model;
 
-                            glRotatef( -sM->m_Rotation.z, 0.0f, 0.0f, 1.0f );
-                            glRotatef( -sM->m_Rotation.y, 0.0f, 1.0f, 0.0f );
-                            glRotatef( -sM->m_Rotation.x, 1.0f, 0.0f, 0.0f );
+        if( !( ( (!aRenderTransparentOnly) && modelPtr->Have_opaque() ) ||
+               ( aRenderTransparentOnly && modelPtr->Have_transparent() ) ) )
+            continue;
 
-                            glScalef( sM->m_Scale.x, sM->m_Scale.y, sM->m_Scale.z );
+        for( const glm::mat4& transform : instances.m_transforms )
+        {
+            glPushMatrix();
 
-                            if( aRenderTransparentOnly )
-                                modelPtr->Draw_transparent();
-                            else
-                                modelPtr->Draw_opaque();
+            glMultMatrixf( glm::value_ptr( transform ) );
 
-                            if( m_settings.GetFlag( FL_RENDER_OPENGL_SHOW_MODEL_BBOX ) )
-                            {
-                                glEnable( GL_BLEND );
-                                glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+            if( aRenderTransparentOnly )
+                modelPtr->Draw_transparent();
+            else
+                modelPtr->Draw_opaque();
 
-                                glLineWidth( 1 );
-                                modelPtr->Draw_bboxes();
+            if( showBBox )
+            {
+                glEnable( GL_BLEND );
+                glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
 
-                                glDisable( GL_LIGHTING );
+                glLineWidth( 1 );
+                modelPtr->Draw_bboxes();
 
-                                glColor4f( 0.0f, 1.0f, 0.0f, 1.0f );
+                glDisable( GL_LIGHTING );
 
-                                glLineWidth( 4 );
-                                modelPtr->Draw_bbox();
+                glColor4f( 0.0f, 1.0f, 0.0f, 1.0f );
 
-                                glEnable( GL_LIGHTING );
-                            }
+                glLineWidth( 4 );
+                modelPtr->Draw_bbox();
 
-                            glPopMatrix();
-                        }
-                    }
-                }
+                glEnable( GL_LIGHTING );
             }
 
-            ++sM;
+            glPopMatrix();
         }
 
-        glPopMatrix();
+        const unsigned int nrInstances = instances.m_transforms.size();
+
+        m_model_stats.m_instances += nrInstances;
+        m_model_stats.m_drawCalls += nrInstances * modelPtr->Get_draw_calls( aRenderTransparentOnly );
+        m_model_stats.m_vertices  += nrInstances * modelPtr->Get_vertices( aRenderTransparentOnly );
     }
 }
 
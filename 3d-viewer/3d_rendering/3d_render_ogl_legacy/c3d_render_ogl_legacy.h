@@ -45,12 +45,37 @@
 #include "3d_cache/3d_info.h"
 
 #include <map>
+#include <vector>
 
 
 typedef std::map< PCB_LAYER_ID, CLAYERS_OGL_DISP_LISTS* > MAP_OGL_DISP_LISTS;
 typedef std::map< PCB_LAYER_ID, CLAYER_TRIANGLES * > MAP_TRIANGLES;
 typedef std::map< wxString, C_OGL_3DMODEL * > MAP_3DMODEL;
 
+/**
+ * @brief The OGL_MODEL_INSTANCES struct stores the transforms of all the
+ * placements of a 3D model, so all the instances of a model are rendered
+ * together
+ */
+struct OGL_MODEL_INSTANCES
+{
+    const C_OGL_3DMODEL*     m_model;
+    std::vector< glm::mat4 > m_transforms;
+};
+
+typedef std::vector< OGL_MODEL_INSTANCES > LIST_MODEL_INSTANCES;
+
+/**
+ * @brief The OGL_MODEL_RENDER_STATS struct holds the counters of the 3D models
+ * rendered in the last frame
+ */
+struct OGL_MODEL_RENDER_STATS
+{
+    unsigned int m_instances;   ///< model instances rendered
+    unsigned int m_drawCalls;   ///< mesh display lists called
+    unsigned int m_vertices;    ///< vertices (face indexes) submitted
+};
+
 #define SIZE_OF_CIRCLE_TEXTURE 1024
 
 /**
@@ -106,6 +131,11 @@ private:
 
     MAP_3DMODEL m_3dmodel_map;
 
+    /// placements of the models of the modules, bottom [0] and top [1]
+    LIST_MODEL_INSTANCES m_model_instances[2];
+
+    OGL_MODEL_RENDER_STATS m_model_stats;
+
 private:
     void generate_through_outer_holes();
     void generate_through_inner_holes();
@@ -176,6 +206,12 @@ private:
 
     void load_3D_models( REPORTER *aStatusTextReporter );
 
+    /**
+     * @brief build_3D_model_instances - group the placements of the loaded
+     * models by model and compute their transforms
+     */
+    void build_3D_model_instances();
+
     /**
      * @brief render_3D_models
      * @param aRenderTopOrBot - true will render Top, false will render bottom
@@ -184,8 +220,6 @@ private:
      */
     void render_3D_models( bool aRenderTopOrBot, bool aRenderTransparentOnly );
 
-    void render_3D_module( const MODULE* module, bool aRenderTransparentOnly );
-
     void setLight_Front( bool enabled );
     void setLight_Top( bool enabled );
     void setLight_Bottom( bool enabled );
@@ -215,6 +249,11 @@ public:
     const MAP_OGL_DISP_LISTS &GetLayerDispListMap() const { return m_ogl_disp_lists_layers; }
     const CLAYERS_OGL_DISP_LISTS *GetLayerDispList( PCB_LAYER_ID aLayerId ) const { return m_ogl_disp_lists_layers.at( aLayerId ); }
     const CLAYERS_OGL_DISP_LISTS *GetBoardDispList() const { return m_ogl_disp_list_board; }
+
+    /**
+     * @brief GetModelRenderStats - Get the 3D model counters of the last frame
+     */
+    const OGL_MODEL_RENDER_STATS &GetModelRenderStats() const { return m_model_stats; }
 };
 
 #endif // C3D_RENDER_OGL_LEGACY_H_
@@ -42,6 +42,10 @@ C_OGL_3DMODEL::C_OGL_3DMODEL( const S3DMODEL &a3DModel,
     m_ogl_idx_list_transparent = 0;
     m_nr_meshes = 0;
     m_meshs_bbox = NULL;
+    m_nr_opaque_draw_calls = 0;
+    m_nr_opaque_vertices = 0;
+    m_nr_transparent_draw_calls = 0;
+    m_nr_transparent_vertices = 0;
 
     // Validate a3DModel pointers
     wxASSERT( a3DModel.m_Materials != NULL );
@@ -251,6 +255,9 @@ C_OGL_3DMODEL::C_OGL_3DMODEL( const S3DMODEL &a3DModel,
                     {
                         have_opaque_meshes = true; // Flag that we have at least one opaque mesh
                         glCallList( m_ogl_idx_list_meshes + mesh_i );
+
+                        m_nr_opaque_draw_calls++;
+                        m_nr_opaque_vertices += mesh.m_FaceIdxSize;
                     }
                     else
                     {
@@ -293,7 +300,12 @@ C_OGL_3DMODEL::C_OGL_3DMODEL( const S3DMODEL &a3DModel,
 
                             // Render the transparent mesh if it have a transparency value
                             if( material.m_Transparency != 0.0f )
+                            {
                                 glCallList( m_ogl_idx_list_meshes + mesh_i );
+
+                                m_nr_transparent_draw_calls++;
+                                m_nr_transparent_vertices += mesh.m_FaceIdxSize;
+                            }
                         }
                     }
 
@@ -84,12 +84,37 @@ public:
      */
     const CBBOX &GetBBox() const { return m_model_bbox; }
 
+    /**
+     * @brief Get_draw_calls - Get the number of meshes rendered by one call
+     * of Draw_opaque or Draw_transparent
+     * @param aTransparent: true for the transparent meshes
+     */
+    unsigned int Get_draw_calls( bool aTransparent ) const
+    {
+        return aTransparent ? m_nr_transparent_draw_calls : m_nr_opaque_draw_calls;
+    }
+
+    /**
+     * @brief Get_vertices - Get the number of vertices (face indexes) rendered
+     * by one call of Draw_opaque or Draw_transparent
+     * @param aTransparent: true for the transparent meshes
+     */
+    unsigned int Get_vertices( bool aTransparent ) const
+    {
+        return aTransparent ? m_nr_transparent_vertices : m_nr_opaque_vertices;
+    }
+
 private:
     GLuint  m_ogl_idx_list_opaque;      ///< display list for rendering opaque meshes
     GLuint  m_ogl_idx_list_transparent; ///< display list for rendering transparent meshes
     GLuint  m_ogl_idx_list_meshes;      ///< display lists for all meshes.
     unsigned int m_nr_meshes;           ///< number of meshes of this model
 
+    unsigned int m_nr_opaque_draw_calls;        ///< opaque meshes in the display list
+    unsigned int m_nr_opaque_vertices;          ///< face indexes of the opaque meshes
+    unsigned int m_nr_transparent_draw_calls;   ///< transparent meshes in the display list
+    unsigned int m_nr_transparent_vertices;     ///< face indexes of the transparent meshes
+
     CBBOX   m_model_bbox;               ///< global bounding box for this model
     CBBOX  *m_meshs_bbox;               ///< individual bbox for each mesh
 };
@@ -29,6 +29,15 @@
 
 #include "cbvh_pbrt.h"
 #include <wx/debug.h>
+#include <cfloat>
+#include <cmath>
+
+#if defined( __AVX__ )
+#include <immintrin.h>
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define BVH_SIMD_SSE2
+#endif
 
 
 #define BVH_RANGED_TRAVERSAL
@@ -45,45 +54,373 @@ struct StackNode
 };
 
 
-static inline unsigned int getFirstHit( const RAYPACKET &aRayPacket,
-                                        const CBBOX &aBBox,
-                                        unsigned int ia,
-                                        HITINFO_PACKET *aHitInfoPacket )
+#ifdef BVH_RANGED_TRAVERSAL
+
+/**
+ * The rays of a packet in SoA layout, so the kernels below can test
+ * BVH_SIMD_WIDTH rays at once against a node or a triangle.
+ */
+struct RAYPACKET_SOA
 {
-    float hitT;
+    float m_origin[3][RAYPACKET_RAYS_PER_PACKET];
+    float m_dir[3][RAYPACKET_RAYS_PER_PACKET];
+    float m_invDir[3][RAYPACKET_RAYS_PER_PACKET];
 
-    if( aBBox.Intersect( aRayPacket.m_ray[ia], &hitT ) )
-        if( hitT < aHitInfoPacket[ia].m_HitInfo.m_tHit )
-            return ia;
+    /// A copy of the m_tHit of the hit packet, updated on each primitive hit
+    float m_tHit[RAYPACKET_RAYS_PER_PACKET];
 
-    if( !aRayPacket.m_Frustum.Intersect( aBBox ) )
-        return RAYPACKET_RAYS_PER_PACKET;
+    RAYPACKET_SOA( const RAYPACKET &aRayPacket, const HITINFO_PACKET *aHitInfoPacket )
+    {
+        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        {
+            const RAY &ray = aRayPacket.m_ray[i];
+
+            for( unsigned int axis = 0; axis < 3; ++axis )
+            {
+                m_origin[axis][i] = ray.m_Origin[axis];
+                m_dir[axis][i] = ray.m_Dir[axis];
+
+                // Avoid 0 * inf (NaN) on the slab test for axis aligned rays
+                float invDir = ray.m_InvDir[axis];
+
+                if( !std::isfinite( invDir ) )
+                    invDir = ( ray.m_Dir[axis] < 0.0f ) ? -1.0e30f : 1.0e30f;
+
+                m_invDir[axis][i] = invDir;
+            }
+
+            m_tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+        }
+    }
+};
+
+
+// Tolerance of the triangle pre-test, the final test is done by
+// CTRIANGLE::Intersect so the kernel must never reject a ray that it accepts
+#define TRIANGLE_KERNEL_EPSILON 1.0e-5f
+
+
+#if defined( __AVX__ ) || defined( BVH_SIMD_SSE2 )
+
+#if defined( __AVX__ )
+
+#define BVH_SIMD_WIDTH 8
+
+typedef __m256 SIMD_FLOAT;
+
+static inline SIMD_FLOAT simd_load( const float *p ) { return _mm256_loadu_ps( p ); }
+static inline SIMD_FLOAT simd_set1( float v ) { return _mm256_set1_ps( v ); }
+static inline SIMD_FLOAT simd_add( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm256_add_ps( a, b ); }
+static inline SIMD_FLOAT simd_sub( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm256_sub_ps( a, b ); }
+static inline SIMD_FLOAT simd_mul( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm256_mul_ps( a, b ); }
+static inline SIMD_FLOAT simd_div( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm256_div_ps( a, b ); }
+static inline SIMD_FLOAT simd_min( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm256_min_ps( a, b ); }
+static inline SIMD_FLOAT simd_max( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm256_max_ps( a, b ); }
+static inline SIMD_FLOAT simd_and( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm256_and_ps( a, b ); }
+static inline SIMD_FLOAT simd_cmplt( SIMD_FLOAT a, SIMD_FLOAT b )
+{
+    return _mm256_cmp_ps( a, b, _CMP_LT_OQ );
+}
+static inline SIMD_FLOAT simd_cmple( SIMD_FLOAT a, SIMD_FLOAT b )
+{
+    return _mm256_cmp_ps( a, b, _CMP_LE_OQ );
+}
+static inline unsigned int simd_movemask( SIMD_FLOAT a )
+{
+    return (unsigned int)_mm256_movemask_ps( a );
+}
+
+#else
+
+#define BVH_SIMD_WIDTH 4
+
+typedef __m128 SIMD_FLOAT;
 
-    for( unsigned int i = ia + 1; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+static inline SIMD_FLOAT simd_load( const float *p ) { return _mm_loadu_ps( p ); }
+static inline SIMD_FLOAT simd_set1( float v ) { return _mm_set1_ps( v ); }
+static inline SIMD_FLOAT simd_add( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm_add_ps( a, b ); }
+static inline SIMD_FLOAT simd_sub( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm_sub_ps( a, b ); }
+static inline SIMD_FLOAT simd_mul( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm_mul_ps( a, b ); }
+static inline SIMD_FLOAT simd_div( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm_div_ps( a, b ); }
+static inline SIMD_FLOAT simd_min( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm_min_ps( a, b ); }
+static inline SIMD_FLOAT simd_max( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm_max_ps( a, b ); }
+static inline SIMD_FLOAT simd_and( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm_and_ps( a, b ); }
+static inline SIMD_FLOAT simd_cmplt( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm_cmplt_ps( a, b ); }
+static inline SIMD_FLOAT simd_cmple( SIMD_FLOAT a, SIMD_FLOAT b ) { return _mm_cmple_ps( a, b ); }
+static inline unsigned int simd_movemask( SIMD_FLOAT a )
+{
+    return (unsigned int)_mm_movemask_ps( a );
+}
+
+#endif
+
+
+/**
+ * @brief bboxGroupMask - slab test of BVH_SIMD_WIDTH rays against a bounding box
+ * @return a bit mask of the rays (starting on aFirst) that hit the box before
+ * their current hit distance
+ */
+static inline unsigned int bboxGroupMask( const RAYPACKET_SOA &aPacket,
+                                          const CBBOX &aBBox,
+                                          unsigned int aFirst )
+{
+    const SFVEC3F &bmin = aBBox.Min();
+    const SFVEC3F &bmax = aBBox.Max();
+
+    SIMD_FLOAT tNear = simd_set1( -FLT_MAX );
+    SIMD_FLOAT tFar  = simd_set1( FLT_MAX );
+
+    for( unsigned int axis = 0; axis < 3; ++axis )
     {
-        if( aBBox.Intersect( aRayPacket.m_ray[i], &hitT ) )
-            if( hitT < aHitInfoPacket[i].m_HitInfo.m_tHit )
-                return i;
+        const SIMD_FLOAT o   = simd_load( &aPacket.m_origin[axis][aFirst] );
+        const SIMD_FLOAT inv = simd_load( &aPacket.m_invDir[axis][aFirst] );
+
+        const SIMD_FLOAT t0 = simd_mul( simd_sub( simd_set1( bmin[axis] ), o ), inv );
+        const SIMD_FLOAT t1 = simd_mul( simd_sub( simd_set1( bmax[axis] ), o ), inv );
+
+        tNear = simd_max( tNear, simd_min( t0, t1 ) );
+        tFar  = simd_min( tFar,  simd_max( t0, t1 ) );
     }
 
-    return RAYPACKET_RAYS_PER_PACKET;
+    const SIMD_FLOAT tHit = simd_load( &aPacket.m_tHit[aFirst] );
+
+    const SIMD_FLOAT hit = simd_and( simd_and( simd_cmple( tNear, tFar ),
+                                               simd_cmple( simd_set1( 0.0f ), tFar ) ),
+                                     simd_cmplt( tNear, tHit ) );
+
+    return simd_movemask( hit );
 }
 
 
-#ifdef BVH_RANGED_TRAVERSAL
+/**
+ * @brief triangleGroupMask - pre-test BVH_SIMD_WIDTH rays against a triangle
+ * of the SoA table, using the same projection method of CTRIANGLE::Intersect
+ * @return a bit mask of the rays (starting on aFirst) that may hit the triangle
+ */
+static inline unsigned int triangleGroupMask( const RAYPACKET_SOA &aPacket,
+                                              const BVH_TRIANGLES_SOA &aTriangles,
+                                              unsigned int aTri,
+                                              unsigned int aFirst )
+{
+    static const unsigned int s_modulo[] = { 0, 1, 2, 0, 1 };
 
-static inline unsigned int getLastHit( const RAYPACKET &aRayPacket,
+    const unsigned int k  = aTriangles.k[aTri];
+    const unsigned int ku = s_modulo[k + 1];
+    const unsigned int kv = s_modulo[k + 2];
+
+    const SIMD_FLOAT Ok  = simd_load( &aPacket.m_origin[k][aFirst] );
+    const SIMD_FLOAT Oku = simd_load( &aPacket.m_origin[ku][aFirst] );
+    const SIMD_FLOAT Okv = simd_load( &aPacket.m_origin[kv][aFirst] );
+    const SIMD_FLOAT Dk  = simd_load( &aPacket.m_dir[k][aFirst] );
+    const SIMD_FLOAT Dku = simd_load( &aPacket.m_dir[ku][aFirst] );
+    const SIMD_FLOAT Dkv = simd_load( &aPacket.m_dir[kv][aFirst] );
+
+    const SIMD_FLOAT nu = simd_set1( aTriangles.nu[aTri] );
+    const SIMD_FLOAT nv = simd_set1( aTriangles.nv[aTri] );
+
+    const SIMD_FLOAT lnd = simd_div( simd_set1( 1.0f ),
+                                     simd_add( simd_add( Dk, simd_mul( nu, Dku ) ),
+                                               simd_mul( nv, Dkv ) ) );
+
+    const SIMD_FLOAT t = simd_mul( simd_sub( simd_sub( simd_sub( simd_set1( aTriangles.nd[aTri] ),
+                                                                 Ok ),
+                                                       simd_mul( nu, Oku ) ),
+                                             simd_mul( nv, Okv ) ),
+                                   lnd );
+
+    const SIMD_FLOAT zero = simd_set1( 0.0f );
+
+    SIMD_FLOAT valid = simd_and( simd_cmplt( t, simd_load( &aPacket.m_tHit[aFirst] ) ),
+                                 simd_cmplt( zero, t ) );
+
+    if( !simd_movemask( valid ) )
+        return 0;
+
+    const SIMD_FLOAT hu = simd_sub( simd_add( Oku, simd_mul( t, Dku ) ),
+                                    simd_set1( aTriangles.au[aTri] ) );
+    const SIMD_FLOAT hv = simd_sub( simd_add( Okv, simd_mul( t, Dkv ) ),
+                                    simd_set1( aTriangles.av[aTri] ) );
+
+    const SIMD_FLOAT beta  = simd_add( simd_mul( hv, simd_set1( aTriangles.bnu[aTri] ) ),
+                                       simd_mul( hu, simd_set1( aTriangles.bnv[aTri] ) ) );
+    const SIMD_FLOAT gamma = simd_add( simd_mul( hu, simd_set1( aTriangles.cnu[aTri] ) ),
+                                       simd_mul( hv, simd_set1( aTriangles.cnv[aTri] ) ) );
+
+    const SIMD_FLOAT minusEps = simd_set1( -TRIANGLE_KERNEL_EPSILON );
+
+    valid = simd_and( valid, simd_cmple( minusEps, beta ) );
+    valid = simd_and( valid, simd_cmple( minusEps, gamma ) );
+    valid = simd_and( valid, simd_cmple( simd_add( beta, gamma ),
+                                         simd_set1( 1.0f + TRIANGLE_KERNEL_EPSILON ) ) );
+
+    // Back face culling, dot( D, n ) <= 0
+    const SIMD_FLOAT dotDN =
+            simd_add( simd_add( simd_mul( simd_load( &aPacket.m_dir[0][aFirst] ),
+                                          simd_set1( aTriangles.nx[aTri] ) ),
+                                simd_mul( simd_load( &aPacket.m_dir[1][aFirst] ),
+                                          simd_set1( aTriangles.ny[aTri] ) ) ),
+                      simd_mul( simd_load( &aPacket.m_dir[2][aFirst] ),
+                                simd_set1( aTriangles.nz[aTri] ) ) );
+
+    valid = simd_and( valid, simd_cmple( dotDN, zero ) );
+
+    return simd_movemask( valid );
+}
+
+#else   // Scalar fallback
+
+#define BVH_SIMD_WIDTH 4
+
+static inline unsigned int bboxGroupMask( const RAYPACKET_SOA &aPacket,
+                                          const CBBOX &aBBox,
+                                          unsigned int aFirst )
+{
+    unsigned int mask = 0;
+
+    for( unsigned int lane = 0; lane < BVH_SIMD_WIDTH; ++lane )
+    {
+        const unsigned int i = aFirst + lane;
+
+        float tNear = -FLT_MAX;
+        float tFar  = FLT_MAX;
+
+        for( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            const float t0 = ( aBBox.Min()[axis] - aPacket.m_origin[axis][i] ) *
+                             aPacket.m_invDir[axis][i];
+            const float t1 = ( aBBox.Max()[axis] - aPacket.m_origin[axis][i] ) *
+                             aPacket.m_invDir[axis][i];
+
+            tNear = std::max( tNear, std::min( t0, t1 ) );
+            tFar  = std::min( tFar,  std::max( t0, t1 ) );
+        }
+
+        if( ( tNear <= tFar ) && ( 0.0f <= tFar ) && ( tNear < aPacket.m_tHit[i] ) )
+            mask |= 1 << lane;
+    }
+
+    return mask;
+}
+
+
+static inline unsigned int triangleGroupMask( const RAYPACKET_SOA &aPacket,
+                                              const BVH_TRIANGLES_SOA &aTriangles,
+                                              unsigned int aTri,
+                                              unsigned int aFirst )
+{
+    static const unsigned int s_modulo[] = { 0, 1, 2, 0, 1 };
+
+    const unsigned int k  = aTriangles.k[aTri];
+    const unsigned int ku = s_modulo[k + 1];
+    const unsigned int kv = s_modulo[k + 2];
+
+    unsigned int mask = 0;
+
+    for( unsigned int lane = 0; lane < BVH_SIMD_WIDTH; ++lane )
+    {
+        const unsigned int i = aFirst + lane;
+
+        const float lnd = 1.0f / ( aPacket.m_dir[k][i] +
+                                   aTriangles.nu[aTri] * aPacket.m_dir[ku][i] +
+                                   aTriangles.nv[aTri] * aPacket.m_dir[kv][i] );
+
+        const float t = ( aTriangles.nd[aTri] - aPacket.m_origin[k][i] -
+                          aTriangles.nu[aTri] * aPacket.m_origin[ku][i] -
+                          aTriangles.nv[aTri] * aPacket.m_origin[kv][i] ) * lnd;
+
+        if( !( ( t < aPacket.m_tHit[i] ) && ( 0.0f < t ) ) )
+            continue;
+
+        const float hu = aPacket.m_origin[ku][i] + t * aPacket.m_dir[ku][i] - aTriangles.au[aTri];
+        const float hv = aPacket.m_origin[kv][i] + t * aPacket.m_dir[kv][i] - aTriangles.av[aTri];
+
+        const float beta  = hv * aTriangles.bnu[aTri] + hu * aTriangles.bnv[aTri];
+        const float gamma = hu * aTriangles.cnu[aTri] + hv * aTriangles.cnv[aTri];
+
+        if( ( beta < -TRIANGLE_KERNEL_EPSILON ) ||
+            ( gamma < -TRIANGLE_KERNEL_EPSILON ) ||
+            ( ( beta + gamma ) > ( 1.0f + TRIANGLE_KERNEL_EPSILON ) ) )
+            continue;
+
+        const float dotDN = aPacket.m_dir[0][i] * aTriangles.nx[aTri] +
+                            aPacket.m_dir[1][i] * aTriangles.ny[aTri] +
+                            aPacket.m_dir[2][i] * aTriangles.nz[aTri];
+
+        if( dotDN > 0.0f )
+            continue;
+
+        mask |= 1 << lane;
+    }
+
+    return mask;
+}
+
+#endif
+
+
+#define BVH_SIMD_GROUP_MASK (~(unsigned int)(BVH_SIMD_WIDTH - 1))
+
+
+static inline unsigned int getFirstHit( const RAYPACKET &aRayPacket,
+                                        const RAYPACKET_SOA &aPacketSoA,
+                                        const CBBOX &aBBox,
+                                        unsigned int ia )
+{
+    // Test first the group of the first alive ray, most of the times it will hit
+    unsigned int group = ia & BVH_SIMD_GROUP_MASK;
+    unsigned int mask = bboxGroupMask( aPacketSoA, aBBox, group ) & ( ~0u << ( ia - group ) );
+
+    if( !mask )
+    {
+        if( !aRayPacket.m_Frustum.Intersect( aBBox ) )
+            return RAYPACKET_RAYS_PER_PACKET;
+
+        for( group += BVH_SIMD_WIDTH; group < RAYPACKET_RAYS_PER_PACKET; group += BVH_SIMD_WIDTH )
+        {
+            mask = bboxGroupMask( aPacketSoA, aBBox, group );
+
+            if( mask )
+                break;
+        }
+
+        if( !mask )
+            return RAYPACKET_RAYS_PER_PACKET;
+    }
+
+    unsigned int lane = 0;
+
+    while( !( mask & ( 1 << lane ) ) )
+        ++lane;
+
+    return group + lane;
+}
+
+
+static inline unsigned int getLastHit( const RAYPACKET_SOA &aPacketSoA,
                                        const CBBOX &aBBox,
-                                       unsigned int ia,
-                                       HITINFO_PACKET *aHitInfoPacket )
+                                       unsigned int ia )
 {
-    for( unsigned int ie = (RAYPACKET_RAYS_PER_PACKET - 1); ie > ia; --ie )
+    const unsigned int firstGroup = ia & BVH_SIMD_GROUP_MASK;
+
+    for( int group = RAYPACKET_RAYS_PER_PACKET - BVH_SIMD_WIDTH;
+         group >= (int)firstGroup;
+         group -= BVH_SIMD_WIDTH )
     {
-        float hitT;
+        unsigned int mask = bboxGroupMask( aPacketSoA, aBBox, group );
 
-        if( aBBox.Intersect( aRayPacket.m_ray[ie], &hitT ) )
-            if( hitT < aHitInfoPacket[ie].m_HitInfo.m_tHit )
-                return ie + 1;
+        // Only the rays after ia are searched
+        if( group == (int)firstGroup )
+            mask &= ~0u << ( ia - group + 1 );
+
+        if( mask )
+        {
+            int lane = BVH_SIMD_WIDTH - 1;
+
+            while( !( mask & ( 1 << lane ) ) )
+                --lane;
+
+            return group + lane + 1;
+        }
     }
 
     return ia + 1;
@@ -107,13 +444,15 @@ bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
     int todoOffset = 0, nodeNum = 0;
     StackNode todo[MAX_TODOS];
 
+    RAYPACKET_SOA packetSoA( aRayPacket, aHitInfoPacket );
+
     unsigned int ia = 0;
 
     while( true )
     {
         const LinearBVHNode *curCell = &m_nodes[nodeNum];
 
-        ia = getFirstHit( aRayPacket, curCell->bounds, ia, aHitInfoPacket );
+        ia = getFirstHit( aRayPacket, packetSoA, curCell->bounds, ia );
 
         if( ia < RAYPACKET_RAYS_PER_PACKET )
         {
@@ -127,16 +466,48 @@ bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
             }
             else
             {
-                const unsigned int ie = getLastHit( aRayPacket,
-                                                    curCell->bounds,
-                                                    ia,
-                                                    aHitInfoPacket );
+                const unsigned int ie = getLastHit( packetSoA, curCell->bounds, ia );
 
                 for( int j = 0; j < curCell->nPrimitives; ++j )
                 {
-                    const COBJECT *obj = m_primitives[curCell->primitivesOffset + j];
+                    const unsigned int primNr = curCell->primitivesOffset + j;
+                    const COBJECT *obj = m_primitives[primNr];
 
-                    if( aRayPacket.m_Frustum.Intersect( obj->GetBBox() ) )
+                    if( !aRayPacket.m_Frustum.Intersect( obj->GetBBox() ) )
+                        continue;
+
+                    if( m_triangles.k[primNr] != BVH_SOA_NOT_A_TRIANGLE )
+                    {
+                        // Pre-test the rays in groups and only intersect the
+                        // candidates with the triangle
+                        for( unsigned int group = ia & BVH_SIMD_GROUP_MASK;
+                             group < ie;
+                             group += BVH_SIMD_WIDTH )
+                        {
+                            unsigned int mask = triangleGroupMask( packetSoA,
+                                                                   m_triangles,
+                                                                   primNr,
+                                                                   group );
+
+                            for( unsigned int lane = 0; mask; ++lane, mask >>= 1 )
+                            {
+                                const unsigned int i = group + lane;
+
+                                if( !( mask & 1 ) || ( i < ia ) || ( i >= ie ) )
+                                    continue;
+
+                                if( obj->Intersect( aRayPacket.m_ray[i],
+                                                    aHitInfoPacket[i].m_HitInfo ) )
+                                {
+                                    anyHitted = true;
+                                    aHitInfoPacket[i].m_hitresult = true;
+                                    aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
+                                    packetSoA.m_tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+                                }
+                            }
+                        }
+                    }
+                    else
                     {
                         for( unsigned int i = ia; i < ie; ++i )
                         {
@@ -148,6 +519,7 @@ bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
                                 anyHitted |= hitted;
                                 aHitInfoPacket[i].m_hitresult |= hitted;
                                 aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
+                                packetSoA.m_tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
                             }
                         }
                     }
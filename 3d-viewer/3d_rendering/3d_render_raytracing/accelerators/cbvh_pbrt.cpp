@@ -68,6 +68,7 @@
 
 #include "cbvh_pbrt.h"
 #include "../../../3d_fastmath.h"
+#include "../shapes3D/ctriangle.h"
 #include <vector>
 #include <boost/range/algorithm/partition.hpp>
 #include <boost/range/algorithm/nth_element.hpp>
@@ -304,6 +305,8 @@ CBVH_PBRT::CBVH_PBRT( const CGENERICCONTAINER &aObjectContainer,
 
     wxASSERT( offset == (unsigned int)totalNodes );
 
+    buildTrianglesSoA();
+
 #ifdef PRINT_STATISTICS_3D_VIEWER
     uint32_t treeBytes = totalNodes * sizeof( LinearBVHNode ) + sizeof( *this ) +
                          m_primitives.size() * sizeof( m_primitives[0] ) +
@@ -1124,6 +1127,50 @@ int CBVH_PBRT::flattenBVHTree( BVHBuildNode *node, uint32_t *offset )
 }
 
 
+void CBVH_PBRT::buildTrianglesSoA()
+{
+    const size_t nPrims = m_primitives.size();
+
+    m_triangles.k.resize( nPrims, BVH_SOA_NOT_A_TRIANGLE );
+    m_triangles.nu.resize( nPrims, 0.0f );
+    m_triangles.nv.resize( nPrims, 0.0f );
+    m_triangles.nd.resize( nPrims, 0.0f );
+    m_triangles.bnu.resize( nPrims, 0.0f );
+    m_triangles.bnv.resize( nPrims, 0.0f );
+    m_triangles.cnu.resize( nPrims, 0.0f );
+    m_triangles.cnv.resize( nPrims, 0.0f );
+    m_triangles.au.resize( nPrims, 0.0f );
+    m_triangles.av.resize( nPrims, 0.0f );
+    m_triangles.nx.resize( nPrims, 0.0f );
+    m_triangles.ny.resize( nPrims, 0.0f );
+    m_triangles.nz.resize( nPrims, 0.0f );
+
+    for( size_t i = 0; i < nPrims; ++i )
+    {
+        if( m_primitives[i]->GetObjectType() != OBJ3D_TRIANGLE )
+            continue;
+
+        TRIANGLE_INTERSECT_CONSTANTS tc;
+
+        static_cast<const CTRIANGLE *>( m_primitives[i] )->GetIntersectConstants( tc );
+
+        m_triangles.k[i]   = tc.k;
+        m_triangles.nu[i]  = tc.nu;
+        m_triangles.nv[i]  = tc.nv;
+        m_triangles.nd[i]  = tc.nd;
+        m_triangles.bnu[i] = tc.bnu;
+        m_triangles.bnv[i] = tc.bnv;
+        m_triangles.cnu[i] = tc.cnu;
+        m_triangles.cnv[i] = tc.cnv;
+        m_triangles.au[i]  = tc.au;
+        m_triangles.av[i]  = tc.av;
+        m_triangles.nx[i]  = tc.n.x;
+        m_triangles.ny[i]  = tc.n.y;
+        m_triangles.nz[i]  = tc.n.z;
+    }
+}
+
+
 #define MAX_TODOS 64
 
 bool CBVH_PBRT::Intersect( const RAY &aRay, HITINFO &aHitInfo ) const
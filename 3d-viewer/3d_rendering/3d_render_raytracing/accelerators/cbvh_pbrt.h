@@ -72,6 +72,7 @@
 
 #include "caccelerator.h"
 #include <list>
+#include <vector>
 #include <stdint.h>
 
 // Forward Declarations
@@ -98,6 +99,33 @@ struct LinearBVHNode
 };
 
 
+/// Value of BVH_TRIANGLES_SOA::k for primitives that are not triangles
+#define BVH_SOA_NOT_A_TRIANGLE 0xFF
+
+/**
+ * Intersection constants of the triangles of the BVH leaves, in SoA layout.
+ * The arrays are indexed in the same order of the primitives, so the
+ * triangles of a leaf are contiguous and can be tested against a ray packet
+ * with SIMD kernels.
+ */
+struct BVH_TRIANGLES_SOA
+{
+    std::vector<uint8_t> k;     ///< dominant axis or BVH_SOA_NOT_A_TRIANGLE
+    std::vector<float> nu;
+    std::vector<float> nv;
+    std::vector<float> nd;
+    std::vector<float> bnu;
+    std::vector<float> bnv;
+    std::vector<float> cnu;
+    std::vector<float> cnv;
+    std::vector<float> au;
+    std::vector<float> av;
+    std::vector<float> nx;
+    std::vector<float> ny;
+    std::vector<float> nz;
+};
+
+
 enum SPLITMETHOD
 {
     SPLIT_MIDDLE,
@@ -153,11 +181,14 @@ private:
     int flattenBVHTree( BVHBuildNode *node,
                         uint32_t *offset );
 
+    void buildTrianglesSoA();
+
     // BVH Private Data
     const int           m_maxPrimsInNode;
     SPLITMETHOD         m_splitMethod;
     CONST_VECTOR_OBJECT m_primitives;
     LinearBVHNode       *m_nodes;
+    BVH_TRIANGLES_SOA   m_triangles;
 
     std::list<void *> m_addresses_pointer_to_mm_free;
 
@@ -908,9 +908,7 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
     // Create an accelerator
     // /////////////////////////////////////////////////////////////////////////
 
-#ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_startAcceleratorTime = GetRunningMicroSecs();
-#endif
 
     if( m_accelerator )
     {
@@ -921,9 +919,9 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
     //m_accelerator = new CGRID( m_object_container );
     m_accelerator = new CBVH_PBRT( m_object_container );
 
-#ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endAcceleratorTime = GetRunningMicroSecs();
-#endif
+
+    m_stats_accelerator_time = stats_endAcceleratorTime - stats_startAcceleratorTime;
 
     setupMaterials();
 
@@ -1199,6 +1197,27 @@ void C3D_RENDER_RAYTRACING::add_3D_vias_and_pads_to_container()
 
 void C3D_RENDER_RAYTRACING::load_3D_models()
 {
+    // Load the models of the displayed modules all at once, so the cache
+    // manager can read them concurrently
+    std::vector< wxString > modelFileNames;
+
+    for( const MODULE* module = m_settings.GetBoard()->m_Modules;
+         module;
+         module = module->Next() )
+    {
+        if( !m_settings.ShouldModuleBeDisplayed( (MODULE_ATTR_T)module->GetAttributes() ) )
+            continue;
+
+        for( const auto& model : module->Models() )
+        {
+            if( !model.m_Filename.empty() )
+                modelFileNames.push_back( model.m_Filename );
+        }
+    }
+
+    if( !modelFileNames.empty() )
+        m_settings.Get3DCacheManager()->LoadModels( modelFileNames );
+
     // Go for all modules
     for( const MODULE* module = m_settings.GetBoard()->m_Modules;
          module;
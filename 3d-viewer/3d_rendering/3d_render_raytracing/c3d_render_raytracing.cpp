@@ -29,6 +29,7 @@
 
 #include <GL/glew.h>
 #include <climits>
+#include <mutex>
 
 #include "c3d_render_raytracing.h"
 #include "mortoncodes.h"
@@ -37,6 +38,7 @@
 #include "3d_math.h"
 #include "../common_ogl/ogl_utils.h"
 #include <profile.h>        // To use GetRunningMicroSecs or another profiling utility
+#include <wx/image.h>       // Used to save the offscreen render to disk
 
 // This should be used in future for the function
 // convertLinearToSRGB
@@ -71,6 +73,7 @@ C3D_RENDER_RAYTRACING::C3D_RENDER_RAYTRACING( CINFO3D_VISU &aSettings ) :
     m_isPreview = false;
     m_rt_render_state = RT_RENDER_STATE_MAX; // Set to an initial invalid state
     m_stats_start_rendering_time = 0;
+    m_stats_accelerator_time = 0;
     m_nrBlocksRenderProgress = 0;
 }
 
@@ -165,6 +168,7 @@ bool C3D_RENDER_RAYTRACING::Redraw( bool aIsMoving, REPORTER *aStatusTextReporte
         // revert to preview mode the first time the Redraw is called
         m_oldWindowsSize = m_windowSize;
         initialize_block_positions();
+        opengl_init_pbo();
     }
 
     wxBusyCursor dummy;
@@ -191,6 +195,7 @@ bool C3D_RENDER_RAYTRACING::Redraw( bool aIsMoving, REPORTER *aStatusTextReporte
         requestRedraw = true;
 
         initialize_block_positions();
+        opengl_init_pbo();
     }
 
 
@@ -298,6 +303,180 @@ bool C3D_RENDER_RAYTRACING::Redraw( bool aIsMoving, REPORTER *aStatusTextReporte
 }
 
 
+bool C3D_RENDER_RAYTRACING::RenderToImage( const wxSize &aSize,
+                                           const wxString &aFileName,
+                                           RT_RENDER_STATS *aStats,
+                                           REPORTER *aStatusTextReporter )
+{
+    // The block positions need at least a fast preview block on each axis
+    if( ( aSize.x < (int)( 4 * RAYPACKET_DIM + 4 ) ) ||
+        ( aSize.y < (int)( 4 * RAYPACKET_DIM + 4 ) ) )
+        return false;
+
+    m_settings.CameraGet().SetCurWindowSize( aSize );
+
+    m_windowSize = aSize;
+    m_oldWindowsSize = aSize;
+
+    initialize_block_positions();
+
+    // Build the scene and the accelerator
+    // /////////////////////////////////////////////////////////////////////////
+    const unsigned stats_startReloadTime = GetRunningMicroSecs();
+
+    reload( aStatusTextReporter );
+
+    const unsigned stats_endReloadTime = GetRunningMicroSecs();
+
+    if( !m_accelerator )
+        return false;
+
+    // Trace all the blocks, the offscreen buffer is RGBA as the PBO
+    // /////////////////////////////////////////////////////////////////////////
+    std::vector< GLubyte > buffer( m_realBufferSize.x * m_realBufferSize.y * 4 );
+
+    m_settings.CameraGet().ParametersChanged();
+
+    restart_render_state();
+
+    if( m_camera_light )
+        m_camera_light->SetDirection( -m_settings.CameraGet().GetDir() );
+
+    m_BgColorTop_LinearRGB = ConvertSRGBToLinear( (SFVEC3F)m_settings.m_BgColorTop );
+    m_BgColorBot_LinearRGB = ConvertSRGBToLinear( (SFVEC3F)m_settings.m_BgColorBot );
+
+    while( m_rt_render_state == RT_RENDER_STATE_TRACING )
+        rt_render_tracing( &buffer[0], aStatusTextReporter );
+
+    const unsigned stats_endTraceTime = GetRunningMicroSecs();
+
+    if( m_rt_render_state == RT_RENDER_STATE_POST_PROCESS_SHADE )
+        rt_render_post_process_shade( &buffer[0], aStatusTextReporter );
+
+    if( m_rt_render_state == RT_RENDER_STATE_POST_PROCESS_BLUR_AND_FINISH )
+        rt_render_post_process_blur_finish( &buffer[0], aStatusTextReporter );
+
+    const unsigned stats_endPostShadeTime = GetRunningMicroSecs();
+
+    wxASSERT( m_rt_render_state == RT_RENDER_STATE_FINISH );
+
+    if( aStats )
+    {
+        aStats->m_acceleratorBuildTime = m_stats_accelerator_time;
+        aStats->m_sceneBuildTime = ( stats_endReloadTime - stats_startReloadTime ) -
+                                   m_stats_accelerator_time;
+        aStats->m_traceTime = stats_endTraceTime - stats_endReloadTime;
+        aStats->m_postShadeTime = stats_endPostShadeTime - stats_endTraceTime;
+    }
+
+    // Compose the final image, the render buffer is centered on the window
+    // and the borders are filled with the background (as it is done by
+    // OGL_DrawBackground on the canvas)
+    // /////////////////////////////////////////////////////////////////////////
+
+    // From wxWidgets documentation: the data must have been allocated with
+    // malloc(), NOT with operator new.
+    unsigned char *rgbBuffer = (unsigned char*) malloc( aSize.x * aSize.y * 3 );
+
+    if( !rgbBuffer )
+        return false;
+
+    for( int y = 0; y < aSize.y; ++y )
+    {
+        const float posYfactor = (float)y / (float)aSize.y;
+
+        const SFVEC3F bgColor = (SFVEC3F)m_settings.m_BgColorTop * SFVEC3F( posYfactor ) +
+                                (SFVEC3F)m_settings.m_BgColorBot *
+                                ( SFVEC3F( 1.0f ) - SFVEC3F( posYfactor ) );
+
+        GLubyte bgPixel[4];
+        rt_final_color( bgPixel, bgColor, false );
+
+        const int bufferY = y - (int)m_yoffset;
+
+        // The output image origin is at top, while the buffer is at bottom
+        unsigned char *dst = &rgbBuffer[ ( aSize.y - 1 - y ) * aSize.x * 3 ];
+
+        for( int x = 0; x < aSize.x; ++x, dst += 3 )
+        {
+            const int bufferX = x - (int)m_xoffset;
+
+            const GLubyte *src = bgPixel;
+
+            if( ( bufferX >= 0 ) && ( bufferX < (int)m_realBufferSize.x ) &&
+                ( bufferY >= 0 ) && ( bufferY < (int)m_realBufferSize.y ) )
+                src = &buffer[ ( bufferX + bufferY * m_realBufferSize.x ) * 4 ];
+
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+        }
+    }
+
+    // Headless applications do not call wxInitAllImageHandlers(): register the PNG
+    // handler here, once, since the boards may be rendered from several threads
+    static std::once_flag pngHandlerFlag;
+
+    std::call_once( pngHandlerFlag, []()
+    {
+        if( !wxImage::FindHandler( wxBITMAP_TYPE_PNG ) )
+            wxImage::AddHandler( new wxPNGHandler );
+    } );
+
+    wxImage image( aSize.x, aSize.y );
+    image.SetData( rgbBuffer );
+
+    const bool saved = image.SaveFile( aFileName + ".png", wxBITMAP_TYPE_PNG );
+
+    image.Destroy();
+
+    return saved;
+}
+
+
+bool RenderBoardToImage( BOARD *aBoard,
+                         S3D_CACHE *aCachePointer,
+                         const wxSize &aSize,
+                         const SFVEC3F &aRotation,
+                         float aZoom,
+                         const wxString &aFileName,
+                         RT_RENDER_STATS *aStats )
+{
+    wxCHECK_MSG( aBoard, false, wxT( "RenderBoardToImage: NULL board" ) );
+
+    CINFO3D_VISU settings;
+
+    settings.SetBoard( aBoard );
+    settings.Set3DCacheManager( aCachePointer );
+    settings.RenderEngineSet( RENDER_ENGINE_RAYTRACING );
+
+    settings.SetFlag( FL_MODULE_ATTRIBUTES_NORMAL, aCachePointer != NULL );
+    settings.SetFlag( FL_MODULE_ATTRIBUTES_NORMAL_INSERT, aCachePointer != NULL );
+    settings.SetFlag( FL_MODULE_ATTRIBUTES_VIRTUAL, aCachePointer != NULL );
+    settings.SetFlag( FL_RENDER_RAYTRACING_SHADOWS, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_REFRACTIONS, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_REFLECTIONS, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_ANTI_ALIASING, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_PROCEDURAL_TEXTURES, true );
+
+    CCAMERA &camera = settings.CameraGet();
+
+    camera.SetCurWindowSize( aSize );
+    camera.Reset();
+    camera.RotateX( aRotation.x );
+    camera.RotateY( aRotation.y );
+    camera.RotateZ( aRotation.z );
+
+    if( aZoom > 0.0f )
+        camera.Zoom( aZoom );
+
+    C3D_RENDER_RAYTRACING render( settings );
+
+    return render.RenderToImage( aSize, aFileName, aStats );
+}
+
+
 void C3D_RENDER_RAYTRACING::render( GLubyte *ptrPBO , REPORTER *aStatusTextReporter )
 {
     if( (m_rt_render_state == RT_RENDER_STATE_FINISH) ||
@@ -2106,6 +2285,4 @@ void C3D_RENDER_RAYTRACING::initialize_block_positions()
     // Create m_shader buffer
     delete[] m_shaderBuffer;
     m_shaderBuffer = new SFVEC3F[m_realBufferSize.x * m_realBufferSize.y];
-
-    opengl_init_pbo();
 }
@@ -56,6 +56,15 @@ typedef enum
     RT_RENDER_STATE_MAX
 }RT_RENDER_STATE;
 
+/// Timing (in microseconds) of each phase of an offscreen render
+struct RT_RENDER_STATS
+{
+    unsigned int m_sceneBuildTime;      ///< Board conversion and 3D models loading
+    unsigned int m_acceleratorBuildTime;///< BVH construction
+    unsigned int m_traceTime;           ///< Ray tracing of all the blocks
+    unsigned int m_postShadeTime;       ///< Post processing shader and blur
+};
+
 class C3D_RENDER_RAYTRACING : public C3D_RENDER_BASE
 {
 public:
@@ -69,6 +78,23 @@ public:
 
     int GetWaitForEditingTimeOut() override;
 
+    /**
+     * @brief RenderToImage - Ray trace the current board into an offscreen
+     * buffer and save it as a PNG file. It does not use any OpenGL call so it
+     * can be used without a canvas (eg: from headless applications).
+     * The camera of the settings is used as it is, only its window size is
+     * updated to aSize.
+     * @param aSize: the resolution of the output image
+     * @param aFileName: the file name of the output image (without extension)
+     * @param aStats: if not NULL, it will be filled with the time of each phase
+     * @param aStatusTextReporter: a pointer to the status progress reporter
+     * @return true if the image was rendered and saved
+     */
+    bool RenderToImage( const wxSize &aSize,
+                        const wxString &aFileName,
+                        RT_RENDER_STATS *aStats = NULL,
+                        REPORTER *aStatusTextReporter = NULL );
+
 private:
     bool initializeOpenGL();
     void initializeNewWindowSize();
@@ -130,6 +156,9 @@ private:
     /// Time that the render starts
     unsigned long int m_stats_start_rendering_time;
 
+    /// Time spent on the last accelerator construction (us)
+    unsigned int m_stats_accelerator_time;
+
     /// Save the number of blocks progress of the render
     long m_nrBlocksRenderProgress;
 
@@ -207,6 +236,26 @@ private:
     void render_preview( GLubyte *ptrPBO );
 };
 
+/**
+ * @brief RenderBoardToImage - Ray trace a board offscreen and save the result
+ * as a PNG file, without any OpenGL context or canvas.
+ * @param aBoard: the board to render
+ * @param aCachePointer: the 3D model cache manager, NULL to skip the 3D models
+ * @param aSize: the resolution of the output image
+ * @param aRotation: camera rotation (in radians) around the X, Y and Z axis
+ * @param aZoom: zoom factor applied to the default camera (1.0 for no zoom)
+ * @param aFileName: the file name of the output image (without extension)
+ * @param aStats: if not NULL, it will be filled with the time of each phase
+ * @return true if the image was rendered and saved
+ */
+bool RenderBoardToImage( BOARD *aBoard,
+                         S3D_CACHE *aCachePointer,
+                         const wxSize &aSize,
+                         const SFVEC3F &aRotation,
+                         float aZoom,
+                         const wxString &aFileName,
+                         RT_RENDER_STATS *aStats = NULL );
+
 #define USE_SRGB_SPACE
 
 #ifdef USE_SRGB_SPACE
@@ -214,6 +214,22 @@ void CTRIANGLE::SetUV( const SFVEC2F &aUV1,
 
 static const unsigned int s_modulo[] = { 0, 1, 2, 0, 1 };
 
+void CTRIANGLE::GetIntersectConstants( TRIANGLE_INTERSECT_CONSTANTS &aConstants ) const
+{
+    aConstants.k   = m_k;
+    aConstants.nu  = m_nu;
+    aConstants.nv  = m_nv;
+    aConstants.nd  = m_nd;
+    aConstants.bnu = m_bnu;
+    aConstants.bnv = m_bnv;
+    aConstants.cnu = m_cnu;
+    aConstants.cnv = m_cnv;
+    aConstants.au  = m_vertex[0][s_modulo[m_k + 1]];
+    aConstants.av  = m_vertex[0][s_modulo[m_k + 2]];
+    aConstants.n   = m_n;
+}
+
+
 bool CTRIANGLE::Intersect( const RAY &aRay, HITINFO &aHitInfo ) const
 {
     //!TODO: precalc this, improove it
@@ -36,6 +36,20 @@
 
 #include "cobject.h"
 
+/**
+ * Precalculated constants of the triangle used by the ray intersection test,
+ * it can be used by the accelerators to store the triangles in SoA layout
+ */
+struct TRIANGLE_INTERSECT_CONSTANTS
+{
+    unsigned int k;         ///< dominant axis of the normal
+    float nu, nv, nd;
+    float bnu, bnv;
+    float cnu, cnv;
+    float au, av;           ///< first vertex projected on the (k+1, k+2) axis
+    SFVEC3F n;              ///< not normalized face normal
+};
+
 /**
  * A triangle object
  */
@@ -69,6 +83,8 @@ public:
     bool Intersects( const CBBOX &aBBox ) const override;
     SFVEC3F GetDiffuseColor( const HITINFO &aHitInfo ) const override;
 
+    void GetIntersectConstants( TRIANGLE_INTERSECT_CONSTANTS &aConstants ) const;
+
 private:
     void pre_calc_const();
 
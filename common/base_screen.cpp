@@ -37,8 +37,14 @@
 #include <id.h>
 #include <base_units.h>
 
+#include <atomic>
+
 wxString BASE_SCREEN::m_PageLayoutDescrFileName;   // the name of the page layout descr file.
 
+// The serial number of the last modification of any screen.  Screens can be modified
+// by the threads loading a project.
+static std::atomic<unsigned> s_lastModifySerial( 0 );
+
 BASE_SCREEN::BASE_SCREEN( KICAD_T aType ) :
     EDA_ITEM( aType )
 {
@@ -55,6 +61,7 @@ BASE_SCREEN::BASE_SCREEN( KICAD_T aType ) :
     m_ScrollPixelsPerUnitY = 1;
 
     m_FlagModified     = false;     // Set when any change is made on board.
+    m_ModifySerial     = 0;
     m_FlagSave         = false;     // Used in auto save set when an auto save is required.
 
     SetCurItem( NULL );
@@ -66,6 +73,13 @@ BASE_SCREEN::~BASE_SCREEN()
 }
 
 
+void BASE_SCREEN::SetModify()
+{
+    m_FlagModified = true;
+    m_ModifySerial = ++s_lastModifySerial;
+}
+
+
 void BASE_SCREEN::InitDataPoints( const wxSize& aPageSizeIU )
 {
     if( m_Center )
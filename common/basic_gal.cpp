@@ -39,10 +39,12 @@
 
 using namespace KIGFX;
 
-KIGFX::GAL_DISPLAY_OPTIONS basic_displayOptions;
+// Each thread has its basic GAL, so boards can be plotted or checked concurrently.
+// They are cheap to create: the stroke font glyphs are shared.
+thread_local KIGFX::GAL_DISPLAY_OPTIONS basic_displayOptions;
 
 // the basic GAL doesn't get an external display option object
-BASIC_GAL basic_gal( basic_displayOptions );
+thread_local BASIC_GAL basic_gal( basic_displayOptions );
 
 const VECTOR2D BASIC_GAL::transform( const VECTOR2D& aPoint ) const
 {
@@ -65,39 +67,61 @@ void BASIC_GAL::DrawPolyline( const std::deque<VECTOR2D>& aPointList )
         polyline_corners.push_back( wxPoint( corner.x, corner.y ) );
     }
 
+    drawPolyline( polyline_corners );
+}
+
+void BASIC_GAL::DrawPolyline( const VECTOR2D aPointList[], int aListSize )
+{
+    if( aListSize <= 0 )
+        return;
+
+    std::vector <wxPoint> polyline_corners;
+    polyline_corners.reserve( aListSize );
+
+    for( int ii = 0; ii < aListSize; ++ii )
+    {
+        VECTOR2D corner = transform( aPointList[ii] );
+        polyline_corners.push_back( wxPoint( corner.x, corner.y ) );
+    }
+
+    drawPolyline( polyline_corners );
+}
+
+void BASIC_GAL::drawPolyline( std::vector<wxPoint>& aCorners )
+{
     if( m_DC )
     {
         if( isFillEnabled )
         {
-            GRPoly( m_isClipped ? &m_clipBox : NULL, m_DC, polyline_corners.size(),
-                    &polyline_corners[0], 0, GetLineWidth(), m_Color, m_Color );
+            GRPoly( m_isClipped ? &m_clipBox : NULL, m_DC, aCorners.size(),
+                    &aCorners[0], 0, GetLineWidth(), m_Color, m_Color );
         }
         else
         {
-            for( unsigned ii = 1; ii < polyline_corners.size(); ++ii )
+            for( unsigned ii = 1; ii < aCorners.size(); ++ii )
             {
-                GRCSegm( m_isClipped ? &m_clipBox : NULL, m_DC, polyline_corners[ii-1],
-                         polyline_corners[ii], GetLineWidth(), m_Color );
+                GRCSegm( m_isClipped ? &m_clipBox : NULL, m_DC, aCorners[ii-1],
+                         aCorners[ii], GetLineWidth(), m_Color );
             }
         }
     }
     else if( m_plotter )
     {
-        m_plotter->MoveTo( polyline_corners[0] );
+        m_plotter->MoveTo( aCorners[0] );
 
-        for( unsigned ii = 1; ii < polyline_corners.size(); ii++ )
+        for( unsigned ii = 1; ii < aCorners.size(); ii++ )
         {
-            m_plotter->LineTo( polyline_corners[ii] );
+            m_plotter->LineTo( aCorners[ii] );
         }
 
         m_plotter->PenFinish();
     }
     else if( m_callback )
     {
-        for( unsigned ii = 1; ii < polyline_corners.size(); ii++ )
+        for( unsigned ii = 1; ii < aCorners.size(); ii++ )
         {
-            m_callback( polyline_corners[ii-1].x, polyline_corners[ii-1].y,
-                        polyline_corners[ii].x, polyline_corners[ii].y, m_callbackData );
+            m_callback( aCorners[ii-1].x, aCorners[ii-1].y,
+                        aCorners[ii].x, aCorners[ii].y, m_callbackData );
         }
     }
 }
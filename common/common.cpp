@@ -43,6 +43,8 @@
 
 #include <pgm_base.h>
 
+#include <mutex>
+
 using KIGFX::COLOR4D;
 
 
@@ -159,8 +161,12 @@ int ProcessExecute( const wxString& aCommandLine, int aFlags, wxProcess *callbac
 timestamp_t GetNewTimeStamp()
 {
     static timestamp_t oldTimeStamp;
+    static std::mutex  timeStampMutex;
     timestamp_t newTimeStamp;
 
+    // Items can be created by several threads, e.g. when loading schematic sheets.
+    std::lock_guard<std::mutex> lock( timeStampMutex );
+
     newTimeStamp = time( NULL );
 
     if( newTimeStamp <= oldTimeStamp )
@@ -0,0 +1,276 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <dir_watcher.h>
+
+#include <wx/dir.h>
+#include <wx/filename.h>
+
+#include <climits>
+#include <map>
+#include <mutex>
+
+#ifndef __WINDOWS__
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <sys/vfs.h>
+#endif
+
+
+#ifdef __linux__
+
+/**
+ * inotify only sees the changes made through the local kernel: a file modified on the
+ * server or by another client of a network file system does not send any event.
+ * @return true if aPath is on a network or FUSE file system, which are not watched.
+ */
+static bool isRemoteFileSystem( const wxString& aPath )
+{
+    struct statfs fs;
+
+    if( statfs( aPath.fn_str(), &fs ) != 0 )
+        return true;
+
+    switch( (unsigned) fs.f_type )
+    {
+    case 0x6969:        // NFS
+    case 0x517B:        // SMB
+    case 0xFF534D42:    // CIFS
+    case 0xFE534D42:    // SMB2
+    case 0x564C:        // NCP
+    case 0x73757245:    // CODA
+    case 0x5346414F:    // AFS
+    case 0x6B414653:    // kAFS
+    case 0x00C36400:    // CEPH
+    case 0x01021997:    // 9P
+    case 0x65735546:    // FUSE (sshfs, davfs, ...)
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
+/**
+ * A single inotify instance shared by all the watchers, because the number of instances
+ * per user is small (128 by default) and there can be hundreds of watched libraries.
+ * The events are not used for themselves: only their count per watch descriptor is kept.
+ */
+class INOTIFY_HUB
+{
+    typedef std::lock_guard<std::mutex> GUARD;
+
+    std::mutex                          m_mutex;
+    int                                 m_fd;
+    std::map<int, int>                  m_refs;         ///< watchers per watch descriptor
+    std::map<int, unsigned long long>   m_events;       ///< events per watch descriptor
+    unsigned long long                  m_overflows;    ///< lost events: all may have changed
+
+    INOTIFY_HUB() :
+        m_overflows( 0 )
+    {
+        m_fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+    }
+
+    ~INOTIFY_HUB()
+    {
+        if( m_fd >= 0 )
+            close( m_fd );
+    }
+
+    // Count the events waiting in the inotify queue.  Must be called with m_mutex locked.
+    void readEvents()
+    {
+        char    buffer[4096] __attribute__ ((aligned( __alignof__( struct inotify_event ) )));
+        ssize_t len;
+
+        while( ( len = read( m_fd, buffer, sizeof( buffer ) ) ) > 0 )
+        {
+            for( char* ptr = buffer; ptr < buffer + len; )
+            {
+                const struct inotify_event* event = (const struct inotify_event*) ptr;
+
+                if( event->mask & IN_Q_OVERFLOW )
+                    m_overflows++;
+                else if( m_refs.count( event->wd ) )
+                    m_events[event->wd]++;
+
+                ptr += sizeof( struct inotify_event ) + event->len;
+            }
+        }
+    }
+
+public:
+    static INOTIFY_HUB& Get()
+    {
+        // Never destroyed: watchers owned by global objects (e.g. the footprint library
+        // table caches) can be destroyed after a function-local static would be.
+        static INOTIFY_HUB* hub = new INOTIFY_HUB;
+
+        return *hub;
+    }
+
+    /**
+     * @return a watch descriptor for aPath, or -1 if the directory cannot be watched.
+     */
+    int Watch( const wxString& aPath )
+    {
+        GUARD guard( m_mutex );
+
+        if( m_fd < 0 || isRemoteFileSystem( aPath ) )
+            return -1;
+
+        // Watching the same directory twice returns the same descriptor
+        int wd = inotify_add_watch( m_fd, aPath.fn_str(),
+                                    IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE
+                                    | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO
+                                    | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR );
+
+        if( wd >= 0 )
+            m_refs[wd]++;
+
+        return wd;
+    }
+
+    void Unwatch( int aWatch )
+    {
+        GUARD guard( m_mutex );
+
+        if( --m_refs[aWatch] > 0 )
+            return;
+
+        m_refs.erase( aWatch );
+        m_events.erase( aWatch );
+        inotify_rm_watch( m_fd, aWatch );
+    }
+
+    /**
+     * @return the number of events received so far for aWatch.
+     */
+    unsigned long long EventCount( int aWatch )
+    {
+        GUARD guard( m_mutex );
+
+        readEvents();
+
+        return m_events[aWatch] + m_overflows;
+    }
+};
+
+#endif
+
+
+DIR_WATCHER::DIR_WATCHER( const wxString& aDirPath ) :
+    m_path( aDirPath ),
+    m_watch( -1 ),
+    m_events( 0 )
+{
+#ifdef __linux__
+    m_watch = INOTIFY_HUB::Get().Watch( m_path );
+
+    if( m_watch >= 0 )
+        m_events = INOTIFY_HUB::Get().EventCount( m_watch );
+#endif
+
+    m_dir_time = dirTime();
+}
+
+
+DIR_WATCHER::~DIR_WATCHER()
+{
+#ifdef __linux__
+    if( m_watch >= 0 )
+        INOTIFY_HUB::Get().Unwatch( m_watch );
+#endif
+}
+
+
+bool DIR_WATCHER::IsModified()
+{
+#ifdef __linux__
+    if( m_watch >= 0 )
+        return INOTIFY_HUB::Get().EventCount( m_watch ) != m_events;
+#endif
+
+    return dirTime() != m_dir_time;
+}
+
+
+long long DIR_WATCHER::dirTime() const
+{
+    wxFileName dir;
+
+    dir.AssignDir( m_path );
+
+    if( !dir.DirExists() )
+        return 0;
+
+    return dir.GetModificationTime().GetValue().GetValue();
+}
+
+
+long long DIR_WATCHER::Timestamp( const wxString& aDirPath, const wxString& aWildcard,
+                                  bool* aHasSymlinks )
+{
+    wxFileName dirPath;
+
+    dirPath.AssignDir( aDirPath );
+
+    wxDir dir( dirPath.GetPath() );
+
+    if( !dir.IsOpened() )
+        return 0;
+
+    long long timestamp = dirPath.GetModificationTime().GetValue().GetValue();
+    wxString  fileName;
+
+    if( dir.GetFirst( &fileName, aWildcard, wxDIR_FILES ) )
+    {
+        do
+        {
+            wxFileName fn( dirPath.GetPath(), fileName );
+#ifndef __WINDOWS__
+            // Timestamp the source file, not the symlink
+            if( fn.Exists( wxFILE_EXISTS_SYMLINK ) )
+            {
+                char    buffer[ PATH_MAX + 1 ];
+                ssize_t pathLen = readlink( fn.GetFullPath().fn_str(), buffer, PATH_MAX );
+
+                if( aHasSymlinks )
+                    *aHasSymlinks = true;
+
+                if( pathLen > 0 )
+                {
+                    buffer[ pathLen ] = '\0';
+                    fn.Assign( wxString::FromUTF8( buffer ) );
+                    fn.Normalize( wxPATH_NORM_DOTS | wxPATH_NORM_ABSOLUTE, dirPath.GetPath() );
+                }
+            }
+#endif
+            if( fn.FileExists() )
+                timestamp += fn.GetModificationTime().GetValue().GetValue();
+        } while( dir.GetNext( &fileName ) );
+    }
+
+    return timestamp;
+}
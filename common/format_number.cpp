@@ -0,0 +1,182 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file format_number.cpp
+ * @brief Number formatting without printf() nor the locale.
+ */
+
+#include <format_number.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <locale>
+#include <sstream>
+#include <string>
+
+
+/**
+ * Writes the decimal digits of \a aValue to \a aBuffer, after leading zeros up to
+ * \a aMinDigits digits.  This is the digit loop of all the number formatting functions.
+ * @return a pointer after the last digit written, without nul terminator.
+ */
+static char* appendDigits( char* aBuffer, unsigned long long aValue, int aMinDigits )
+{
+    char  digits[20];
+    char* first = digits + sizeof( digits );
+
+    do
+    {
+        *--first = '0' + aValue % 10;
+        aValue /= 10;
+    } while( aValue );
+
+    int length = digits + sizeof( digits ) - first;
+
+    for( ; aMinDigits > length; aMinDigits-- )
+        *aBuffer++ = '0';
+
+    memcpy( aBuffer, first, length );
+
+    return aBuffer + length;
+}
+
+
+/**
+ * Writes the fixed point number \a aInteger.\a aFraction, the fraction having
+ * \a aDecimals digits, or no decimal point when \a aDecimals is 0.
+ * @return a pointer to the terminating nul of the string written in \a aBuffer.
+ */
+static char* appendFixedPoint( char* aBuffer, bool aNegative, unsigned long long aInteger,
+                               unsigned long long aFraction, int aDecimals )
+{
+    if( aNegative )
+        *aBuffer++ = '-';
+
+    aBuffer = appendDigits( aBuffer, aInteger, 1 );
+
+    if( aDecimals > 0 )
+    {
+        *aBuffer++ = '.';
+        aBuffer = appendDigits( aBuffer, aFraction, aDecimals );
+    }
+
+    *aBuffer = 0;
+
+    return aBuffer;
+}
+
+
+char* FormatInt( char* aBuffer, long long aValue, int aWidth )
+{
+    unsigned long long value = aValue < 0 ? 0ULL - (unsigned long long) aValue : aValue;
+
+    if( aValue < 0 )
+    {
+        *aBuffer++ = '-';
+        aWidth--;
+    }
+
+    aBuffer = appendDigits( aBuffer, value, aWidth );
+    *aBuffer = 0;
+
+    return aBuffer;
+}
+
+
+char* FormatDecimal( char* aBuffer, long long aValue, int aDecimals )
+{
+    unsigned long long integer = aValue < 0 ? 0ULL - (unsigned long long) aValue : aValue;
+    unsigned long long fraction = 0;
+    unsigned long long scale = 1;
+    int                decimals = aDecimals;
+
+    // skip the trailing zeros of the decimals
+    while( decimals > 0 && integer % 10 == 0 && integer )
+    {
+        integer /= 10;
+        decimals--;
+    }
+
+    if( !integer )
+        decimals = 0;
+
+    // split the decimals left; the fraction digits not reached are leading zeros
+    for( int i = 0; i < decimals && integer; ++i, scale *= 10 )
+    {
+        fraction += integer % 10 * scale;
+        integer /= 10;
+    }
+
+    return appendFixedPoint( aBuffer, aValue < 0, integer, fraction, decimals );
+}
+
+
+char* FormatFixed( char* aBuffer, double aValue, int aDigits )
+{
+    static const double powers[] = { 1.0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+
+    const int maxDigits = sizeof( powers ) / sizeof( powers[0] ) - 1;
+    double    absValue = std::fabs( aValue );
+    double    scaled = aDigits >= 0 && aDigits <= maxDigits ? absValue * powers[aDigits]
+                                                            : HUGE_VAL;
+
+    // values too large for the half integers to be exact in a double (and NaNs) are rare
+    // enough to go through the stream formatting
+    if( !( scaled < 4.5e15 ) )
+    {
+        std::ostringstream ostr;
+
+        ostr.imbue( std::locale::classic() );
+        ostr << std::fixed << std::setprecision( aDigits ) << aValue;
+
+        std::string str = ostr.str();
+
+        memcpy( aBuffer, str.c_str(), str.size() + 1 );
+        return aBuffer + str.size();
+    }
+
+    // the product is rounded: the rounding of the exact value to an integer is decided
+    // by the sign of exact differences, computed with fma()
+    double power = powers[aDigits];
+    double floorValue = std::floor( scaled );
+
+    if( std::fma( absValue, power, -floorValue ) < 0.0 )
+        floorValue -= 1.0;
+    else if( std::fma( absValue, power, -( floorValue + 1.0 ) ) >= 0.0 )
+        floorValue += 1.0;
+
+    // round half to even, as printf()
+    double   half = std::fma( absValue, power, -( floorValue + 0.5 ) );
+    uint64_t value = (uint64_t) floorValue;
+
+    if( half > 0.0 || ( half == 0.0 && ( value & 1 ) ) )
+        value++;
+
+    uint64_t scale = (uint64_t) power;
+
+    return appendFixedPoint( aBuffer, std::signbit( aValue ), value / scale, value % scale,
+                             aDigits );
+}
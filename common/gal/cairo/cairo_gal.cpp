@@ -1098,7 +1098,7 @@ void CAIRO_GAL::drawPoly( const VECTOR2D aPointList[], int aListSize )
 
     cairo_move_to( currentContext, ptr->x, ptr->y );
 
-    for( int i = 0; i < aListSize; ++i )
+    for( int i = 1; i < aListSize; ++i )
     {
         ++ptr;
         cairo_line_to( currentContext, ptr->x, ptr->y );
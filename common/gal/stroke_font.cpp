@@ -31,6 +31,10 @@
 #include <text_utils.h>
 #include <wx/string.h>
 
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
 
 using namespace KIGFX;
 
@@ -46,21 +50,137 @@ STROKE_FONT::STROKE_FONT( GAL* aGal ) :
 }
 
 
+/**
+ * The glyphs of a font, in flat arrays.
+ */
+struct STROKE_FONT::GLYPH_TABLE
+{
+    std::vector<VECTOR2D> m_points;         ///< points of the strokes of all the glyphs
+    std::vector<int>      m_strokes;        ///< index of the first point of each stroke, + end
+    std::vector<int>      m_glyphs;         ///< index of the first stroke of each glyph, + end
+    std::vector<BOX2D>    m_boundingBoxes;  ///< bounding box of each glyph
+};
+
+
+/**
+ * The strokes of a line of text, laid out by layoutSingleLineText().
+ */
+struct STROKE_FONT::TEXT_LAYOUT
+{
+    VECTOR2D              m_size;           ///< text size, see computeTextLineSize()
+    std::vector<VECTOR2D> m_points;         ///< points of all the strokes
+    std::vector<int>      m_strokes;        ///< index of the first point of each stroke, + end
+    std::vector<bool>     m_overbars;       ///< strokes which are overbars, drawn as lines
+};
+
+
+/**
+ * The lines of text laid out by all the STROKE_FONT instances, with the attributes they
+ * were laid out with.  It is simply cleared when it becomes too big.
+ */
+class STROKE_FONT::TEXT_LAYOUT_CACHE
+{
+public:
+    struct KEY
+    {
+        const GLYPH_TABLE*  m_font;
+        std::string         m_text;
+        VECTOR2D            m_glyphSize;
+        double              m_thickness;
+        bool                m_italic;
+        bool                m_mirrored;
+
+        bool operator==( const KEY& aOther ) const
+        {
+            return m_font == aOther.m_font && m_text == aOther.m_text
+                   && m_glyphSize == aOther.m_glyphSize && m_thickness == aOther.m_thickness
+                   && m_italic == aOther.m_italic && m_mirrored == aOther.m_mirrored;
+        }
+    };
+
+    struct KEY_HASH
+    {
+        size_t operator()( const KEY& aKey ) const
+        {
+            size_t seed = std::hash<std::string>()( aKey.m_text );
+
+            for( double value : { aKey.m_glyphSize.x, aKey.m_glyphSize.y, aKey.m_thickness } )
+                seed ^= std::hash<double>()( value ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+
+            return seed ^ ( aKey.m_italic ? 1 : 0 ) ^ ( aKey.m_mirrored ? 2 : 0 );
+        }
+    };
+
+    static TEXT_LAYOUT_CACHE& Get()
+    {
+        static TEXT_LAYOUT_CACHE cache;
+
+        return cache;
+    }
+
+    std::shared_ptr<const TEXT_LAYOUT> Find( const KEY& aKey )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        auto it = m_layouts.find( aKey );
+
+        return it != m_layouts.end() ? it->second : nullptr;
+    }
+
+    void Add( const KEY& aKey, const std::shared_ptr<const TEXT_LAYOUT>& aLayout )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        if( m_layouts.size() >= MAX_SIZE )
+            m_layouts.clear();
+
+        m_layouts[aKey] = aLayout;
+    }
+
+private:
+    static const size_t MAX_SIZE = 50000;
+
+    std::mutex                                                              m_mutex;
+    std::unordered_map<KEY, std::shared_ptr<const TEXT_LAYOUT>, KEY_HASH>   m_layouts;
+};
+
+
 bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNewStrokeFontSize )
 {
-    m_glyphs.clear();
-    m_glyphBoundingBoxes.clear();
-    m_glyphs.resize( aNewStrokeFontSize );
-    m_glyphBoundingBoxes.resize( aNewStrokeFontSize );
+    // Each GAL has its stroke font: the font data is parsed only for the first one
+    static std::mutex                                                       mutex;
+    static std::map<const char* const*, std::shared_ptr<const GLYPH_TABLE>> fonts;
+
+    std::lock_guard<std::mutex> lock( mutex );
+    std::shared_ptr<const GLYPH_TABLE>& font = fonts[aNewStrokeFont];
+
+    if( !font || (int) font->m_boundingBoxes.size() != aNewStrokeFontSize )
+        font = parseFont( aNewStrokeFont, aNewStrokeFontSize );
+
+    m_glyphs = font;
+
+    return true;
+}
+
+
+std::shared_ptr<const STROKE_FONT::GLYPH_TABLE> STROKE_FONT::parseFont(
+        const char* const aNewStrokeFont[], int aNewStrokeFontSize )
+{
+    std::shared_ptr<GLYPH_TABLE> font = std::make_shared<GLYPH_TABLE>();
+    std::vector<VECTOR2D>        glyphPoints;
+
+    font->m_boundingBoxes.resize( aNewStrokeFontSize );
 
     for( int j = 0; j < aNewStrokeFontSize; j++ )
     {
-        GLYPH    glyph;
         double   glyphStartX = 0.0;
         double   glyphEndX = 0.0;
         VECTOR2D glyphBoundingX;
 
-        std::deque<VECTOR2D> pointList;
+        font->m_glyphs.push_back( font->m_strokes.size() );
+        glyphPoints.clear();
+
+        // index of the first point of the current stroke
+        int strokeStart = font->m_points.size();
 
         int i = 0;
 
@@ -84,10 +204,10 @@ bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNe
             else if( ( coordinate[0] == ' ' ) && ( coordinate[1] == 'R' ) )
             {
                 // Raise pen
-                if( pointList.size() > 0 )
-                    glyph.push_back( pointList );
+                if( (int) font->m_points.size() > strokeStart )
+                    font->m_strokes.push_back( strokeStart );
 
-                pointList.clear();
+                strokeStart = font->m_points.size();
             }
             else
             {
@@ -101,26 +221,28 @@ bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNe
                 //  * a few shapes have a height slightly bigger than 1.0 ( like '{' '[' )
                 point.x = (double) ( coordinate[0] - 'R' ) * STROKE_FONT_SCALE - glyphStartX;
                 #define FONT_OFFSET -10
-				// FONT_OFFSET is here for historical reasons, due to the way the stroke font
+                // FONT_OFFSET is here for historical reasons, due to the way the stroke font
                 // was built. It allows shapes coordinates like W M ... to be >= 0
                 // Only shapes like j y have coordinates < 0
                 point.y = (double) ( coordinate[1] - 'R' + FONT_OFFSET ) * STROKE_FONT_SCALE;
-                pointList.push_back( point );
+                font->m_points.push_back( point );
+                glyphPoints.push_back( point );
             }
 
             i += 2;
         }
 
-        if( pointList.size() > 0 )
-            glyph.push_back( pointList );
-
-        m_glyphs[j] = glyph;
+        if( (int) font->m_points.size() > strokeStart )
+            font->m_strokes.push_back( strokeStart );
 
         // Compute the bounding box of the glyph
-        m_glyphBoundingBoxes[j] = computeBoundingBox( glyph, glyphBoundingX );
+        font->m_boundingBoxes[j] = computeBoundingBox( glyphPoints, glyphBoundingX );
     }
 
-    return true;
+    font->m_glyphs.push_back( font->m_strokes.size() );
+    font->m_strokes.push_back( font->m_points.size() );
+
+    return font;
 }
 
 
@@ -137,23 +259,18 @@ int STROKE_FONT::getInterline() const
 }
 
 
-BOX2D STROKE_FONT::computeBoundingBox( const GLYPH& aGLYPH, const VECTOR2D& aGLYPHBoundingX ) const
+BOX2D STROKE_FONT::computeBoundingBox( const std::vector<VECTOR2D>& aPoints,
+                                       const VECTOR2D& aGLYPHBoundingX )
 {
     BOX2D boundingBox;
 
-    std::deque<VECTOR2D> boundingPoints;
+    std::vector<VECTOR2D> boundingPoints;
 
     boundingPoints.push_back( VECTOR2D( aGLYPHBoundingX.x, 0 ) );
     boundingPoints.push_back( VECTOR2D( aGLYPHBoundingX.y, 0 ) );
 
-    for( GLYPH::const_iterator pointListIt = aGLYPH.begin(); pointListIt != aGLYPH.end(); ++pointListIt )
-    {
-        for( std::deque<VECTOR2D>::const_iterator pointIt = pointListIt->begin();
-                pointIt != pointListIt->end(); ++pointIt )
-        {
-            boundingPoints.push_back( VECTOR2D( aGLYPHBoundingX.x, pointIt->y ) );
-        }
-    }
+    for( const VECTOR2D& point : aPoints )
+        boundingPoints.push_back( VECTOR2D( aGLYPHBoundingX.x, point.y ) );
 
     boundingBox.Compute( boundingPoints );
 
@@ -243,15 +360,8 @@ void STROKE_FONT::Draw( const UTF8& aText, const VECTOR2D& aPosition, double aRo
 
 void STROKE_FONT::drawSingleLineText( const UTF8& aText )
 {
-    double      xOffset;
-    VECTOR2D    glyphSize( m_gal->GetGlyphSize() );
-    double      overbar_italic_comp = computeOverbarVerticalPosition() * ITALIC_TILT;
-
-    if( m_gal->IsTextMirrored() )
-        overbar_italic_comp = -overbar_italic_comp;
-
-    // Compute the text size
-    VECTOR2D textSize = computeTextLineSize( aText );
+    std::shared_ptr<const TEXT_LAYOUT> layout = layoutSingleLineText( aText );
+    const VECTOR2D& textSize = layout->m_size;
     double half_thickness = m_gal->GetLineWidth()/2;
 
     // Context needs to be saved before any transformations
@@ -285,12 +395,50 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
         break;
     }
 
+    for( size_t i = 0; i < layout->m_overbars.size(); i++ )
+    {
+        const VECTOR2D* points = &layout->m_points[layout->m_strokes[i]];
+
+        if( layout->m_overbars[i] )
+            m_gal->DrawLine( points[0], points[1] );
+        else
+            m_gal->DrawPolyline( points, layout->m_strokes[i + 1] - layout->m_strokes[i] );
+    }
+
+    m_gal->Restore();
+}
+
+
+std::shared_ptr<const STROKE_FONT::TEXT_LAYOUT> STROKE_FONT::layoutSingleLineText(
+        const UTF8& aText ) const
+{
+    TEXT_LAYOUT_CACHE::KEY key = { m_glyphs.get(), aText, m_gal->GetGlyphSize(),
+                                   m_gal->GetLineWidth(), m_gal->IsFontItalic(),
+                                   m_gal->IsTextMirrored() };
+
+    std::shared_ptr<const TEXT_LAYOUT> cached = TEXT_LAYOUT_CACHE::Get().Find( key );
+
+    if( cached )
+        return cached;
+
+    std::shared_ptr<TEXT_LAYOUT> layout = std::make_shared<TEXT_LAYOUT>();
+
+    double      xOffset;
+    VECTOR2D    glyphSize( m_gal->GetGlyphSize() );
+    double      overbar_italic_comp = computeOverbarVerticalPosition() * ITALIC_TILT;
+
+    if( m_gal->IsTextMirrored() )
+        overbar_italic_comp = -overbar_italic_comp;
+
+    // Compute the text size
+    layout->m_size = computeTextLineSize( aText );
+
     if( m_gal->IsTextMirrored() )
     {
         // In case of mirrored text invert the X scale of points and their X direction
         // (m_glyphSize.x) and start drawing from the position where text normally should end
         // (textSize.x)
-        xOffset = textSize.x - m_gal->GetLineWidth();
+        xOffset = layout->m_size.x - m_gal->GetLineWidth();
         glyphSize.x = -glyphSize.x;
     }
     else
@@ -311,11 +459,10 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
     {
         int dd = *chIt - ' ';
 
-        if( dd >= (int) m_glyphBoundingBoxes.size() || dd < 0 )
+        if( dd >= (int) m_glyphs->m_boundingBoxes.size() || dd < 0 )
             dd = '?' - ' ';
 
-        GLYPH& glyph = m_glyphs[dd];
-        BOX2D& bbox  = m_glyphBoundingBoxes[dd];
+        const BOX2D& bbox = m_glyphs->m_boundingBoxes[dd];
 
         if( overbars[i] )
         {
@@ -332,25 +479,27 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
                 last_had_overbar = true;
             }
 
-            VECTOR2D startOverbar( overbar_start_x, overbar_start_y );
-            VECTOR2D endOverbar( overbar_end_x, overbar_end_y );
-
-            m_gal->DrawLine( startOverbar, endOverbar );
+            layout->m_strokes.push_back( layout->m_points.size() );
+            layout->m_overbars.push_back( true );
+            layout->m_points.emplace_back( overbar_start_x, overbar_start_y );
+            layout->m_points.emplace_back( overbar_end_x, overbar_end_y );
         }
         else
         {
             last_had_overbar = false;
         }
 
-        for( GLYPH::iterator pointListIt = glyph.begin(); pointListIt != glyph.end();
-             ++pointListIt )
+        for( int stroke = m_glyphs->m_glyphs[dd]; stroke < m_glyphs->m_glyphs[dd + 1]; stroke++ )
         {
-            std::deque<VECTOR2D> pointListScaled;
+            layout->m_strokes.push_back( layout->m_points.size() );
+            layout->m_overbars.push_back( false );
 
-            for( std::deque<VECTOR2D>::iterator pointIt = pointListIt->begin();
-                 pointIt != pointListIt->end(); ++pointIt )
+            for( int point = m_glyphs->m_strokes[stroke]; point < m_glyphs->m_strokes[stroke + 1];
+                 point++ )
             {
-                VECTOR2D pointPos( pointIt->x * glyphSize.x + xOffset, pointIt->y * glyphSize.y );
+                const VECTOR2D& glyphPoint = m_glyphs->m_points[point];
+                VECTOR2D pointPos( glyphPoint.x * glyphSize.x + xOffset,
+                                   glyphPoint.y * glyphSize.y );
 
                 if( m_gal->IsFontItalic() )
                 {
@@ -362,17 +511,19 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
                         pointPos.x -= pointPos.y * STROKE_FONT::ITALIC_TILT;
                 }
 
-                pointListScaled.push_back( pointPos );
+                layout->m_points.push_back( pointPos );
             }
-
-            m_gal->DrawPolyline( pointListScaled );
         }
 
         xOffset += glyphSize.x * bbox.GetEnd().x;
         ++i;
     }
 
-    m_gal->Restore();
+    layout->m_strokes.push_back( layout->m_points.size() );
+
+    TEXT_LAYOUT_CACHE::Get().Add( key, layout );
+
+    return layout;
 }
 
 
@@ -427,10 +578,10 @@ VECTOR2D STROKE_FONT::ComputeStringBoundaryLimits( const UTF8& aText, const VECT
         // Index in the bounding boxes table
         int dd = *it - ' ';
 
-        if( dd >= (int) m_glyphBoundingBoxes.size() || dd < 0 )
+        if( dd >= (int) m_glyphs->m_boundingBoxes.size() || dd < 0 )
             dd = '?' - ' ';
 
-        const BOX2D& box = m_glyphBoundingBoxes[dd];
+        const BOX2D& box = m_glyphs->m_boundingBoxes[dd];
         curX += box.GetEnd().x;
     }
 
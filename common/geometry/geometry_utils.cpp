@@ -67,6 +67,25 @@ int GetArcToSegmentCount( int aRadius, int aErrorMax, double aArcAngleDegree )
 }
 
 
+int GetCircleToSegmentCount( int aRadius, int aErrorMax, int aMaxSegCount )
+{
+    int segCount = 8;
+
+    // a circle smaller than the error needs no more than the minimum count.  Unlike
+    // GetArcToSegmentCount(), round up so the error is never exceeded.
+    if( aRadius > aErrorMax )
+    {
+        double step = acos( 1.0 - (double) aErrorMax / aRadius ) * 2;
+
+        segCount = std::max( segCount, (int) ceil( 2 * M_PI / step ) );
+    }
+
+    segCount = ( segCount + 3 ) / 4 * 4;
+
+    return std::min( segCount, aMaxSegCount );
+}
+
+
 double GetCircletoPolyCorrectionFactor( int aSegCountforCircle )
 {
     /* calculates the coeff to compensate radius reduction of circle
@@ -22,6 +22,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
 #include <vector>
 
 #include <base_units.h>
@@ -31,51 +32,165 @@
 
 bool SHAPE_ARC::Collide( const SEG& aSeg, int aClearance ) const
 {
-    int minDist = aClearance + m_width / 2;
-    auto centerDist = aSeg.Distance( m_pc );
-    auto p1 = GetP1();
+    int dist = Distance( aSeg );
 
-    if( centerDist < minDist )
-        return true;
+    return dist == 0 || dist < aClearance + m_width / 2;
+}
+
+
+int SHAPE_ARC::Distance( const SEG& aSeg ) const
+{
+    const VECTOR2D a = VECTOR2D( aSeg.A ) - VECTOR2D( m_pc );
+    const VECTOR2D ab = VECTOR2D( aSeg.B ) - VECTOR2D( aSeg.A );
+    const double   r = ( VECTOR2D( m_p0 ) - VECTOR2D( m_pc ) ).EuclideanNorm();
+    const double   abSq = ab.Dot( ab );
+
+    // Points of the segment a + t.ab on the circle, 0 <= t <= 1: the arc crosses the
+    // segment if one of them is on the arc.
+    if( abSq > 0.0 )
+    {
+        double b = a.Dot( ab );
+        double disc = b * b - abSq * ( a.Dot( a ) - r * r );
+
+        if( disc >= 0.0 )
+        {
+            double t0 = ( -b - sqrt( disc ) ) / abSq;
+            double t1 = ( -b + sqrt( disc ) ) / abSq;
+
+            if( t0 >= 0.0 && t0 <= 1.0 && sweeps( a + ab * t0 ) )
+                return 0;
+
+            if( t1 >= 0.0 && t1 <= 1.0 && sweeps( a + ab * t1 ) )
+                return 0;
+        }
+    }
+
+    // Otherwise the nearest points are an end of the arc or of the segment...
+    int dist = std::min( aSeg.Distance( m_p0 ), aSeg.Distance( GetP1() ) );
+
+    dist = std::min( dist, Distance( aSeg.A ) );
+    dist = std::min( dist, Distance( aSeg.B ) );
+
+    // ... or the point of the segment nearest to the center, when it is outside of the
+    // circle and faces the arc.
+    if( abSq > 0.0 )
+    {
+        double t = -a.Dot( ab ) / abSq;
 
-    auto ab = (aSeg.B - aSeg.A );
-    auto ac = ( m_pc - aSeg.A );
+        if( t > 0.0 && t < 1.0 )
+        {
+            VECTOR2D n = a + ab * t;
+            double   len = n.EuclideanNorm();
 
-    auto lenAbSq = ab.SquaredEuclideanNorm();
+            if( len > r && sweeps( n ) )
+                dist = std::min( dist, KiROUND( len - r ) );
+        }
+    }
 
-    auto lambda = (double) ac.Dot( ab ) / (double) lenAbSq;
+    return dist;
+}
 
 
-    if( lambda >= 0.0 && lambda <= 1.0 )
+int SHAPE_ARC::Distance( const SHAPE_ARC& aArc ) const
+{
+    const VECTOR2D d = VECTOR2D( aArc.m_pc ) - VECTOR2D( m_pc );
+    const double   r = ( VECTOR2D( m_p0 ) - VECTOR2D( m_pc ) ).EuclideanNorm();
+    const double   rOther = ( VECTOR2D( aArc.m_p0 ) - VECTOR2D( aArc.m_pc ) ).EuclideanNorm();
+    const double   dist = d.EuclideanNorm();
+
+    // Crossing points of the circles, relative to m_pc: the arcs cross if one of them is
+    // on both arcs.
+    if( dist > 0.0 && dist <= r + rOther && dist >= std::abs( r - rOther ) )
     {
-        VECTOR2I p;
+        double   a = ( r * r - rOther * rOther + dist * dist ) / ( 2.0 * dist );
+        double   h = sqrt( std::max( 0.0, r * r - a * a ) );
+        VECTOR2D m = d * ( a / dist );
+        VECTOR2D n = VECTOR2D( -d.y, d.x ) * ( h / dist );
 
-        p.x = (double) aSeg.A.x * lambda + (double) aSeg.B.x * (1.0 - lambda);
-        p.y = (double) aSeg.A.y * lambda + (double) aSeg.B.y * (1.0 - lambda);
+        if( sweeps( m + n ) && aArc.sweeps( m + n - d ) )
+            return 0;
 
-        auto p0pdist = ( m_p0 - p ).EuclideanNorm();
+        if( sweeps( m - n ) && aArc.sweeps( m - n - d ) )
+            return 0;
+    }
 
-        if( p0pdist < minDist )
-            return true;
+    // Otherwise the nearest points are an end of one of the arcs...
+    int rv = std::min( Distance( aArc.m_p0 ), Distance( aArc.GetP1() ) );
 
-        auto p1pdist = ( p1 - p ).EuclideanNorm();
+    rv = std::min( rv, aArc.Distance( m_p0 ) );
+    rv = std::min( rv, aArc.Distance( GetP1() ) );
 
-        if( p1pdist < minDist )
-            return true;
+    // ... or two points facing each other on the line joining the centers, or anywhere
+    // along the common angles of two arcs of the same center.
+    if( dist > 0.0 )
+    {
+        const VECTOR2D u = d * ( 1.0 / dist );
+
+        for( int side : { -1, 1 } )
+        {
+            for( int sideOther : { -1, 1 } )
+            {
+                if( sweeps( u * side ) && aArc.sweeps( u * sideOther ) )
+                {
+                    double gap = std::abs( dist + sideOther * rOther - side * r );
+                    rv = std::min( rv, KiROUND( gap ) );
+                }
+            }
+        }
     }
+    else if( sweeps( VECTOR2D( aArc.m_p0 - m_pc ) ) || sweeps( VECTOR2D( aArc.GetP1() - m_pc ) )
+             || aArc.sweeps( VECTOR2D( m_p0 - m_pc ) ) )
+    {
+        rv = std::min( rv, KiROUND( std::abs( r - rOther ) ) );
+    }
+
+    return rv;
+}
+
 
-    auto p0dist = aSeg.Distance( m_p0 );
+int SHAPE_ARC::Distance( const VECTOR2I& aP ) const
+{
+    const VECTOR2D d = VECTOR2D( aP ) - VECTOR2D( m_pc );
 
-    if( p0dist > minDist )
+    if( sweeps( d ) )
+    {
+        double r = ( VECTOR2D( m_p0 ) - VECTOR2D( m_pc ) ).EuclideanNorm();
+
+        return KiROUND( std::abs( d.EuclideanNorm() - r ) );
+    }
+
+    return std::min( ( aP - m_p0 ).EuclideanNorm(), ( aP - GetP1() ).EuclideanNorm() );
+}
+
+
+bool SHAPE_ARC::sweeps( const VECTOR2D& aDir ) const
+{
+    if( std::abs( m_centralAngle ) >= 360.0 )
         return true;
 
-    auto p1dist = aSeg.Distance( p1 );
+    double angle = fmod( 180.0 / M_PI * atan2( aDir.y, aDir.x ) - GetStartAngle(), 360.0 );
 
-    if( p1dist > minDist )
-        return false;
+    if( m_centralAngle >= 0.0 )
+    {
+        if( angle < 0.0 )
+            angle += 360.0;
 
+        return angle <= m_centralAngle;
+    }
+    else
+    {
+        if( angle > 0.0 )
+            angle -= 360.0;
 
-    return true;
+        return angle >= m_centralAngle;
+    }
+}
+
+
+void SHAPE_ARC::Rotate( double aAngle, const VECTOR2I& aCenter )
+{
+    m_p0 = ( m_p0 - aCenter ).Rotate( aAngle ) + aCenter;
+    m_pc = ( m_pc - aCenter ).Rotate( aAngle ) + aCenter;
 }
 
 #if 0
@@ -144,8 +259,8 @@ const VECTOR2I SHAPE_ARC::GetP1() const
     auto ca = m_centralAngle * M_PI / 180.0;
     VECTOR2I p1;
 
-    p1.x = (int) ( m_pc.x + rvec.x * cos( ca ) - rvec.y * sin( ca ) );
-    p1.y = (int) ( m_pc.y + rvec.x * sin( ca ) + rvec.y * cos( ca ) );
+    p1.x = KiROUND( m_pc.x + rvec.x * cos( ca ) - rvec.y * sin( ca ) );
+    p1.y = KiROUND( m_pc.y + rvec.x * sin( ca ) + rvec.y * cos( ca ) );
 
     return p1;
 }
@@ -155,14 +270,23 @@ const BOX2I SHAPE_ARC::BBox( int aClearance ) const
 {
     BOX2I bbox;
     std::vector<VECTOR2I> points;
-    points.push_back( m_pc );
     points.push_back( m_p0 );
     points.push_back( GetP1() );
 
+    // the arc reaches the sides of the circle box it sweeps over
+    int r = GetRadius();
+    const VECTOR2I sides[] = { { r, 0 }, { 0, r }, { -r, 0 }, { 0, -r } };
+
+    for( const VECTOR2I& side : sides )
+    {
+        if( sweeps( side ) )
+            points.push_back( m_pc + side );
+    }
+
     bbox.Compute( points );
 
-    if( aClearance != 0 )
-        bbox.Inflate( aClearance );
+    if( aClearance + m_width / 2 != 0 )
+        bbox.Inflate( aClearance + m_width / 2 );
 
     return bbox;
 }
@@ -170,8 +294,9 @@ const BOX2I SHAPE_ARC::BBox( int aClearance ) const
 
 bool SHAPE_ARC::Collide( const VECTOR2I& aP, int aClearance ) const
 {
-    assert( false );
-    return false;
+    int dist = Distance( aP );
+
+    return dist == 0 || dist < aClearance + m_width / 2;
 }
 
 
@@ -223,7 +348,9 @@ const SHAPE_LINE_CHAIN SHAPE_ARC::ConvertToPolyline( double aAccuracy ) const
         n = GetArcToSegmentCount( r, aAccuracy, m_centralAngle );
     }
 
-    for( int i = 0; i <= n ; i++ )
+    rv.Append( m_p0 );
+
+    for( int i = 1; i < n ; i++ )
     {
         double a = sa + m_centralAngle * (double) i / (double) n;
         double x = c.x + r * cos( a * M_PI / 180.0 );
@@ -232,5 +359,9 @@ const SHAPE_LINE_CHAIN SHAPE_ARC::ConvertToPolyline( double aAccuracy ) const
         rv.Append( (int) x, (int) y );
     }
 
+    // the ends are the exact ones, so arcs following each other are still connected
+    if( n > 0 )
+        rv.Append( GetP1() );
+
     return rv;
 }
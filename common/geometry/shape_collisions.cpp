@@ -301,18 +301,34 @@ static inline bool Collide( const SHAPE_RECT& aA, const SHAPE_RECT& aB, int aCle
     return Collide( aA.Outline(), aB.Outline(), aClearance, aNeedMTV, aMTV );
 }
 
+static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_LINE_CHAIN& aB, int aClearance,
+                            bool aNeedMTV, VECTOR2I& aMTV )
+{
+    // the arc is not approximated: its distance to each segment is exact
+    for( int s = 0; s < aB.SegmentCount(); s++ )
+    {
+        if( aA.Collide( aB.CSegment( s ), aClearance ) )
+            return true;
+    }
+
+    return false;
+}
+
 static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_RECT& aB, int aClearance,
                             bool aNeedMTV, VECTOR2I& aMTV )
 {
-    const auto lc = aA.ConvertToPolyline();
-    return Collide( lc, aB.Outline(), aClearance, aNeedMTV, aMTV );
+    return Collide( aA, aB.Outline(), aClearance, aNeedMTV, aMTV );
 }
 
 static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_CIRCLE& aB, int aClearance,
                             bool aNeedMTV, VECTOR2I& aMTV )
 {
+    if( !aNeedMTV )
+        return aA.Collide( aB.GetCenter(), aClearance + aB.GetRadius() );
+
+    // the push out force is computed for segments
     const auto lc = aA.ConvertToPolyline();
-    bool rv = Collide( aB, lc, aClearance, aNeedMTV, aMTV );
+    bool rv = Collide( aB, lc, aClearance + aA.GetWidth() / 2, aNeedMTV, aMTV );
 
     if( rv && aNeedMTV )
         aMTV = -aMTV;
@@ -320,33 +336,24 @@ static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_CIRCLE& aB, int aCl
     return rv;
 }
 
-static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_LINE_CHAIN& aB, int aClearance,
-                            bool aNeedMTV, VECTOR2I& aMTV )
-{
-    const auto lc = aA.ConvertToPolyline();
-    return Collide( lc, aB, aClearance, aNeedMTV, aMTV );
-}
-
 static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_SEGMENT& aB, int aClearance,
                             bool aNeedMTV, VECTOR2I& aMTV )
 {
-    const auto lc = aA.ConvertToPolyline();
-    return Collide( lc, aB, aClearance, aNeedMTV, aMTV );
+    return aA.Collide( aB.GetSeg(), aClearance + aB.GetWidth() / 2 );
 }
 
 static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_SIMPLE& aB, int aClearance,
                             bool aNeedMTV, VECTOR2I& aMTV )
 {
-    const auto lc = aA.ConvertToPolyline();
-    return Collide( lc, aB.Vertices(), aClearance, aNeedMTV, aMTV );
+    return Collide( aA, aB.Vertices(), aClearance, aNeedMTV, aMTV );
 }
 
 static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_ARC& aB, int aClearance,
                             bool aNeedMTV, VECTOR2I& aMTV )
 {
-    const auto lcA = aA.ConvertToPolyline();
-    const auto lcB = aB.ConvertToPolyline();
-    return Collide( lcA, lcB, aClearance, aNeedMTV, aMTV );
+    int dist = aA.Distance( aB );
+
+    return dist == 0 || dist < aClearance + aA.GetWidth() / 2 + aB.GetWidth() / 2;
 }
 
 template<class ShapeAType, class ShapeBType>
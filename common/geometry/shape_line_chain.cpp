@@ -44,6 +44,9 @@ void SHAPE_LINE_CHAIN::Rotate( double aAngle, const VECTOR2I& aCenter )
         (*i) = (*i).Rotate( aAngle );
         (*i) += aCenter;
     }
+
+    for( SHAPE_ARC& arc : m_arcs )
+        arc.Rotate( aAngle, aCenter );
 }
 
 
@@ -54,6 +57,17 @@ bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance ) const
 
     for( int i = 0; i < SegmentCount(); i++ )
     {
+        int arc = ArcIndex( i );
+
+        // an arc is checked once, instead of the segments approximating it
+        if( arc >= 0 )
+        {
+            if( ( i == 0 || ArcIndex( i - 1 ) != arc ) && m_arcs[arc].Collide( aSeg, aClearance ) )
+                return true;
+
+            continue;
+        }
+
         const SEG& s = CSegment( i );
         BOX2I box_b( s.A, s.B - s.A );
 
@@ -77,6 +91,16 @@ const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Reverse() const
     reverse( a.m_points.begin(), a.m_points.end() );
     a.m_closed = m_closed;
 
+    if( !m_shapes.empty() )
+    {
+        // the segment i of the reversed chain is the segment n - 2 - i, and the closing
+        // segment (never an arc) stays the same
+        reverse( a.m_shapes.begin(), a.m_shapes.end() - 1 );
+
+        for( SHAPE_ARC& arc : a.m_arcs )
+            arc = arc.Reversed();
+    }
+
     return a;
 }
 
@@ -100,6 +124,12 @@ void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const VECTOR2I&
     if( aStartIndex < 0 )
         aStartIndex += PointCount();
 
+    if( !m_shapes.empty() )
+    {
+        breakArcs( aStartIndex - 1, aEndIndex );
+        m_shapes.erase( m_shapes.begin() + aStartIndex + 1, m_shapes.begin() + aEndIndex + 1 );
+    }
+
     if( aStartIndex == aEndIndex )
         m_points[aStartIndex] = aP;
     else
@@ -118,6 +148,26 @@ void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const SHAPE_LINE
     if( aStartIndex < 0 )
         aStartIndex += PointCount();
 
+    if( !m_shapes.empty() || !aLine.m_shapes.empty() )
+    {
+        std::vector<int> shapes( aLine.m_shapes );
+
+        if( shapes.empty() )
+            shapes.resize( aLine.PointCount(), -1 );
+
+        for( int& shape : shapes )
+        {
+            if( shape >= 0 )
+                shape += m_arcs.size();
+        }
+
+        breakArcs( aStartIndex - 1, aEndIndex );
+        m_shapes.resize( PointCount(), -1 );
+        m_shapes.erase( m_shapes.begin() + aStartIndex, m_shapes.begin() + aEndIndex + 1 );
+        m_shapes.insert( m_shapes.begin() + aStartIndex, shapes.begin(), shapes.end() );
+        m_arcs.insert( m_arcs.end(), aLine.m_arcs.begin(), aLine.m_arcs.end() );
+    }
+
     m_points.erase( m_points.begin() + aStartIndex, m_points.begin() + aEndIndex + 1 );
     m_points.insert( m_points.begin() + aStartIndex, aLine.m_points.begin(), aLine.m_points.end() );
 }
@@ -131,10 +181,134 @@ void SHAPE_LINE_CHAIN::Remove( int aStartIndex, int aEndIndex )
     if( aStartIndex < 0 )
         aStartIndex += PointCount();
 
+    if( !m_shapes.empty() )
+    {
+        breakArcs( aStartIndex - 1, aEndIndex );
+        m_shapes.erase( m_shapes.begin() + aStartIndex, m_shapes.begin() + aEndIndex + 1 );
+    }
+
     m_points.erase( m_points.begin() + aStartIndex, m_points.begin() + aEndIndex + 1 );
 }
 
 
+void SHAPE_LINE_CHAIN::Insert( int aVertex, const VECTOR2I& aP )
+{
+    if( !m_shapes.empty() )
+    {
+        breakArcs( aVertex - 1, aVertex - 1 );
+        m_shapes.insert( m_shapes.begin() + aVertex, -1 );
+    }
+
+    m_points.insert( m_points.begin() + aVertex, aP );
+}
+
+
+void SHAPE_LINE_CHAIN::Append( const SHAPE_LINE_CHAIN& aOtherLine )
+{
+    if( aOtherLine.PointCount() == 0 )
+        return;
+
+    // index of the first point of aOtherLine in the line chain
+    int first = PointCount();
+
+    if( PointCount() == 0 || aOtherLine.CPoint( 0 ) != CPoint( -1 ) )
+    {
+        const VECTOR2I p = aOtherLine.CPoint( 0 );
+        m_points.push_back( p );
+        m_bbox.Merge( p );
+    }
+    else
+    {
+        first--;
+    }
+
+    for( int i = 1; i < aOtherLine.PointCount(); i++ )
+    {
+        const VECTOR2I p = aOtherLine.CPoint( i );
+        m_points.push_back( p );
+        m_bbox.Merge( p );
+    }
+
+    if( !m_shapes.empty() || !aOtherLine.m_shapes.empty() )
+    {
+        m_shapes.resize( PointCount(), -1 );
+
+        for( int i = 0; i < (int) aOtherLine.m_shapes.size(); i++ )
+        {
+            if( aOtherLine.m_shapes[i] >= 0 )
+                m_shapes[first + i] = aOtherLine.m_shapes[i] + m_arcs.size();
+        }
+
+        m_arcs.insert( m_arcs.end(), aOtherLine.m_arcs.begin(), aOtherLine.m_arcs.end() );
+    }
+}
+
+
+void SHAPE_LINE_CHAIN::Append( const SHAPE_ARC& aArc, double aAccuracy )
+{
+    SHAPE_LINE_CHAIN chain = aArc.ConvertToPolyline( aAccuracy );
+
+    if( chain.SegmentCount() > 0 )
+    {
+        SHAPE_ARC arc( aArc );
+
+        arc.SetWidth( 0 );
+        chain.m_arcs.push_back( arc );
+        chain.m_shapes.resize( chain.PointCount(), 0 );
+        chain.m_shapes.back() = -1;
+    }
+
+    Append( chain );
+}
+
+
+const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::ConvertArcs( double aAccuracy ) const
+{
+    SHAPE_LINE_CHAIN rv;
+
+    for( int i = 0; i < PointCount(); i++ )
+    {
+        int arc = ArcIndex( i );
+        int prev = i > 0 ? ArcIndex( i - 1 ) : -1;
+
+        // the other points approximate an arc which is already appended
+        if( arc >= 0 && arc != prev )
+            rv.Append( m_arcs[arc], aAccuracy );
+        else if( arc < 0 && prev < 0 )
+            rv.Append( m_points[i], true );
+    }
+
+    rv.SetClosed( m_closed );
+
+    return rv;
+}
+
+
+void SHAPE_LINE_CHAIN::breakArcs( int aFirst, int aLast )
+{
+    if( m_shapes.empty() )
+        return;
+
+    aFirst = std::max( aFirst, 0 );
+    aLast = std::min( aLast, (int) m_shapes.size() - 1 );
+
+    for( int i = aFirst; i <= aLast; i++ )
+    {
+        int arc = m_shapes[i];
+
+        if( arc < 0 )
+            continue;
+
+        // the segments of an arc follow each other
+        for( int j = i; j >= 0 && m_shapes[j] == arc; j-- )
+            m_shapes[j] = -1;
+
+        for( int j = i + 1; j < (int) m_shapes.size() && m_shapes[j] == arc; j++ )
+            m_shapes[j] = -1;
+    }
+}
+
+
 int SHAPE_LINE_CHAIN::Distance( const VECTOR2I& aP, bool aOutlineOnly ) const
 {
     int d = INT_MAX;
@@ -143,7 +317,14 @@ int SHAPE_LINE_CHAIN::Distance( const VECTOR2I& aP, bool aOutlineOnly ) const
         return 0;
 
     for( int s = 0; s < SegmentCount(); s++ )
-        d = std::min( d, CSegment( s ).Distance( aP ) );
+    {
+        int arc = ArcIndex( s );
+
+        if( arc < 0 )
+            d = std::min( d, CSegment( s ).Distance( aP ) );
+        else if( s == 0 || ArcIndex( s - 1 ) != arc )
+            d = std::min( d, m_arcs[arc].Distance( aP ) );
+    }
 
     return d;
 }
@@ -178,7 +359,7 @@ int SHAPE_LINE_CHAIN::Split( const VECTOR2I& aP )
 
     if( ii >= 0 )
     {
-        m_points.insert( m_points.begin() + ii + 1, aP );
+        Insert( ii + 1, aP );
 
         return ii + 1;
     }
@@ -220,6 +401,21 @@ const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Slice( int aStartIndex, int aEndIndex )
     for( int i = aStartIndex; i <= aEndIndex; i++ )
         rv.Append( m_points[i] );
 
+    // keep the arcs, unless duplicate points were skipped
+    if( !m_shapes.empty() && rv.PointCount() == aEndIndex - aStartIndex + 1 )
+    {
+        rv.m_arcs = m_arcs;
+        rv.m_shapes.assign( m_shapes.begin() + aStartIndex, m_shapes.begin() + aEndIndex + 1 );
+        rv.m_shapes.back() = -1;
+
+        // the arcs going on before or after the slice are only partly in it
+        if( aStartIndex > 0 && m_shapes[aStartIndex - 1] == m_shapes[aStartIndex] )
+            rv.breakArcs( 0, 0 );
+
+        if( aEndIndex > aStartIndex && m_shapes[aEndIndex] == m_shapes[aEndIndex - 1] )
+            rv.breakArcs( rv.PointCount() - 2, rv.PointCount() - 2 );
+    }
+
     return rv;
 }
 
@@ -465,6 +661,10 @@ SHAPE_LINE_CHAIN& SHAPE_LINE_CHAIN::Simplify()
 {
     std::vector<VECTOR2I> pts_unique;
 
+    // the points are moved: the arcs are lost
+    m_arcs.clear();
+    m_shapes.clear();
+
     if( PointCount() < 2 )
     {
         return *this;
@@ -616,6 +816,8 @@ bool SHAPE_LINE_CHAIN::Parse( std::stringstream& aStream )
     int n_pts;
 
     m_points.clear();
+    m_arcs.clear();
+    m_shapes.clear();
     aStream >> n_pts;
 
     // Rough sanity check, just make sure the loop bounds aren't absolutely outlandish
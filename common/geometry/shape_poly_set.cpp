@@ -32,6 +32,7 @@
 #include <set>
 #include <list>
 #include <algorithm>
+#include <cmath>
 #include <unordered_set>
 
 #include <common.h>
@@ -59,6 +60,19 @@ SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther ) :
 }
 
 
+SHAPE_POLY_SET::SHAPE_POLY_SET( SHAPE_POLY_SET&& aOther ) :
+    SHAPE( SH_POLY_SET ),
+    m_polys( std::move( aOther.m_polys ) ),
+    m_triangulatedPolys( std::move( aOther.m_triangulatedPolys ) ),
+    m_triangulationValid( aOther.m_triangulationValid ),
+    m_hash( aOther.m_hash )
+{
+    aOther.m_triangulatedPolys.clear();
+    aOther.m_triangulationValid = false;
+    aOther.m_hash = MD5_HASH{};
+}
+
+
 SHAPE_POLY_SET::~SHAPE_POLY_SET()
 {
 }
@@ -258,7 +272,7 @@ SHAPE_POLY_SET SHAPE_POLY_SET::Subset( int aFirstPolygon, int aLastPolygon )
 
     for( int index = aFirstPolygon; index < aLastPolygon; index++ )
     {
-        newPolySet.m_polys.push_back( Polygon( index ) );
+        newPolySet.m_polys.push_back( CPolygon( index ) );
     }
 
     return newPolySet;
@@ -456,30 +470,57 @@ int SHAPE_POLY_SET::AddHole( const SHAPE_LINE_CHAIN& aHole, int aOutline )
 }
 
 
-const Path SHAPE_POLY_SET::convertToClipper( const SHAPE_LINE_CHAIN& aPath,
-        bool aRequiredOrientation )
+/**
+ * Fills aPath with the points of aChain, in the orientation Clipper expects for an outline
+ * (aRequiredOrientation = true) or for a hole.  Callers reuse aPath for all the contours they
+ * convert, so it is only reallocated when a contour is bigger than the previous ones.
+ */
+static void convertToClipper( const SHAPE_LINE_CHAIN& aChain, bool aRequiredOrientation,
+                              Path& aPath )
 {
-    Path c_path;
+    int count = aChain.PointCount();
+
+    // Same computation as ClipperLib::Orientation(), done on the chain so the points can be
+    // stored in the required order instead of being reversed afterwards
+    double area = 0;
 
-    for( int i = 0; i < aPath.PointCount(); i++ )
+    if( count >= 3 )
     {
-        const VECTOR2I& vertex = aPath.CPoint( i );
-        c_path.push_back( IntPoint( vertex.x, vertex.y ) );
+        for( int i = 0, j = count - 1; i < count; j = i++ )
+        {
+            const VECTOR2I& pi = aChain.CPoint( i );
+            const VECTOR2I& pj = aChain.CPoint( j );
+
+            area += ( (double) pj.x + pi.x ) * ( (double) pj.y - pi.y );
+        }
     }
 
-    if( Orientation( c_path ) != aRequiredOrientation )
-        ReversePath( c_path );
+    bool orientation = -area * 0.5 >= 0;
+
+    aPath.clear();
+    aPath.reserve( count );
 
-    return c_path;
+    if( orientation == aRequiredOrientation )
+    {
+        for( int i = 0; i < count; i++ )
+            aPath.push_back( IntPoint( aChain.CPoint( i ).x, aChain.CPoint( i ).y ) );
+    }
+    else
+    {
+        for( int i = count - 1; i >= 0; i-- )
+            aPath.push_back( IntPoint( aChain.CPoint( i ).x, aChain.CPoint( i ).y ) );
+    }
 }
 
 
-const SHAPE_LINE_CHAIN SHAPE_POLY_SET::convertFromClipper( const Path& aPath )
+static SHAPE_LINE_CHAIN convertFromClipper( const Path& aPath )
 {
     SHAPE_LINE_CHAIN lc;
 
-    for( unsigned int i = 0; i < aPath.size(); i++ )
-        lc.Append( aPath[i].X, aPath[i].Y );
+    lc.Reserve( aPath.size() );
+
+    for( const IntPoint& pt : aPath )
+        lc.Append( pt.X, pt.Y );
 
     lc.SetClosed( true );
 
@@ -487,31 +528,95 @@ const SHAPE_LINE_CHAIN SHAPE_POLY_SET::convertFromClipper( const Path& aPath )
 }
 
 
-void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aOtherShape,
-        POLYGON_MODE aFastMode )
+/**
+ * Moves a contour out of a Clipper solution, with the same points as converting it to a
+ * SHAPE_LINE_CHAIN and back with convertToClipper().
+ */
+static Path takeContour( Path& aContour, bool aRequiredOrientation )
 {
-    Clipper c;
+    Path path( std::move( aContour ) );
 
-    if( aFastMode == PM_STRICTLY_SIMPLE )
-        c.StrictlySimple( true );
+    // SHAPE_LINE_CHAIN::Append() drops repeated points
+    path.erase( std::unique( path.begin(), path.end() ), path.end() );
 
-    for( const POLYGON& poly : m_polys )
+    if( Orientation( path ) != aRequiredOrientation )
+        ReversePath( path );
+
+    return path;
+}
+
+
+static void addPaths( Clipper& aClipper, const SHAPE_POLY_SET& aSet, PolyType aType,
+                      Path& aScratch )
+{
+    for( int ii = 0; ii < aSet.OutlineCount(); ii++ )
     {
+        const SHAPE_POLY_SET::POLYGON& poly = aSet.CPolygon( ii );
+
         for( unsigned int i = 0; i < poly.size(); i++ )
-            c.AddPath( convertToClipper( poly[i], i > 0 ? false : true ), ptSubject, true );
+        {
+            convertToClipper( poly[i], i == 0, aScratch );
+            aClipper.AddPath( aScratch, aType, true );
+        }
     }
+}
 
-    for( const POLYGON& poly : aOtherShape.m_polys )
+
+static void addPaths( ClipperOffset& aClipper, const SHAPE_POLY_SET& aSet, Path& aScratch )
+{
+    for( int ii = 0; ii < aSet.OutlineCount(); ii++ )
     {
+        const SHAPE_POLY_SET::POLYGON& poly = aSet.CPolygon( ii );
+
         for( unsigned int i = 0; i < poly.size(); i++ )
-            c.AddPath( convertToClipper( poly[i], i > 0 ? false : true ), ptClip, true );
+        {
+            convertToClipper( poly[i], i == 0, aScratch );
+            aClipper.AddPath( aScratch, jtRound, etClosedPolygon );
+        }
     }
+}
 
-    PolyTree solution;
 
-    c.Execute( aType, solution, pftNonZero, pftNonZero );
+/**
+ * Returns the arc tolerance (arc error) of an inflation by aFactor using aCircleSegmentsCount
+ * segments per circle.
+ */
+static double arcTolerance( int aFactor, int aCircleSegmentsCount )
+{
+    // A static table to avoid repetitive calculations of the coefficient
+    // 1.0 - cos( M_PI/aCircleSegmentsCount)
+    // aCircleSegmentsCount is most of time <= 64 and usually 8, 12, 16, 32
+    #define SEG_CNT_MAX 64
+    static double arc_tolerance_factor[SEG_CNT_MAX + 1];
 
-    importTree( &solution );
+    // Calculate the arc tolerance (arc error) from the seg count by circle.
+    // the seg count is nn = M_PI / acos(1.0 - c.ArcTolerance / abs(aFactor))
+    // see:
+    // www.angusj.com/delphi/clipper/documentation/Docs/Units/ClipperLib/Classes/ClipperOffset/Properties/ArcTolerance.htm
+
+    if( aCircleSegmentsCount < 6 ) // avoid incorrect aCircleSegmentsCount values
+        aCircleSegmentsCount = 6;
+
+    double coeff;
+
+    if( aCircleSegmentsCount > SEG_CNT_MAX || arc_tolerance_factor[aCircleSegmentsCount] == 0 )
+    {
+        coeff = 1.0 - cos( M_PI / aCircleSegmentsCount );
+
+        if( aCircleSegmentsCount <= SEG_CNT_MAX )
+            arc_tolerance_factor[aCircleSegmentsCount] = coeff;
+    }
+    else
+        coeff = arc_tolerance_factor[aCircleSegmentsCount];
+
+    return std::abs( aFactor ) * coeff;
+}
+
+
+void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aOtherShape,
+        POLYGON_MODE aFastMode )
+{
+    booleanOp( aType, *this, aOtherShape, aFastMode );
 }
 
 
@@ -521,21 +626,13 @@ void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType,
         POLYGON_MODE aFastMode )
 {
     Clipper c;
+    Path    scratch;
 
     if( aFastMode == PM_STRICTLY_SIMPLE )
         c.StrictlySimple( true );
 
-    for( const POLYGON& poly : aShape.m_polys )
-    {
-        for( unsigned int i = 0; i < poly.size(); i++ )
-            c.AddPath( convertToClipper( poly[i], i > 0 ? false : true ), ptSubject, true );
-    }
-
-    for( const POLYGON& poly : aOtherShape.m_polys )
-    {
-        for( unsigned int i = 0; i < poly.size(); i++ )
-            c.AddPath( convertToClipper( poly[i], i > 0 ? false : true ), ptClip, true );
-    }
+    addPaths( c, aShape, ptSubject, scratch );
+    addPaths( c, aOtherShape, ptClip, scratch );
 
     PolyTree solution;
 
@@ -589,72 +686,169 @@ void SHAPE_POLY_SET::BooleanIntersection( const SHAPE_POLY_SET& a,
 
 void SHAPE_POLY_SET::Inflate( int aFactor, int aCircleSegmentsCount )
 {
-    // A static table to avoid repetitive calculations of the coefficient
-    // 1.0 - cos( M_PI/aCircleSegmentsCount)
-    // aCircleSegmentsCount is most of time <= 64 and usually 8, 12, 16, 32
-    #define SEG_CNT_MAX 64
-    static double arc_tolerance_factor[SEG_CNT_MAX + 1];
-
     ClipperOffset c;
+    Path          scratch;
 
-    for( const POLYGON& poly : m_polys )
-    {
-        for( unsigned int i = 0; i < poly.size(); i++ )
-            c.AddPath( convertToClipper( poly[i], i > 0 ? false : true ), jtRound,
-                    etClosedPolygon );
-    }
+    addPaths( c, *this, scratch );
 
     PolyTree solution;
 
-    // Calculate the arc tolerance (arc error) from the seg count by circle.
-    // the seg count is nn = M_PI / acos(1.0 - c.ArcTolerance / abs(aFactor))
-    // see:
-    // www.angusj.com/delphi/clipper/documentation/Docs/Units/ClipperLib/Classes/ClipperOffset/Properties/ArcTolerance.htm
+    c.ArcTolerance = arcTolerance( aFactor, aCircleSegmentsCount );
 
-    if( aCircleSegmentsCount < 6 ) // avoid incorrect aCircleSegmentsCount values
-        aCircleSegmentsCount = 6;
+    c.Execute( solution, aFactor );
 
-    double coeff;
+    importTree( &solution );
+}
 
-    if( aCircleSegmentsCount > SEG_CNT_MAX || arc_tolerance_factor[aCircleSegmentsCount] == 0 )
+
+void SHAPE_POLY_SET::importTree( PolyTree* tree )
+{
+    m_polys.clear();
+
+    for( PolyNode* n = tree->GetFirst(); n; n = n->GetNext() )
     {
-        coeff = 1.0 - cos( M_PI / aCircleSegmentsCount );
+        if( !n->IsHole() )
+        {
+            POLYGON paths;
+            paths.reserve( n->Childs.size() + 1 );
+            paths.push_back( convertFromClipper( n->Contour ) );
 
-        if( aCircleSegmentsCount <= SEG_CNT_MAX )
-            arc_tolerance_factor[aCircleSegmentsCount] = coeff;
+            for( unsigned int i = 0; i < n->Childs.size(); i++ )
+                paths.push_back( convertFromClipper( n->Childs[i]->Contour ) );
+
+            m_polys.push_back( std::move( paths ) );
+        }
     }
-    else
-        coeff = arc_tolerance_factor[aCircleSegmentsCount];
+}
+
 
-    c.ArcTolerance = std::abs( aFactor ) * coeff;
+SHAPE_POLY_SET::BOOLEAN_PIPELINE::BOOLEAN_PIPELINE( const SHAPE_POLY_SET& aSource )
+{
+    m_polys.resize( aSource.OutlineCount() );
+
+    for( int ii = 0; ii < aSource.OutlineCount(); ii++ )
+    {
+        const POLYGON& poly = aSource.CPolygon( ii );
+
+        m_polys[ii].resize( poly.size() );
+
+        for( unsigned int i = 0; i < poly.size(); i++ )
+            convertToClipper( poly[i], i == 0, m_polys[ii][i] );
+    }
+}
+
+
+void SHAPE_POLY_SET::BOOLEAN_PIPELINE::booleanOp( ClipperLib::ClipType aType,
+        const SHAPE_POLY_SET& aOther, POLYGON_MODE aFastMode )
+{
+    Clipper c;
+
+    for( const Paths& poly : m_polys )
+        c.AddPaths( poly, ptSubject, true );
+
+    addPaths( c, aOther, ptClip, m_scratch );
+
+    execute( c, aType, aFastMode );
+}
+
+
+void SHAPE_POLY_SET::BOOLEAN_PIPELINE::booleanOp( ClipperLib::ClipType aType,
+        const BOOLEAN_PIPELINE& aOther, POLYGON_MODE aFastMode )
+{
+    Clipper c;
+
+    for( const Paths& poly : m_polys )
+        c.AddPaths( poly, ptSubject, true );
+
+    for( const Paths& poly : aOther.m_polys )
+        c.AddPaths( poly, ptClip, true );
+
+    execute( c, aType, aFastMode );
+}
+
+
+void SHAPE_POLY_SET::BOOLEAN_PIPELINE::Simplify( POLYGON_MODE aFastMode )
+{
+    Clipper c;
+
+    for( const Paths& poly : m_polys )
+        c.AddPaths( poly, ptSubject, true );
+
+    execute( c, ctUnion, aFastMode );
+}
+
+
+void SHAPE_POLY_SET::BOOLEAN_PIPELINE::Inflate( int aFactor, int aCircleSegmentsCount )
+{
+    ClipperOffset c;
+
+    for( const Paths& poly : m_polys )
+        c.AddPaths( poly, jtRound, etClosedPolygon );
+
+    PolyTree solution;
+
+    c.ArcTolerance = arcTolerance( aFactor, aCircleSegmentsCount );
 
     c.Execute( solution, aFactor );
 
-    importTree( &solution );
+    importTree( solution );
 }
 
 
-void SHAPE_POLY_SET::importTree( PolyTree* tree )
+void SHAPE_POLY_SET::BOOLEAN_PIPELINE::execute( Clipper& aClipper, ClipperLib::ClipType aType,
+        POLYGON_MODE aFastMode )
+{
+    if( aFastMode == PM_STRICTLY_SIMPLE )
+        aClipper.StrictlySimple( true );
+
+    PolyTree solution;
+
+    aClipper.Execute( aType, solution, pftNonZero, pftNonZero );
+
+    importTree( solution );
+}
+
+
+void SHAPE_POLY_SET::BOOLEAN_PIPELINE::importTree( PolyTree& aTree )
 {
     m_polys.clear();
 
-    for( PolyNode* n = tree->GetFirst(); n; n = n->GetNext() )
+    for( PolyNode* n = aTree.GetFirst(); n; n = n->GetNext() )
     {
         if( !n->IsHole() )
         {
-            POLYGON paths;
+            Paths paths;
             paths.reserve( n->Childs.size() + 1 );
-            paths.push_back( convertFromClipper( n->Contour ) );
+            paths.push_back( takeContour( n->Contour, true ) );
 
             for( unsigned int i = 0; i < n->Childs.size(); i++ )
-                paths.push_back( convertFromClipper( n->Childs[i]->Contour ) );
+                paths.push_back( takeContour( n->Childs[i]->Contour, false ) );
 
-            m_polys.push_back( paths );
+            m_polys.push_back( std::move( paths ) );
         }
     }
 }
 
 
+SHAPE_POLY_SET SHAPE_POLY_SET::BOOLEAN_PIPELINE::Result() const
+{
+    SHAPE_POLY_SET result;
+
+    for( const Paths& paths : m_polys )
+    {
+        POLYGON poly;
+        poly.reserve( paths.size() );
+
+        for( const Path& path : paths )
+            poly.push_back( convertFromClipper( path ) );
+
+        result.m_polys.push_back( std::move( poly ) );
+    }
+
+    return result;
+}
+
+
 struct FractureEdge
 {
     FractureEdge( bool connected, SHAPE_LINE_CHAIN* owner, int index ) :
@@ -694,10 +888,55 @@ struct FractureEdge
 };
 
 
-typedef std::vector<FractureEdge*> FractureEdgeSet;
+/**
+ * The connected edges of a polygon being fractured, bucketed by Y so a hole finds the
+ * edges it can be bridged to without scanning all the edges.  An edge is stored in every
+ * bucket its Y range overlaps.  Edges only shrink once stored (when split by a bridge),
+ * so the buckets of an edge always cover its current Y range.
+ */
+class FRACTURE_EDGE_INDEX
+{
+public:
+    FRACTURE_EDGE_INDEX( int aYMin, int aYMax, int aBucketCount ) :
+        m_yMin( aYMin ),
+        m_yRange( (int64_t) aYMax - aYMin + 1 ),
+        m_buckets( std::max( aBucketCount, 1 ) )
+    {
+    }
+
+    void Add( FractureEdge* aEdge )
+    {
+        int first = bucket( std::min( aEdge->m_p1.y, aEdge->m_p2.y ) );
+        int last = bucket( std::max( aEdge->m_p1.y, aEdge->m_p2.y ) );
+
+        for( int i = first; i <= last; i++ )
+            m_buckets[i].push_back( aEdge );
+    }
 
+    const std::vector<FractureEdge*>& Edges( int aY ) const
+    {
+        return m_buckets[bucket( aY )];
+    }
 
-static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
+private:
+    int bucket( int aY ) const
+    {
+        return (int) ( ( (int64_t) aY - m_yMin ) * (int64_t) m_buckets.size() / m_yRange );
+    }
+
+    int m_yMin;
+    int64_t m_yRange;
+    std::vector<std::vector<FractureEdge*>> m_buckets;
+};
+
+
+/**
+ * Bridges the hole starting at @a edge to the nearest connected edge on its left.  The edges
+ * are allocated in @a edges, in the order used to break ties between edges at the same
+ * distance: the first one allocated wins.
+ */
+static int processEdge( std::vector<FractureEdge>& edges, FRACTURE_EDGE_INDEX& index,
+                        FractureEdge* edge )
 {
     int x   = edge->m_p1.x;
     int y   = edge->m_p1.y;
@@ -706,43 +945,40 @@ static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
 
     FractureEdge* e_nearest = NULL;
 
-    for( FractureEdgeSet::iterator i = edges.begin(); i != edges.end(); ++i )
+    for( FractureEdge* e : index.Edges( y ) )
     {
-        if( !(*i)->matches( y ) )
+        if( !e->matches( y ) )
             continue;
 
         int x_intersect;
 
-        if( (*i)->m_p1.y == (*i)->m_p2.y ) // horizontal edge
-            x_intersect = std::max( (*i)->m_p1.x, (*i)->m_p2.x );
+        if( e->m_p1.y == e->m_p2.y ) // horizontal edge
+            x_intersect = std::max( e->m_p1.x, e->m_p2.x );
         else
-            x_intersect = (*i)->m_p1.x + rescale( (*i)->m_p2.x - (*i)->m_p1.x, y - (*i)->m_p1.y,
-                    (*i)->m_p2.y - (*i)->m_p1.y );
+            x_intersect = e->m_p1.x + rescale( e->m_p2.x - e->m_p1.x, y - e->m_p1.y,
+                    e->m_p2.y - e->m_p1.y );
 
         int dist = ( x - x_intersect );
 
-        if( dist >= 0 && dist < min_dist && (*i)->m_connected )
+        if( dist >= 0 && ( dist < min_dist || ( dist == min_dist && e < e_nearest ) ) )
         {
             min_dist    = dist;
             x_nearest   = x_intersect;
-            e_nearest   = (*i);
+            e_nearest   = e;
         }
     }
 
-    if( e_nearest && e_nearest->m_connected )
+    if( e_nearest )
     {
         int count = 0;
 
-        FractureEdge* lead1 =
-            new FractureEdge( true, VECTOR2I( x_nearest, y ), VECTOR2I( x, y ) );
-        FractureEdge* lead2 =
-            new FractureEdge( true, VECTOR2I( x, y ), VECTOR2I( x_nearest, y ) );
-        FractureEdge* split_2 =
-            new FractureEdge( true, VECTOR2I( x_nearest, y ), e_nearest->m_p2 );
-
-        edges.push_back( split_2 );
-        edges.push_back( lead1 );
-        edges.push_back( lead2 );
+        // The storage was reserved for all the bridges, so adding edges does not move them
+        edges.emplace_back( true, VECTOR2I( x_nearest, y ), e_nearest->m_p2 );
+        FractureEdge* split_2 = &edges.back();
+        edges.emplace_back( true, VECTOR2I( x_nearest, y ), VECTOR2I( x, y ) );
+        FractureEdge* lead1 = &edges.back();
+        edges.emplace_back( true, VECTOR2I( x, y ), VECTOR2I( x_nearest, y ) );
+        FractureEdge* lead2 = &edges.back();
 
         FractureEdge* link = e_nearest->m_next;
 
@@ -755,14 +991,20 @@ static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
         for( last = edge; last->m_next != edge; last = last->m_next )
         {
             last->m_connected = true;
+            index.Add( last );
             count++;
         }
 
         last->m_connected = true;
+        index.Add( last );
         last->m_next    = lead2;
         lead2->m_next   = split_2;
         split_2->m_next = link;
 
+        index.Add( split_2 );
+        index.Add( lead1 );
+        index.Add( lead2 );
+
         return count + 1;
     }
 
@@ -772,20 +1014,38 @@ static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
 
 void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
 {
-    FractureEdgeSet edges;
-    FractureEdgeSet border_edges;
-    FractureEdge*   root = NULL;
-
-    bool first = true;
-
     if( paths.size() == 1 )
         return;
 
-    int num_unconnected = 0;
+    // Each hole adds 3 edges when bridged to the outline
+    size_t edgeCount = 3 * ( paths.size() - 1 );
+    int    y_min = std::numeric_limits<int>::max();
+    int    y_max = std::numeric_limits<int>::min();
+
+    for( SHAPE_LINE_CHAIN& path : paths )
+    {
+        edgeCount += path.PointCount();
+
+        for( int i = 0; i < path.PointCount(); i++ )
+        {
+            y_min = std::min( y_min, path.CPoint( i ).y );
+            y_max = std::max( y_max, path.CPoint( i ).y );
+        }
+    }
+
+    std::vector<FractureEdge>  edges;
+    std::vector<FractureEdge*> border_edges;
+    FractureEdge*              root = NULL;
+
+    edges.reserve( edgeCount );
+
+    FRACTURE_EDGE_INDEX index( y_min, y_max, (int) std::sqrt( (double) edgeCount ) );
+
+    bool first = true;
 
     for( SHAPE_LINE_CHAIN& path : paths )
     {
-        int index = 0;
+        int index_in_path = 0;
 
         FractureEdge* prev = NULL, * first_edge = NULL;
 
@@ -801,7 +1061,8 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
 
         for( int i = 0; i < path.PointCount(); i++ )
         {
-            FractureEdge* fe = new FractureEdge( first, &path, index++ );
+            edges.emplace_back( first, &path, index_in_path++ );
+            FractureEdge* fe = &edges.back();
 
             if( !root )
                 root = fe;
@@ -816,41 +1077,28 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
                 fe->m_next = first_edge;
 
             prev = fe;
-            edges.push_back( fe );
 
-            if( !first )
-            {
-                if( fe->m_p1.x == x_min )
-                    border_edges.push_back( fe );
-            }
-
-            if( !fe->m_connected )
-                num_unconnected++;
+            if( first )
+                index.Add( fe );
+            else if( fe->m_p1.x == x_min )
+                border_edges.push_back( fe );
         }
 
         first = false;    // first path is always the outline
     }
 
-    // keep connecting holes to the main outline, until there's no holes left...
-    while( num_unconnected > 0 )
-    {
-        int x_min = std::numeric_limits<int>::max();
-
-        FractureEdge* smallestX = NULL;
-
-        // find the left-most hole edge and merge with the outline
-        for( FractureEdgeSet::iterator i = border_edges.begin(); i != border_edges.end(); ++i )
-        {
-            int xt = (*i)->m_p1.x;
+    // Connect the holes to the main outline from left to right: the holes on the left of a
+    // hole are already connected to the outline when it is bridged.
+    std::stable_sort( border_edges.begin(), border_edges.end(),
+                      []( const FractureEdge* a, const FractureEdge* b )
+                      {
+                          return a->m_p1.x < b->m_p1.x;
+                      } );
 
-            if( ( xt < x_min ) && !(*i)->m_connected )
-            {
-                x_min = xt;
-                smallestX = *i;
-            }
-        }
-
-        num_unconnected -= processEdge( edges, smallestX );
+    for( FractureEdge* edge : border_edges )
+    {
+        if( !edge->m_connected )
+            processEdge( edges, index, edge );
     }
 
     paths.clear();
@@ -865,9 +1113,6 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
 
     newPath.Append( e->m_p1 );
 
-    for( FractureEdgeSet::iterator i = edges.begin(); i != edges.end(); ++i )
-        delete *i;
-
     paths.push_back( newPath );
 }
 
@@ -1541,7 +1786,7 @@ int SHAPE_POLY_SET::TotalVertices() const
 }
 
 
-SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::ChamferPolygon( unsigned int aDistance, int aIndex )
+SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::ChamferPolygon( unsigned int aDistance, int aIndex ) const
 {
     return chamferFilletPolygon( CORNER_MODE::CHAMFERED, aDistance, aIndex );
 }
@@ -1549,7 +1794,7 @@ SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::ChamferPolygon( unsigned int aDistance,
 
 SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::FilletPolygon( unsigned int aRadius,
         int aErrorMax,
-        int aIndex )
+        int aIndex ) const
 {
     return chamferFilletPolygon( CORNER_MODE::FILLETED, aRadius, aIndex, aErrorMax );
 }
@@ -1665,7 +1910,7 @@ bool SHAPE_POLY_SET::IsVertexInHole( int aGlobalIdx )
 }
 
 
-SHAPE_POLY_SET SHAPE_POLY_SET::Chamfer( int aDistance )
+SHAPE_POLY_SET SHAPE_POLY_SET::Chamfer( int aDistance ) const
 {
     SHAPE_POLY_SET chamfered;
 
@@ -1676,7 +1921,7 @@ SHAPE_POLY_SET SHAPE_POLY_SET::Chamfer( int aDistance )
 }
 
 
-SHAPE_POLY_SET SHAPE_POLY_SET::Fillet( int aRadius, int aErrorMax )
+SHAPE_POLY_SET SHAPE_POLY_SET::Fillet( int aRadius, int aErrorMax ) const
 {
     SHAPE_POLY_SET filleted;
 
@@ -1690,12 +1935,19 @@ SHAPE_POLY_SET SHAPE_POLY_SET::Fillet( int aRadius, int aErrorMax )
 SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::chamferFilletPolygon( CORNER_MODE aMode,
         unsigned int aDistance,
         int aIndex,
-        int aErrorMax )
+        int aErrorMax ) const
 {
-    // Null segments create serious issues in calculations. Remove them:
-    RemoveNullSegments();
+    // Null segments create serious issues in calculations. Remove them from a copy of the
+    // polygon, so the set itself is not modified:
+    SHAPE_POLY_SET polySet;
+
+    polySet.m_polys.push_back( CPolygon( aIndex ) );
 
-    SHAPE_POLY_SET::POLYGON currentPoly = Polygon( aIndex );
+    // A pass can leave a null segment following a removed one
+    while( polySet.RemoveNullSegments() > 0 )
+        ;
+
+    SHAPE_POLY_SET::POLYGON currentPoly = std::move( polySet.Polygon( 0 ) );
     SHAPE_POLY_SET::POLYGON newPoly;
 
     // If the chamfering distance is zero, then the polygon remain intact.
@@ -1863,6 +2115,21 @@ SHAPE_POLY_SET &SHAPE_POLY_SET::operator=( const SHAPE_POLY_SET& aOther )
 }
 
 
+SHAPE_POLY_SET &SHAPE_POLY_SET::operator=( SHAPE_POLY_SET&& aOther )
+{
+    static_cast<SHAPE&>(*this) = aOther;
+    m_polys = std::move( aOther.m_polys );
+    m_triangulatedPolys = std::move( aOther.m_triangulatedPolys );
+    m_triangulationValid = aOther.m_triangulationValid;
+    m_hash = aOther.m_hash;
+
+    aOther.m_triangulatedPolys.clear();
+    aOther.m_triangulationValid = false;
+    aOther.m_hash = MD5_HASH{};
+    return *this;
+}
+
+
 class SHAPE_POLY_SET::TRIANGULATION_CONTEXT
 {
 public:
@@ -2082,7 +2349,7 @@ void SHAPE_POLY_SET::CacheTriangulation()
     for( int i = 0; i < tmpSet.OutlineCount(); i++ )
     {
         m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>() );
-        triangulateSingle( tmpSet.Polygon( i ), *m_triangulatedPolys.back() );
+        triangulateSingle( tmpSet.CPolygon( i ), *m_triangulatedPolys.back() );
     }
 
     m_triangulationValid = true;
@@ -23,10 +23,12 @@
  */
 
 
+#include <algorithm>
 #include <cstdarg>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
 #include <richio.h>
+#include <format_number.h>                 // FormatInt, FormatDecimal
 
 
 // Fall back to getc() when getc_unlocked() is not available on the target platform.
@@ -412,13 +414,9 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
     int result = 0;
     int total  = 0;
 
-    for( int i=0; i<nestLevel;  ++i )
-    {
-        // no error checking needed, an exception indicates an error.
-        result = sprint( "%*c", NESTWIDTH, ' ' );
-
-        total += result;
-    }
+    // no error checking needed, an exception indicates an error.
+    Indent( nestLevel );
+    total += NESTWIDTH * std::max( nestLevel, 0 );
 
     // no error checking needed, an exception indicates an error.
     result = vprint( fmt, args );
@@ -430,6 +428,32 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
 }
 
 
+void OUTPUTFORMATTER::Indent( int nestLevel )
+{
+    static const char spaces[] = "                                                  ";
+    const int         maxCount = sizeof( spaces ) - 1;
+
+    for( int count = NESTWIDTH * nestLevel; count > 0; count -= maxCount )
+        write( spaces, std::min( count, maxCount ) );
+}
+
+
+void OUTPUTFORMATTER::AppendInt( long long aValue )
+{
+    char buf[32];
+
+    write( buf, FormatInt( buf, aValue ) - buf );
+}
+
+
+void OUTPUTFORMATTER::AppendDecimal( long long aValue, int aDecimals )
+{
+    char buf[48];
+
+    write( buf, FormatDecimal( buf, aValue, aDecimals ) - buf );
+}
+
+
 std::string OUTPUTFORMATTER::Quotes( const std::string& aWrapee )
 {
     static const char quoteThese[] = "\t ()\n\r";
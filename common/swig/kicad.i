@@ -135,6 +135,8 @@ typedef long time_t;
 #include <geometry/shape.h>
 %include <geometry/shape.h>
 
+// ignore BOOLEAN_PIPELINE as nested classes are still unsupported by swig
+%ignore SHAPE_POLY_SET::BOOLEAN_PIPELINE;
 #include <geometry/shape_poly_set.h>
 %include <geometry/shape_poly_set.h>
 
@@ -32,6 +32,7 @@
 #include <wx/regex.h>
 #include <algorithm>
 #include <vector>
+#include <tuple>
 #include <unordered_set>
 
 #include <fctsys.h>
@@ -237,38 +238,24 @@ int SCH_REFERENCE_LIST::GetLastReference( int aIndex, int aMinValue )
 }
 
 
-int SCH_REFERENCE_LIST::CreateFirstFreeRefId( std::vector<int>& aIdList, int aFirstValue )
+int SCH_REFERENCE_LIST::CreateFirstFreeRefId( const std::vector<int>& aIdList, size_t& aIdPos,
+                                               int& aNextId )
 {
-    int expectedId = aFirstValue;
-
-    // We search for expected Id a value >= aFirstValue.
-    // Skip existing Id < aFirstValue
-    unsigned ii = 0;
-
-    for( ; ii < aIdList.size(); ii++ )
+    // Ids are sorted by increasing value, and the free Ids are returned by increasing value
+    // too.  So the search for the first hole in the list starts where the previous one
+    // ended: skip the existing Ids lower than the expected Id.
+    while( aIdPos < aIdList.size() && aIdList[aIdPos] < aNextId )
+        aIdPos++;
+
+    // Skip the Ids in use from the expected Id.
+    while( aIdPos < aIdList.size() && aIdList[aIdPos] == aNextId )
     {
-        if( expectedId <= aIdList[ii] )
-            break;
+        aIdPos++;
+        aNextId++;
     }
 
-    // Ids are sorted by increasing value, from aFirstValue
-    // So we search from aFirstValue the first not used value, i.e. the first hole in list.
-    for( ; ii < aIdList.size(); ii++ )
-    {
-        if( expectedId != aIdList[ii] )    // This id is not yet used.
-        {
-            // Insert this free Id, in order to keep list sorted
-            aIdList.insert( aIdList.begin() + ii, expectedId );
-            return expectedId;
-        }
-
-        expectedId++;
-    }
-
-    // All existing Id are tested, and all values are found in use.
-    // So Create a new one.
-    aIdList.push_back( expectedId );
-    return expectedId;
+    // This Id is not yet used.
+    return aNextId++;
 }
 
 
@@ -296,6 +283,111 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
     int LastReferenceNumber = 0;
     int NumberOfUnits, Unit;
 
+    // Searching the whole list for each component makes the annotation quadratic in the
+    // number of components, so the searches below use indexes built once and kept up to
+    // date when a component is annotated:
+    //  - the components using each reference number, by reference prefix,
+    //  - the units already annotated for each reference, by prefix and number,
+    //  - the components which can receive the other units of a multi-unit component,
+    //    by prefix, value and symbol name, in list order.
+    typedef std::pair< std::string, int > FULL_REF;
+    typedef std::tuple< std::string, wxString, std::string > UNIT_GROUP_KEY;
+
+    struct UNIT_GROUP
+    {
+        std::vector<size_t> m_Items;
+        size_t              m_First = 0;   ///< Items before m_First can no longer be used.
+    };
+
+    std::map< std::string, std::map< int, int > > refsInUse;
+    std::map< FULL_REF, std::map< int, int > >    unitsInUse;
+    std::map< UNIT_GROUP_KEY, UNIT_GROUP >        unitGroups;
+
+    auto prefix = [&]( size_t aIndex ) -> const std::string&
+    {
+        return componentFlatList[aIndex].m_Ref;
+    };
+
+    auto unitGroupKey = [&]( size_t aIndex ) -> UNIT_GROUP_KEY
+    {
+        const SCH_REFERENCE& ref = componentFlatList[aIndex];
+
+        return UNIT_GROUP_KEY( (const std::string&) ref.m_Ref, ref.m_Value->GetText(),
+                               (const std::string&) ref.m_RootCmp->GetLibId().GetLibItemName() );
+    };
+
+    auto addToIndex = [&]( size_t aIndex )
+    {
+        const SCH_REFERENCE& ref = componentFlatList[aIndex];
+
+        refsInUse[ prefix( aIndex ) ][ ref.m_NumRef ]++;
+
+        if( !ref.m_IsNew )
+            unitsInUse[ FULL_REF( prefix( aIndex ), ref.m_NumRef ) ][ ref.m_Unit ]++;
+    };
+
+    auto removeFromIndex = [&]( size_t aIndex )
+    {
+        const SCH_REFERENCE& ref = componentFlatList[aIndex];
+
+        if( --refsInUse[ prefix( aIndex ) ][ ref.m_NumRef ] == 0 )
+            refsInUse[ prefix( aIndex ) ].erase( ref.m_NumRef );
+
+        if( !ref.m_IsNew )
+        {
+            std::map< int, int >& units = unitsInUse[ FULL_REF( prefix( aIndex ),
+                                                                ref.m_NumRef ) ];
+
+            if( --units[ ref.m_Unit ] == 0 )
+                units.erase( ref.m_Unit );
+        }
+    };
+
+    // Replaces FindUnit(): is this unit already annotated for this reference?
+    auto isUnitInUse = [&]( size_t aIndex, int aUnit ) -> bool
+    {
+        auto units = unitsInUse.find( FULL_REF( prefix( aIndex ),
+                                                componentFlatList[aIndex].m_NumRef ) );
+
+        return units != unitsInUse.end() && units->second.count( aUnit );
+    };
+
+    for( size_t ii = 0; ii < componentFlatList.size(); ii++ )
+    {
+        addToIndex( ii );
+
+        if( componentFlatList[ii].m_IsNew && !componentFlatList[ii].m_Flag )
+            unitGroups[ unitGroupKey( ii ) ].m_Items.push_back( ii );
+    }
+
+    // Index the component instances, to find the units locked together.
+    typedef std::pair< SCH_COMPONENT*, wxString > INSTANCE;
+
+    std::map< INSTANCE, SCH_REFERENCE_LIST* > lockedLists;
+    std::map< INSTANCE, std::vector<size_t> > instances;
+
+    if( !aLockedUnitMap.empty() )
+    {
+        for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+        {
+            for( unsigned thisRefI = 0; thisRefI < pair.second.GetCount(); ++thisRefI )
+            {
+                SCH_REFERENCE& thisRef = pair.second[thisRefI];
+
+                lockedLists.insert( std::make_pair( INSTANCE( thisRef.GetComp(),
+                                                              thisRef.GetSheetPath().Path() ),
+                                                    &pair.second ) );
+            }
+        }
+
+        for( size_t ii = 0; ii < componentFlatList.size(); ii++ )
+        {
+            SCH_REFERENCE& ref = componentFlatList[ii];
+
+            instances[ INSTANCE( ref.GetComp(), ref.GetSheetPath().Path() ) ].push_back( ii );
+        }
+    }
+
     /* calculate index of the first component with the same reference prefix
      * than the current component.  All components having the same reference
      * prefix will receive a reference number with consecutive values:
@@ -333,10 +425,27 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
     // inUseRefs keep trace of previously allocated references
     std::unordered_set<wxString> inUseRefs;
 
-    // This is the list of all Id already in use for a given reference prefix.
+    // This is the list of all Id already in use for a given reference prefix, and the
+    // state of the search for the next free Id in this list.
     // Will be refilled for each new reference prefix.
-    std::vector<int>idList;
-    GetRefsInUse( first, idList, minRefId );
+    std::vector<int> idList;
+    size_t           idPos;
+    int              nextId;
+
+    auto getRefsInUse = [&]()
+    {
+        const std::map< int, int >& numbers = refsInUse[ prefix( first ) ];
+
+        idList.clear();
+
+        for( auto it = numbers.lower_bound( minRefId ); it != numbers.end(); ++it )
+            idList.push_back( it->first );
+
+        idPos = 0;
+        nextId = minRefId;
+    };
+
+    getRefsInUse();
 #endif
     for( unsigned ii = 0; ii < componentFlatList.size(); ii++ )
     {
@@ -345,21 +454,14 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
         // Check whether this component is in aLockedUnitMap.
         SCH_REFERENCE_LIST* lockedList = NULL;
-        for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
-        {
-            unsigned n_refs = pair.second.GetCount();
 
-            for( unsigned thisRefI = 0; thisRefI < n_refs; ++thisRefI )
-            {
-                SCH_REFERENCE &thisRef = pair.second[thisRefI];
+        if( !lockedLists.empty() )
+        {
+            auto locked = lockedLists.find( INSTANCE( componentFlatList[ii].GetComp(),
+                                        componentFlatList[ii].GetSheetPath().Path() ) );
 
-                if( thisRef.IsSameInstance( componentFlatList[ii] ) )
-                {
-                    lockedList = &pair.second;
-                    break;
-                }
-            }
-            if( lockedList != NULL ) break;
+            if( locked != lockedLists.end() )
+                lockedList = locked->second;
         }
 
         if(  ( componentFlatList[first].CompareRef( componentFlatList[ii] ) != 0 )
@@ -383,19 +485,21 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             else
                 minRefId = aStartNumber + 1;
 
-            GetRefsInUse( first, idList, minRefId );
+            getRefsInUse();
 #endif
         }
 
         // Annotation of one part per package components (trivial case).
         if( componentFlatList[ii].GetLibPart()->GetUnitCount() <= 1 )
         {
+            removeFromIndex( ii );
+
             if( componentFlatList[ii].m_IsNew )
             {
 #ifdef USE_OLD_ALGO
                 LastReferenceNumber++;
 #else
-                LastReferenceNumber = CreateFirstFreeRefId( idList, minRefId );
+                LastReferenceNumber = CreateFirstFreeRefId( idList, idPos, nextId );
 #endif
                 componentFlatList[ii].m_NumRef = LastReferenceNumber;
             }
@@ -403,6 +507,7 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             componentFlatList[ii].m_Unit  = 1;
             componentFlatList[ii].m_Flag  = 1;
             componentFlatList[ii].m_IsNew = false;
+            addToIndex( ii );
             continue;
         }
 
@@ -411,10 +516,11 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
         if( componentFlatList[ii].m_IsNew )
         {
+            removeFromIndex( ii );
 #ifdef USE_OLD_ALGO
             LastReferenceNumber++;
 #else
-            LastReferenceNumber = CreateFirstFreeRefId( idList, minRefId );
+            LastReferenceNumber = CreateFirstFreeRefId( idList, idPos, nextId );
 #endif
             componentFlatList[ii].m_NumRef = LastReferenceNumber;
 
@@ -422,6 +528,7 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                 componentFlatList[ii].m_Unit = 1;
 
             componentFlatList[ii].m_Flag = 1;
+            addToIndex( ii );
         }
 
         // If this component is in aLockedUnitMap, copy the annotation to all
@@ -437,7 +544,9 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                 if( thisRef.IsSameInstance( componentFlatList[ii] ) )
                 {
                     // This is the component we're currently annotating. Hold the unit!
+                    removeFromIndex( ii );
                     componentFlatList[ii].m_Unit = thisRef.m_Unit;
+                    addToIndex( ii );
                     // lock this new full reference
                     inUseRefs.insert( buildFullReference( componentFlatList[ii] ) );
                 }
@@ -449,26 +558,35 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     continue;
 
                 // Find the matching component
-                for( unsigned jj = ii + 1; jj < componentFlatList.size(); jj++ )
-                {
-                    if( ! thisRef.IsSameInstance( componentFlatList[jj] ) )
-                        continue;
+                auto instance = instances.find( INSTANCE( thisRef.GetComp(),
+                                                          thisRef.GetSheetPath().Path() ) );
 
-                    wxString ref_candidate = buildFullReference( componentFlatList[ii], thisRef.m_Unit );
+                if( instance == instances.end() )
+                    continue;
 
-                    // propagate the new reference and unit selection to the "old" component,
-                    // if this new full reference is not already used (can happens when initial
-                    // multiunits components have duplicate references)
-                    if( inUseRefs.find( ref_candidate ) == inUseRefs.end() )
-                    {
-                        componentFlatList[jj].m_NumRef = componentFlatList[ii].m_NumRef;
-                        componentFlatList[jj].m_Unit = thisRef.m_Unit;
-                        componentFlatList[jj].m_IsNew = false;
-                        componentFlatList[jj].m_Flag = 1;
-                        // lock this new full reference
-                        inUseRefs.insert( ref_candidate );
-                        break;
-                    }
+                const std::vector<size_t>& matches = instance->second;
+                auto match = std::upper_bound( matches.begin(), matches.end(), (size_t) ii );
+
+                if( match == matches.end() )
+                    continue;
+
+                size_t jj = *match;
+
+                wxString ref_candidate = buildFullReference( componentFlatList[ii], thisRef.m_Unit );
+
+                // propagate the new reference and unit selection to the "old" component,
+                // if this new full reference is not already used (can happens when initial
+                // multiunits components have duplicate references)
+                if( inUseRefs.find( ref_candidate ) == inUseRefs.end() )
+                {
+                    removeFromIndex( jj );
+                    componentFlatList[jj].m_NumRef = componentFlatList[ii].m_NumRef;
+                    componentFlatList[jj].m_Unit = thisRef.m_Unit;
+                    componentFlatList[jj].m_IsNew = false;
+                    componentFlatList[jj].m_Flag = 1;
+                    addToIndex( jj );
+                    // lock this new full reference
+                    inUseRefs.insert( ref_candidate );
                 }
             }
         }
@@ -478,29 +596,44 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             * we search for others parts that have the same value and the same
             * reference prefix (ref without ref number)
             */
+            UNIT_GROUP* group = NULL;
+
             for( Unit = 1; Unit <= NumberOfUnits; Unit++ )
             {
                 if( componentFlatList[ii].m_Unit == Unit )
                     continue;
 
-                int found = FindUnit( ii, Unit );
-
-                if( found >= 0 )
+                if( isUnitInUse( ii, Unit ) )
                     continue; // this unit exists for this reference (unit already annotated)
 
-                // Search a component to annotate ( same prefix, same value, not annotated)
-                for( unsigned jj = ii + 1; jj < componentFlatList.size(); jj++ )
+                if( !group )
                 {
-                    if( componentFlatList[jj].m_Flag )    // already tested
-                        continue;
+                    auto it = unitGroups.find( unitGroupKey( ii ) );
 
-                    if( componentFlatList[ii].CompareRef( componentFlatList[jj] ) != 0 )
-                        continue;
+                    if( it == unitGroups.end() )
+                        break;
 
-                    if( componentFlatList[jj].CompareValue( componentFlatList[ii] ) != 0 )
-                        continue;
+                    group = &it->second;
+                }
+
+                // Search a component to annotate ( same prefix, same value, not annotated)
+                // The components before ii, already tested or already annotated can never
+                // be used again.
+                std::vector<size_t>& items = group->m_Items;
+
+                while( group->m_First < items.size()
+                    && ( items[group->m_First] <= ii
+                      || componentFlatList[items[group->m_First]].m_Flag
+                      || !componentFlatList[items[group->m_First]].m_IsNew ) )
+                {
+                    group->m_First++;
+                }
 
-                    if( componentFlatList[jj].CompareLibName( componentFlatList[ii] ) != 0 )
+                for( size_t kk = group->m_First; kk < items.size(); kk++ )
+                {
+                    size_t jj = items[kk];
+
+                    if( componentFlatList[jj].m_Flag )    // already tested
                         continue;
 
                     if( !componentFlatList[jj].m_IsNew )
@@ -510,10 +643,12 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     if( !componentFlatList[jj].IsUnitsLocked()
                         || ( componentFlatList[jj].m_Unit == Unit ) )
                     {
+                        removeFromIndex( jj );
                         componentFlatList[jj].m_NumRef = componentFlatList[ii].m_NumRef;
                         componentFlatList[jj].m_Unit   = Unit;
                         componentFlatList[jj].m_Flag   = 1;
                         componentFlatList[jj].m_IsNew  = false;
+                        addToIndex( jj );
                         break;
                     }
                 }
@@ -43,6 +43,11 @@
 
 #include <wx/ffile.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
 
 /* ERC tests :
  *  1 - conflicts between connected pins ( example: 2 connected outputs )
@@ -427,159 +432,300 @@ void Diagnose( NETLIST_OBJECT* aNetItemRef, NETLIST_OBJECT* aNetItemTst,
 }
 
 
-void TestOthersItems( NETLIST_OBJECT_LIST* aList,
-                      unsigned aNetItemRef, unsigned aNetStart,
-                      int* aMinConnexion )
+/**
+ * An ERC problem found while testing a net.  The problems are stored while the nets are
+ * tested concurrently, and the markers are created afterwards in the net list order.
+ */
+struct ERC_NET_DIAG
+{
+    unsigned        m_Item;             // index of the item in the net list
+    NETLIST_OBJECT* m_Other;
+    int             m_MinConn;
+    int             m_Diag;
+    bool            m_DifferentUnitNet; // a shared pin connected to another net
+};
+
+
+static void DiagnoseDifferentUnitNet( NETLIST_OBJECT* aItem, const wxString& aRef,
+                                      const wxString& aFirstNetName, const wxString& aNetName )
+{
+    SCH_MARKER* marker = new SCH_MARKER();
+
+    marker->SetTimeStamp( GetNewTimeStamp() );
+    marker->SetData( ERCE_DIFFERENT_UNIT_NET, aItem->m_Start,
+        wxString::Format( _( "Pin %s on %s is connected to both %s and %s" ),
+        aItem->m_PinNum, aRef, aFirstNetName, aNetName ),
+        aItem->m_Start );
+    marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
+    marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_ERROR );
+
+    aItem->m_SheetPath.LastScreen()->Append( marker );
+}
+
+
+void TestNets( NETLIST_OBJECT_LIST* aList, bool aTestGlobalLabels )
 {
-    unsigned netItemTst = aNetStart;
-    ELECTRICAL_PINTYPE jj;
-    int erc = OK;
+    const unsigned count = aList->size();
+
+    // Component references of the pins, and whether a pin shares its net with another
+    // item.  GetRef() can update the component, so references are read before the nets
+    // are tested.
+    std::vector<wxString> refs( count );
+    std::vector<bool>     isConnected( count, false );
+
+    // Pins that have appeared before on a different net, with the name of that net.
+    // Multi-unit components that have shared pins can be wired to different nets.
+    std::unordered_map<wxString, wxString>    pin_to_net_map;
+    std::vector<const wxString*>              otherNetNames( count, nullptr );
+    std::vector<wxString>                     netNames( count );
 
-    /* Analysis of the table of connections. */
-    ELECTRICAL_PINTYPE ref_elect_type = aList->GetItem( aNetItemRef )->m_ElectricalPinType;
-    int local_minconn = NOC;
+    // Number of instances of a given pin (pin number, then reference) which are connected.
+    std::unordered_map<wxString, std::unordered_map<wxString, int> > connectedPins;
 
-    if( ref_elect_type == PIN_NC )
-        local_minconn = NPI;
+    // First item of each net; the list is sorted by net code.
+    std::vector<unsigned> netStarts;
 
-    /* Test pins connected to NetItemRef */
-    for( ; ; netItemTst++ )
+    for( unsigned ii = 0; ii < count; ii++ )
     {
-        if( aNetItemRef == netItemTst )
-            continue;
+        NETLIST_OBJECT* item = aList->GetItem( ii );
 
-        // We examine only a given net. We stop the search if the net changes
-        if( ( netItemTst >= aList->size() ) // End of list
-            || ( aList->GetItemNet( aNetItemRef ) !=
-                 aList->GetItemNet( netItemTst ) ) ) // End of net
+        if( ii == 0 || aList->GetItemNet( ii - 1 ) != item->GetNet() )
         {
-            /* End net code found: minimum connection test. */
-            if( ( *aMinConnexion < NET_NC ) && ( local_minconn < NET_NC ) )
-            {
-                /* Not connected or not driven pin. */
-                bool seterr = true;
+            wxASSERT_MSG( ii == 0 || aList->GetItemNet( ii - 1 ) < item->GetNet(),
+                          wxT( "Netlist not correctly ordered" ) );
+            netStarts.push_back( ii );
+        }
 
-                if( local_minconn == NOC &&
-                    aList->GetItemType( aNetItemRef ) == NET_PIN )
-                {
-                    /* This pin is not connected: for multiple part per
-                     * package, and duplicated pin,
-                     * search for another instance of this pin
-                     * this will be flagged only if all instances of this pin
-                     * are not connected
-                     * TODO test also if instances connected are connected to
-                     * the same net
-                     */
-                    for( unsigned duplicate = 0; duplicate < aList->size(); duplicate++ )
-                    {
-                        if( aList->GetItemType( duplicate ) != NET_PIN )
-                            continue;
-
-                        if( duplicate == aNetItemRef )
-                            continue;
-
-                        if( aList->GetItem( aNetItemRef )->m_PinNum !=
-                            aList->GetItem( duplicate )->m_PinNum )
-                            continue;
-
-                        if( ( (SCH_COMPONENT*) aList->GetItem( aNetItemRef )->
-                             m_Link )->GetRef( &aList->GetItem( aNetItemRef )-> m_SheetPath ) !=
-                            ( (SCH_COMPONENT*) aList->GetItem( duplicate )->m_Link )
-                           ->GetRef( &aList->GetItem( duplicate )->m_SheetPath ) )
-                            continue;
-
-                        // Same component and same pin. Do dot create error for this pin
-                        // if the other pin is connected (i.e. if duplicate net has another
-                        // item)
-                        if( (duplicate > 0)
-                          && ( aList->GetItemNet( duplicate ) ==
-                               aList->GetItemNet( duplicate - 1 ) ) )
-                            seterr = false;
-
-                        if( (duplicate < aList->size() - 1)
-                          && ( aList->GetItemNet( duplicate ) ==
-                               aList->GetItemNet( duplicate + 1 ) ) )
-                            seterr = false;
-                    }
-                }
+        isConnected[ii] = ( ii > 0 && aList->GetItemNet( ii - 1 ) == item->GetNet() )
+                          || ( ii < count - 1 && aList->GetItemNet( ii + 1 ) == item->GetNet() );
+
+        if( item->m_Type != NET_PIN || !item->m_Link )
+            continue;
+
+        refs[ii] = item->GetComponentParent()->GetRef( &item->m_SheetPath );
+        netNames[ii] = item->GetNetName();
+
+        wxString pin_name = refs[ii] + "_" + item->m_PinNum;
+        auto     it = pin_to_net_map.find( pin_name );
+
+        if( it == pin_to_net_map.end() )
+            pin_to_net_map[pin_name] = netNames[ii];
+        else if( it->second != netNames[ii] )
+            otherNetNames[ii] = &it->second;
+
+        if( isConnected[ii] )
+            connectedPins[item->m_PinNum][refs[ii]]++;
+    }
+
+    netStarts.push_back( count );
+
+    // An unconnected pin is flagged only if all the other instances of this pin (multiple
+    // parts per package, or duplicated pins) are unconnected as well.
+    // TODO test also if instances connected are connected to the same net
+    auto otherInstanceConnected = [&]( unsigned aPin ) -> bool
+    {
+        NETLIST_OBJECT* pin = aList->GetItem( aPin );
+        auto            byNum = connectedPins.find( pin->m_PinNum );
+
+        if( byNum == connectedPins.end() )
+            return false;
 
-                if( seterr )
-                    Diagnose( aList->GetItem( aNetItemRef ), NULL, local_minconn, WAR );
+        auto byRef = byNum->second.find( refs[aPin] );
 
-                *aMinConnexion = DRV;   // inhibiting other messages of this
-                                       // type for the net.
+        if( byRef == byNum->second.end() )
+            return false;
+
+        return byRef->second > ( isConnected[aPin] ? 1 : 0 );
+    };
+
+    std::vector< std::vector<ERC_NET_DIAG> > diags( netStarts.size() - 1 );
+
+    // Evaluate a net in a single pass: the pin type histogram of the net gives the minimal
+    // connection of each pin against MinimalReq, and the next pin of each type gives the
+    // first conflict of each pin against DiagErc.
+    auto testNet = [&]( size_t aNet )
+    {
+        const unsigned netStart = netStarts[aNet];
+        const unsigned netEnd = netStarts[aNet + 1];
+        std::vector<ERC_NET_DIAG>& netDiags = diags[aNet];
+
+        int pinTypeCount[PINTYPE_COUNT] = { 0 };
+        int pinCount = 0;
+        int noConnectCount = 0;
+        std::vector<unsigned> pinsByType[PINTYPE_COUNT];
+        size_t nextPinOfType[PINTYPE_COUNT] = { 0 };
+
+        for( unsigned ii = netStart; ii < netEnd; ii++ )
+        {
+            NETLIST_OBJECT* item = aList->GetItem( ii );
+
+            if( item->m_Type == NET_NOCONNECT )
+            {
+                noConnectCount++;
+            }
+            else if( item->m_Type == NET_PIN )
+            {
+                pinCount++;
+                pinTypeCount[item->m_ElectricalPinType]++;
+                pinsByType[item->m_ElectricalPinType].push_back( ii );
             }
-            return;
         }
 
-        switch( aList->GetItemType( netItemTst ) )
+        auto addDiag = [&]( unsigned aItem, NETLIST_OBJECT* aOther, int aMinConn, int aDiag,
+                            bool aDifferentUnitNet = false )
         {
-        case NET_ITEM_UNSPECIFIED:
-        case NET_SEGMENT:
-        case NET_BUS:
-        case NET_JUNCTION:
-        case NET_LABEL:
-        case NET_HIERLABEL:
-        case NET_BUSLABELMEMBER:
-        case NET_HIERBUSLABELMEMBER:
-        case NET_SHEETBUSLABELMEMBER:
-        case NET_SHEETLABEL:
-        case NET_GLOBLABEL:
-        case NET_GLOBBUSLABELMEMBER:
-        case NET_PINLABEL:
-            break;
+            ERC_NET_DIAG diag = { aItem, aOther, aMinConn, aDiag, aDifferentUnitNet };
+            netDiags.push_back( diag );
+        };
 
-        case NET_NOCONNECT:
-            local_minconn = std::max( NET_NC, local_minconn );
-            break;
+        int minConn = NOC;
+
+        for( unsigned ii = netStart; ii < netEnd; ii++ )
+        {
+            NETLIST_OBJECT* item = aList->GetItem( ii );
+
+            switch( item->m_Type )
+            {
+            // These items do not create erc problems
+            case NET_ITEM_UNSPECIFIED:
+            case NET_SEGMENT:
+            case NET_BUS:
+            case NET_JUNCTION:
+            case NET_LABEL:
+            case NET_BUSLABELMEMBER:
+            case NET_PINLABEL:
+            case NET_GLOBBUSLABELMEMBER:
+                break;
+
+            case NET_HIERLABEL:
+            case NET_HIERBUSLABELMEMBER:
+            case NET_SHEETLABEL:
+            case NET_SHEETBUSLABELMEMBER:
+                // ERC problems when pin sheets do not match hierarchical labels.
+                // Each pin sheet must match a hierarchical label
+                // Each hierarchical label must match a pin sheet
+                if( aList->IsOrphanLabel( ii, netStart ) )
+                    addDiag( ii, NULL, -1, WAR );
+
+                break;
+
+            case NET_GLOBLABEL:
+                if( aTestGlobalLabels && aList->IsOrphanLabel( ii, netStart ) )
+                    addDiag( ii, NULL, -1, WAR );
+
+                break;
+
+            case NET_NOCONNECT:
+                // ERC problems when a noconnect symbol is connected to more than one pin.
+                minConn = NET_NC;
 
-        case NET_PIN:
-            jj = aList->GetItem( netItemTst )->m_ElectricalPinType;
-            local_minconn = std::max( MinimalReq[ref_elect_type][jj], local_minconn );
+                if( pinCount > 1 )
+                    addDiag( ii, NULL, minConn, UNC );
 
-            if( netItemTst <= aNetItemRef )
                 break;
 
-            if( erc == OK )
+            case NET_PIN:
             {
-                erc = DiagErc[ref_elect_type][jj];
+                if( otherNetNames[ii] )
+                    addDiag( ii, NULL, 0, ERR, true );
 
-                if( erc != OK )
+                ELECTRICAL_PINTYPE refType = item->m_ElectricalPinType;
+                int localMinConn = ( refType == PIN_NC ) ? NPI : NOC;
+
+                if( noConnectCount )
+                    localMinConn = std::max( NET_NC, localMinConn );
+
+                // Conflicts are reported against the first following pin of the net which
+                // is in conflict with this one, if it was not already reported.
+                unsigned conflict = netEnd;
+
+                for( int jj = 0; jj < PINTYPE_COUNT; jj++ )
                 {
-                    if( aList->GetConnectionType( netItemTst ) == UNCONNECTED )
-                    {
-                        Diagnose( aList->GetItem( aNetItemRef ),
-                                  aList->GetItem( netItemTst ),
-                                  0, erc );
-                        aList->SetConnectionType( netItemTst, NOCONNECT_SYMBOL_PRESENT );
-                    }
+                    // The pin itself is not compared to the others.
+                    int others = pinTypeCount[jj] - ( jj == refType ? 1 : 0 );
+
+                    if( others > 0 )
+                        localMinConn = std::max( MinimalReq[refType][jj], localMinConn );
+
+                    std::vector<unsigned>& pins = pinsByType[jj];
+                    size_t& next = nextPinOfType[jj];
+
+                    while( next < pins.size() && pins[next] <= ii )
+                        next++;
+
+                    if( next < pins.size() && DiagErc[refType][jj] != OK )
+                        conflict = std::min( conflict, pins[next] );
                 }
-            }
 
-            break;
+                if( conflict != netEnd && aList->GetConnectionType( conflict ) == UNCONNECTED )
+                {
+                    NETLIST_OBJECT* other = aList->GetItem( conflict );
+
+                    addDiag( ii, other, 0, DiagErc[refType][other->m_ElectricalPinType] );
+                    aList->SetConnectionType( conflict, NOCONNECT_SYMBOL_PRESENT );
+                }
+
+                // Minimum connection test.
+                if( ( minConn < NET_NC ) && ( localMinConn < NET_NC ) )
+                {
+                    // Not connected or not driven pin.
+                    if( localMinConn != NOC || !otherInstanceConnected( ii ) )
+                        addDiag( ii, NULL, localMinConn, WAR );
+
+                    minConn = DRV;  // inhibiting other messages of this type for the net.
+                }
+
+                break;
+            }
+            }
         }
-    }
-}
+    };
 
-int NETLIST_OBJECT_LIST::CountPinsInNet( unsigned aNetStart )
-{
-    int count = 0;
-    int curr_net = GetItemNet( aNetStart );
+    // Threads are only worth starting for large schematics.
+    const size_t parallelThreshold = 1000;
+    const size_t netCount = diags.size();
 
-    /* Test pins connected to NetItemRef */
-    for( unsigned item = aNetStart; item < size(); item++ )
+    if( count < parallelThreshold || netCount < 2 )
     {
-        // We examine only a given net. We stop the search if the net changes
-        if( curr_net != GetItemNet( item ) )   // End of net
-            break;
+        for( size_t ii = 0; ii < netCount; ii++ )
+            testNet( ii );
+    }
+    else
+    {
+        std::atomic<size_t>      nextNet( 0 );
+        std::vector<std::thread> workers;
+        size_t parallelThreadCount = std::min<size_t>( netCount,
+                std::max<size_t>( std::thread::hardware_concurrency(), 2 ) );
 
-        if( GetItemType( item ) == NET_PIN )
-            count++;
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        {
+            workers.push_back( std::thread( [&]()
+            {
+                for( size_t i = nextNet.fetch_add( 1 ); i < netCount; i = nextNet.fetch_add( 1 ) )
+                    testNet( i );
+            } ) );
+        }
+
+        for( auto& worker : workers )
+            worker.join();
     }
 
-    return count;
+    for( const std::vector<ERC_NET_DIAG>& netDiags : diags )
+    {
+        for( const ERC_NET_DIAG& diag : netDiags )
+        {
+            NETLIST_OBJECT* item = aList->GetItem( diag.m_Item );
+
+            if( diag.m_DifferentUnitNet )
+                DiagnoseDifferentUnitNet( item, refs[diag.m_Item], *otherNetNames[diag.m_Item],
+                                          netNames[diag.m_Item] );
+            else
+                Diagnose( item, diag.m_Other, diag.m_MinConn, diag.m_Diag );
+        }
+    }
 }
 
+
 bool WriteDiagnosticERC( EDA_UNITS_T aUnits, const wxString& aFullFileName )
 {
     wxString    msg;
@@ -639,38 +785,27 @@ bool WriteDiagnosticERC( EDA_UNITS_T aUnits, const wxString& aFullFileName )
 }
 
 
-void NETLIST_OBJECT_LIST::TestforNonOrphanLabel( unsigned aNetItemRef, unsigned aStartNet )
+bool NETLIST_OBJECT_LIST::IsOrphanLabel( unsigned aNetItemRef, unsigned aStartNet )
 {
-    unsigned netItemTst = aStartNet;
-    int      erc = 1;
-
     // Review the list of labels connected to NetItemRef:
-    for( ; ; netItemTst++ )
+    for( unsigned netItemTst = aStartNet; netItemTst < size(); netItemTst++ )
     {
-        if( netItemTst == aNetItemRef )
-            continue;
-
         /* Is always in the same net? */
-        if( ( netItemTst == size() )
-          || ( GetItemNet( aNetItemRef ) != GetItemNet( netItemTst ) ) )
-        {
-            /* End Netcode found. */
-            if( erc )
-            {
-                /* Glabel or SheetLabel orphaned. */
-                Diagnose( GetItem( aNetItemRef ), NULL, -1, WAR );
-            }
+        if( GetItemNet( aNetItemRef ) != GetItemNet( netItemTst ) )
+            break;
 
-            return;
-        }
+        if( netItemTst == aNetItemRef )
+            continue;
 
         if( GetItem( aNetItemRef )->IsLabelConnected( GetItem( netItemTst ) ) )
-            erc = 0;
+            return false;
 
         //same thing, different order.
         if( GetItem( netItemTst )->IsLabelConnected( GetItem( aNetItemRef ) ) )
-            erc = 0;
+            return false;
     }
+
+    return true;
 }
 
 
@@ -678,38 +813,15 @@ void NETLIST_OBJECT_LIST::TestforNonOrphanLabel( unsigned aNetItemRef, unsigned
 // when they are compared using case insensitive coparisons.
 
 
-// A helper struct to compare NETLIST_OBJECT items by sheetpath and label texts
-// for a std::set<NETLIST_OBJECT*> container
-// the full text is "sheetpath+label" for local labels and "label" for global labels
-struct compare_labels
+// A label with its sheet path computed once.
+struct ERC_LABEL
 {
-    bool operator() ( const NETLIST_OBJECT* lab1, const NETLIST_OBJECT* lab2 )
-    {
-        wxString str1 = lab1->m_SheetPath.Path() + lab1->m_Label;
-        wxString str2 = lab2->m_SheetPath.Path() + lab2->m_Label;
-
-        return str1.Cmp( str2 ) < 0;
-    }
+    NETLIST_OBJECT* m_Item;
+    wxString        m_Path;
 };
 
-struct compare_label_names
-{
-    bool operator() ( const NETLIST_OBJECT* lab1, const NETLIST_OBJECT* lab2 )
-    {
-        return lab1->m_Label.Cmp( lab2->m_Label ) < 0;
-    }
-};
-
-struct compare_paths
-{
-    bool operator() ( const NETLIST_OBJECT* lab1, const NETLIST_OBJECT* lab2 )
-    {
-        return lab1->m_SheetPath.Path().Cmp( lab2->m_SheetPath.Path() ) < 0;
-    }
-};
 
-// Helper functions to build the warning messages about Similar Labels:
-static int countIndenticalLabels( std::vector<NETLIST_OBJECT*>& aList, NETLIST_OBJECT* aLabel );
+// Helper function: creates a marker for similar labels ERC warning
 static void SimilarLabelsDiagnose( NETLIST_OBJECT* aItemA, NETLIST_OBJECT* aItemB );
 
 
@@ -718,11 +830,15 @@ void NETLIST_OBJECT_LIST::TestforSimilarLabels()
     // Similar labels which are different when using case sensitive comparisons
     // but are equal when using case insensitive comparisons
 
-    // list of all labels (used the better item to build diag messages)
-    std::vector<NETLIST_OBJECT*> fullLabelList;
-    // list of all labels , each label appears only once (used to to detect similar labels)
-    std::set<NETLIST_OBJECT*, compare_labels> uniqueLabelList;
-    wxString msg;
+    // Number of identical labels, used to choose the better item to build diag messages:
+    //  for global label: global labels in the full project
+    //  for local label: all labels in the current sheet
+    std::unordered_map<wxString, int> globalLabelCount;
+    std::unordered_map<wxString, std::unordered_map<wxString, int> > sheetLabelCount;
+
+    // list of all labels, each label appears only once (used to to detect similar labels),
+    // keyed by the full text "sheetpath+label".
+    std::unordered_map<wxString, ERC_LABEL> uniqueLabels;
 
     // Build a list of differents labels. If inside a given sheet there are
     // more than one given label, only one label is stored.
@@ -741,10 +857,18 @@ void NETLIST_OBJECT_LIST::TestforSimilarLabels()
         case NET_HIERLABEL:
         case NET_HIERBUSLABELMEMBER:
         case NET_GLOBLABEL:
+        {
             // add this label in lists
-            uniqueLabelList.insert( GetItem( netItem ) );
-            fullLabelList.push_back( GetItem( netItem ) );
+            ERC_LABEL label = { GetItem( netItem ), GetItem( netItem )->m_SheetPath.Path() };
+
+            uniqueLabels.insert( std::make_pair( label.m_Path + label.m_Item->m_Label, label ) );
+
+            if( label.m_Item->IsLabelGlobal() )
+                globalLabelCount[label.m_Item->m_Label]++;
+
+            sheetLabelCount[label.m_Path][label.m_Item->m_Label]++;
             break;
+        }
 
         case NET_SHEETLABEL:
         case NET_SHEETBUSLABELMEMBER:
@@ -753,121 +877,118 @@ void NETLIST_OBJECT_LIST::TestforSimilarLabels()
         }
     }
 
-    // build global labels and compare
-    std::set<NETLIST_OBJECT*, compare_label_names> loc_labelList;
-    std::set<NETLIST_OBJECT*>::const_iterator it;
-
-    for( it = uniqueLabelList.begin(); it != uniqueLabelList.end(); ++it )
+    auto countIdenticalLabels = [&]( const ERC_LABEL& aLabel ) -> int
     {
-        if( (*it)->IsLabelGlobal() )
-            loc_labelList.insert( *it );
-    }
-
-    // compare global labels (same label names appears only once in list)
-    for( it = loc_labelList.begin(); it != loc_labelList.end(); ++it )
+        if( aLabel.m_Item->IsLabelGlobal() )
+            return globalLabelCount[aLabel.m_Item->m_Label];
+
+        return sheetLabelCount[aLabel.m_Path][aLabel.m_Item->m_Label];
+    };
+
+    std::vector<std::pair<wxString, ERC_LABEL> > labels( uniqueLabels.begin(),
+                                                         uniqueLabels.end() );
+
+    std::sort( labels.begin(), labels.end(),
+               []( const std::pair<wxString, ERC_LABEL>& a,
+                   const std::pair<wxString, ERC_LABEL>& b )
+               {
+                   return a.first.Cmp( b.first ) < 0;
+               } );
+
+    // Report the labels of aList (sorted by label name, same label names appear only once)
+    // which are equal when using case insensitive comparisons.  Such labels are found by
+    // hashing their lower case names.
+    auto testSimilarLabels = [&]( const std::vector<const ERC_LABEL*>& aList, bool aGlobal )
     {
-        std::set<NETLIST_OBJECT*>::const_iterator it_aux = it;
+        std::unordered_map<wxString, std::vector<size_t> > similar;
 
-        for( ++it_aux; it_aux != loc_labelList.end(); ++it_aux )
+        for( size_t ii = 0; ii < aList.size(); ++ii )
+            similar[aList[ii]->m_Item->m_Label.Lower()].push_back( ii );
+
+        for( size_t ii = 0; ii < aList.size(); ++ii )
         {
-            if( (*it)->m_Label.CmpNoCase( (*it_aux)->m_Label ) == 0 )
+            const ERC_LABEL*           ref = aList[ii];
+            const std::vector<size_t>& group = similar[ref->m_Item->m_Label.Lower()];
+
+            for( size_t jj : group )
             {
+                if( jj <= ii )
+                    continue;
+
+                const ERC_LABEL* tst = aList[jj];
+
+                // global label versus global label was already examined.
+                // here, at least one label must be local
+                if( !aGlobal && ref->m_Item->IsLabelGlobal() && tst->m_Item->IsLabelGlobal() )
+                    continue;
+
                 // Create new marker for ERC.
-                int cntA = countIndenticalLabels( fullLabelList, *it );
-                int cntB = countIndenticalLabels( fullLabelList, *it_aux );
+                int cntA = countIdenticalLabels( *ref );
+                int cntB = countIdenticalLabels( *tst );
 
                 if( cntA <= cntB )
-                    SimilarLabelsDiagnose( (*it), (*it_aux) );
+                    SimilarLabelsDiagnose( ref->m_Item, tst->m_Item );
                 else
-                    SimilarLabelsDiagnose( (*it_aux), (*it) );
+                    SimilarLabelsDiagnose( tst->m_Item, ref->m_Item );
             }
         }
-    }
-
-    // Build paths list
-    std::set<NETLIST_OBJECT*, compare_paths> pathsList;
-
-    for( it = uniqueLabelList.begin(); it != uniqueLabelList.end(); ++it )
-        pathsList.insert( *it );
+    };
 
-    // Examine each label inside a sheet path:
-    for( it = pathsList.begin(); it != pathsList.end(); ++it )
+    // Keep the first label of each name, and sort them by name.
+    auto uniqueNames = []( std::vector<const ERC_LABEL*>& aList )
     {
-        loc_labelList.clear();
-
-        std::set<NETLIST_OBJECT*>::const_iterator it_aux = uniqueLabelList.begin();
-
-        for( ; it_aux != uniqueLabelList.end(); ++it_aux )
-        {
-            if( (*it)->m_SheetPath.Path() == (*it_aux)->m_SheetPath.Path() )
-                loc_labelList.insert( *it_aux );
-        }
-
-        // at this point, loc_labelList contains labels of the current sheet path.
-        // Detect similar labels (same label names appears only once in list)
-        std::set<NETLIST_OBJECT*>::const_iterator ref_it;
+        std::stable_sort( aList.begin(), aList.end(),
+                          []( const ERC_LABEL* a, const ERC_LABEL* b )
+                          {
+                              return a->m_Item->m_Label.Cmp( b->m_Item->m_Label ) < 0;
+                          } );
+
+        aList.erase( std::unique( aList.begin(), aList.end(),
+                                  []( const ERC_LABEL* a, const ERC_LABEL* b )
+                                  {
+                                      return a->m_Item->m_Label == b->m_Item->m_Label;
+                                  } ),
+                     aList.end() );
+    };
+
+    // compare global labels
+    std::vector<const ERC_LABEL*> globalLabels;
+    std::unordered_map<wxString, std::vector<const ERC_LABEL*> > sheetLabels;
+    std::vector<wxString> paths;
+
+    for( const std::pair<wxString, ERC_LABEL>& label : labels )
+    {
+        if( label.second.m_Item->IsLabelGlobal() )
+            globalLabels.push_back( &label.second );
 
-        for( ref_it = loc_labelList.begin(); ref_it != loc_labelList.end(); ++ref_it )
-        {
-            NETLIST_OBJECT* ref_item = *ref_it;
-            it_aux = ref_it;
+        std::vector<const ERC_LABEL*>& sheet = sheetLabels[label.second.m_Path];
 
-            for( ++it_aux; it_aux != loc_labelList.end(); ++it_aux )
-            {
-                // global label versus global label was already examined.
-                // here, at least one label must be local
-                if( ref_item->IsLabelGlobal() && (*it_aux)->IsLabelGlobal() )
-                    continue;
+        if( sheet.empty() )
+            paths.push_back( label.second.m_Path );
 
-                if( ref_item->m_Label.CmpNoCase( (*it_aux)->m_Label ) == 0 )
-                {
-                    // Create new marker for ERC.
-                    int cntA = countIndenticalLabels( fullLabelList, ref_item );
-                    int cntB = countIndenticalLabels( fullLabelList, *it_aux );
-
-                    if( cntA <= cntB )
-                        SimilarLabelsDiagnose( ref_item, (*it_aux) );
-                    else
-                        SimilarLabelsDiagnose( (*it_aux), ref_item );
-                }
-            }
-        }
+        sheet.push_back( &label.second );
     }
-}
 
-// Helper function: count the number of labels identical to aLabel
-//  for global label: global labels in the full project
-//  for local label: all labels in the current sheet
-static int countIndenticalLabels( std::vector<NETLIST_OBJECT*>& aList, NETLIST_OBJECT* aLabel )
-{
-    int count = 0;
+    uniqueNames( globalLabels );
+    testSimilarLabels( globalLabels, true );
 
-    if( aLabel->IsLabelGlobal() )
-    {
-        for( unsigned netItem = 0; netItem < aList.size(); ++netItem )
-        {
-            NETLIST_OBJECT* item = aList[netItem];
+    // Examine each label inside a sheet path:
+    std::sort( paths.begin(), paths.end(),
+               []( const wxString& a, const wxString& b )
+               {
+                   return a.Cmp( b ) < 0;
+               } );
 
-            if( item->IsLabelGlobal() && item->m_Label == aLabel->m_Label )
-                count++;
-        }
-    }
-    else
+    for( const wxString& path : paths )
     {
-        for( unsigned netItem = 0; netItem < aList.size(); ++netItem )
-        {
-            NETLIST_OBJECT* item = aList[netItem];
+        std::vector<const ERC_LABEL*>& sheet = sheetLabels[path];
 
-            if( item->m_Label == aLabel->m_Label &&
-                item->m_SheetPath.Path() == aLabel->m_SheetPath.Path() )
-                count++;
-        }
+        uniqueNames( sheet );
+        testSimilarLabels( sheet, false );
     }
-
-    return count;
 }
 
-// Helper function: creates a marker for similar labels ERC warning
+
 static void SimilarLabelsDiagnose( NETLIST_OBJECT* aItemA, NETLIST_OBJECT* aItemB )
 {
     // Create new marker for ERC.
@@ -90,17 +90,16 @@ void Diagnose( NETLIST_OBJECT* NetItemRef, NETLIST_OBJECT* NetItemTst,
                       int MinConnexion, int Diag );
 
 /**
- * Perform ERC testing for electrical conflicts between \a NetItemRef and other items
- * (mainly pin) on the same net.
- * @param aList = a reference to the list of connected objects
- * @param aNetItemRef = index in list of the current object
- * @param aNetStart = index in list of net objects of the first item
- * @param aMinConnexion = a pointer to a variable to store the minimal connection
- * found( NOD, DRV, NPI, NET_NC)
+ * Perform ERC testing of the nets of \a aList: electrical conflicts between pins, minimal
+ * connection requirements, no connect symbols connected to more than one pin, orphan
+ * labels and shared pins of multi-unit components connected to different nets.
+ * Each net is evaluated in a single pass, nets are tested concurrently and the markers
+ * are created afterwards in the net list order.
+ * @param aList = the list of connected objects, sorted by net code
+ * @param aTestGlobalLabels = true to test that global labels are connected to another
+ * global label
  */
-void TestOthersItems( NETLIST_OBJECT_LIST* aList,
-                             unsigned aNetItemRef, unsigned aNetStart,
-                             int* aMinConnexion );
+void TestNets( NETLIST_OBJECT_LIST* aList, bool aTestGlobalLabels );
 
 /**
  * Function TestDuplicateSheetNames( )
@@ -51,8 +51,8 @@ bool SCH_EDIT_FRAME::HighlightConnectionAtPosition( wxPoint aPosition )
             wxMessageBox( _( "Error: duplicate sub-sheet names found in current sheet. Fix it" ) );
         else
         {
-            // Build netlist info to get the proper netnames of connected items
-            std::unique_ptr<NETLIST_OBJECT_LIST> objectsConnectedList( BuildNetListBase() );
+            // Use the netlist info to get the proper netnames of connected items
+            NETLIST_OBJECT_LIST* objectsConnectedList = GetConnectedItems();
             buildNetlistOk = true;
 
             for( auto obj : *objectsConnectedList )
@@ -97,8 +97,8 @@ bool SCH_EDIT_FRAME::SetCurrentSheetHighlightFlags()
     if( TestDuplicateSheetNames( false ) > 0 )
         return false;
 
-    // Build netlist info to get the proper netnames
-    std::unique_ptr<NETLIST_OBJECT_LIST> objectsConnectedList( BuildNetListBase( false ) );
+    // Use the netlist info to get the proper netnames
+    NETLIST_OBJECT_LIST* objectsConnectedList = GetConnectedItems();
 
     // highlight the items belonging to this net
     for( auto obj1 : *objectsConnectedList )
@@ -28,14 +28,18 @@
  * @brief Net list generation code.
  */
 
+#include <algorithm>
+
 #include <fctsys.h>
 #include <kicad_string.h>
 #include <gestfich.h>
 #include <pgm_base.h>
 #include <sch_edit_frame.h>
+#include <sch_screen.h>
 #include <reporter.h>
 #include <confirm.h>
 #include <kiway.h>
+#include <symbol_lib_table.h>
 
 #include <netlist.h>
 #include <netlist_exporter.h>
@@ -259,3 +263,39 @@ NETLIST_OBJECT_LIST* SCH_EDIT_FRAME::BuildNetListBase( bool updateStatusText )
     return ret.release();
 }
 
+
+NETLIST_OBJECT_LIST* SCH_EDIT_FRAME::GetConnectedItems()
+{
+    int      libHash = Prj().SchSymbolLibTable()->GetModifyHash();
+    unsigned modifySerial = 0;
+
+    // Not all the edit paths go through OnModify(), e.g. placing or deleting an item only
+    // calls SetModify() on its screen: the items of the list may have been moved or deleted.
+    // Deleting a sheet modifies its parent screen, so the screens left are enough to check.
+    SCH_SCREENS screens;
+
+    for( SCH_SCREEN* screen = screens.GetFirst(); screen; screen = screens.GetNext() )
+        modifySerial = std::max( modifySerial, screen->GetModifySerial() );
+
+    // Changing a symbol library can change the pins of the components.
+    if( m_connectedItems && ( m_connectedItemsLibHash != libHash
+                              || m_connectedItemsModifySerial != modifySerial ) )
+        InvalidateConnectedItems();
+
+    if( !m_connectedItems )
+    {
+        m_connectedItems = BuildNetListBase( false );
+        m_connectedItemsLibHash = libHash;
+        m_connectedItemsModifySerial = modifySerial;
+    }
+
+    return m_connectedItems;
+}
+
+
+void SCH_EDIT_FRAME::InvalidateConnectedItems()
+{
+    delete m_connectedItems;
+    m_connectedItems = NULL;
+}
+
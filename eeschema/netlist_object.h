@@ -32,6 +32,10 @@
 #define NETLIST_OBJECT_H
 
 
+#include <map>
+#include <unordered_map>
+#include <vector>
+
 #include <sch_sheet_path.h>
 #include <lib_pin.h>
 #include <sch_item_struct.h>
@@ -287,6 +291,22 @@ class NETLIST_OBJECT_LIST : public NETLIST_OBJECTS
     int m_lastBusNetCode;   // Used in intermediate calculation:
                             // last net code created for bus members
 
+    // Union-find forests of the net codes and bus net codes, used while building
+    // the connections: a net code merged in another one points to it (0 for a root)
+    std::vector<int> m_netCodeParent;
+    std::vector<int> m_busNetCodeParent;
+
+    // Indexes of the items of the sheet being connected (items are given by
+    // their index in list): items by end points, horizontal wires and buses
+    // by Y coordinate, vertical ones by X coordinate, and other wires and buses
+    std::unordered_map< long long, std::vector<unsigned> > m_pointIndex;
+    std::unordered_map< int, std::vector<unsigned> > m_hSegmentIndex;
+    std::unordered_map< int, std::vector<unsigned> > m_vSegmentIndex;
+    std::vector<unsigned> m_otherSegments;
+
+    // Labels of the whole list, by label text
+    std::map< wxString, std::vector<unsigned> > m_labelIndex;
+
 public:
     /**
      * Constructor.
@@ -378,22 +398,17 @@ public:
     void SortListbySheet();
 
     /**
-     * Counts number of pins connected on the same net.
-     * Used to count all pins connected to a no connect symbol
-     * @return the pin count of the net starting at aNetStart
-     * @param aNetStart = index in list of net objects of the first item
-     */
-    int CountPinsInNet( unsigned aNetStart );
-
-    /**
-     * Function TestforNonOrphanLabel
+     * Function IsOrphanLabel
      * Sheet labels are expected to be connected to a hierarchical label.
      * Hierarchical labels are expected to be connected to a sheet label.
      * Global labels are expected to be not orphan (connected to at least one
      * other global label.
      * This function tests the connection to another suitable label.
+     * @return true if the label at aNetItemRef is not connected to a suitable label
+     * @param aNetItemRef = index in list of the label
+     * @param aStartNet = index in list of net objects of the first item
      */
-    void TestforNonOrphanLabel( unsigned aNetItemRef, unsigned aStartNet );
+    bool IsOrphanLabel( unsigned aNetItemRef, unsigned aStartNet );
 
     /**
      * Function TestforSimilarLabels
@@ -419,10 +434,38 @@ private:
     /*
      * Propagate aNewNetCode to items having an internal netcode aOldNetCode
      * used to interconnect group of items already physically connected,
-     * when a new connection is found between aOldNetCode and aNewNetCode
+     * when a new connection is found between aOldNetCode and aNewNetCode.
+     * The items are not modified: aOldNetCode is merged in aNewNetCode and
+     * getNet() / getBusNet() return the merged net code of an item.
      */
     void propagateNetCode( int aOldNetCode, int aNewNetCode, bool aIsBus );
 
+    /*
+     * @return the net code (or bus net code) aNetCode was merged in
+     */
+    int findNetCode( int aNetCode, bool aIsBus );
+
+    int getNet( NETLIST_OBJECT* aItem )
+    {
+        return findNetCode( aItem->GetNet(), false );
+    }
+
+    int getBusNet( NETLIST_OBJECT* aItem )
+    {
+        return findNetCode( aItem->m_BusNetCode, true );
+    }
+
+    /*
+     * Store the merged net codes and bus net codes in items
+     */
+    void updateNetCodes();
+
+    /*
+     * Build the indexes of the items from aStart to aEnd - 1,
+     * which are the items of a sheet
+     */
+    void buildSheetIndex( unsigned aStart, unsigned aEnd );
+
     /*
      * This function merges the net codes of groups of objects already connected
      * to labels (wires, bus, pins ... ) when 2 labels are equivalents
@@ -450,16 +493,20 @@ private:
      */
     void sheetLabelConnect( NETLIST_OBJECT* aSheetLabel );
 
-    void pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus, int start );
+    /**
+     * Search the items of the current sheet having an end point at an end point
+     * of aRef, and propagate the aRef net code to them.
+     * The sheet index must be built (see buildSheetIndex)
+     */
+    void pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus );
 
     /**
      * Search connections between a junction and segments
      * Propagate the junction net code to objects connected by this junction.
      * The junction must have a valid net code
-     * The list of objects is expected sorted by sheets.
-     * Search is done from index aIdxStart to the last element of list
+     * Search is done in the segments of the current sheet index (see buildSheetIndex)
      */
-    void segmentToPointConnect( NETLIST_OBJECT* aJonction, bool aIsBus, int aIdxStart );
+    void segmentToPointConnect( NETLIST_OBJECT* aJonction, bool aIsBus );
 
 
     /**
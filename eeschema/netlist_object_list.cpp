@@ -43,6 +43,13 @@
 #define IS_WIRE false
 #define IS_BUS true
 
+
+// key of a point in the sheet index
+static inline long long pointKey( const wxPoint& aPoint )
+{
+    return (long long) ( ( (unsigned long long) (unsigned) aPoint.x << 32 ) | (unsigned) aPoint.y );
+}
+
 //#define NETLIST_DEBUG
 
 NETLIST_OBJECT_LIST::~NETLIST_OBJECT_LIST()
@@ -98,17 +105,25 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
     // Sort objects by Sheet
     SortListbySheet();
 
-    sheet = &(GetItem( 0 )->m_SheetPath);
+    sheet = NULL;
     m_lastNetCode = m_lastBusNetCode = 1;
+    m_netCodeParent.clear();
+    m_busNetCodeParent.clear();
 
-    for( unsigned ii = 0, istart = 0; ii < size(); ii++ )
+    for( unsigned ii = 0; ii < size(); ii++ )
     {
         NETLIST_OBJECT* net_item = GetItem( ii );
 
-        if( net_item->m_SheetPath != *sheet )   // Sheet change
+        if( !sheet || net_item->m_SheetPath != *sheet )   // Sheet change
         {
             sheet  = &(net_item->m_SheetPath);
-            istart = ii;
+
+            unsigned iend = ii + 1;
+
+            while( iend < size() && GetItem( iend )->m_SheetPath == *sheet )
+                iend++;
+
+            buildSheetIndex( ii, iend );
         }
 
         switch( net_item->m_Type )
@@ -132,7 +147,7 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
                 m_lastNetCode++;
             }
 
-            pointToPointConnect( net_item, IS_WIRE, istart );
+            pointToPointConnect( net_item, IS_WIRE );
             break;
 
         case NET_JUNCTION:
@@ -143,7 +158,7 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
                 m_lastNetCode++;
             }
 
-            segmentToPointConnect( net_item, IS_WIRE, istart );
+            segmentToPointConnect( net_item, IS_WIRE );
 
             // Control of the junction, on BUS.
             if( net_item->m_BusNetCode == 0 )
@@ -152,7 +167,7 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
                 m_lastBusNetCode++;
             }
 
-            segmentToPointConnect( net_item, IS_BUS, istart );
+            segmentToPointConnect( net_item, IS_BUS );
             break;
 
         case NET_LABEL:
@@ -165,7 +180,7 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
                 m_lastNetCode++;
             }
 
-            segmentToPointConnect( net_item, IS_WIRE, istart );
+            segmentToPointConnect( net_item, IS_WIRE );
             break;
 
         case NET_SHEETBUSLABELMEMBER:
@@ -180,7 +195,7 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
                 m_lastBusNetCode++;
             }
 
-            pointToPointConnect( net_item, IS_BUS, istart );
+            pointToPointConnect( net_item, IS_BUS );
             break;
 
         case NET_BUSLABELMEMBER:
@@ -193,16 +208,32 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
                 m_lastBusNetCode++;
             }
 
-            segmentToPointConnect( net_item, IS_BUS, istart );
+            segmentToPointConnect( net_item, IS_BUS );
             break;
         }
     }
 
+    m_pointIndex.clear();
+    m_hSegmentIndex.clear();
+    m_vSegmentIndex.clear();
+    m_otherSegments.clear();
+
+    updateNetCodes();
+
 #if defined(NETLIST_DEBUG) && defined(DEBUG)
     std::cout << "\n\nafter sheet local\n\n";
     DumpNetTable();
 #endif
 
+    // Index the labels by name, to connect them
+    m_labelIndex.clear();
+
+    for( unsigned ii = 0; ii < size(); ii++ )
+    {
+        if( GetItem( ii )->IsLabelType() )
+            m_labelIndex[ GetItem( ii )->m_Label ].push_back( ii );
+    }
+
     // Updating the Bus Labels Netcode connected by Bus
     connectBusLabels();
 
@@ -250,6 +281,9 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
             sheetLabelConnect( GetItem( ii ) );
     }
 
+    m_labelIndex.clear();
+    updateNetCodes();
+
     // Sort objects by NetCode
     SortListbyNetcode();
 
@@ -499,10 +533,16 @@ void NETLIST_OBJECT_LIST::findBestNetNameForEachNet()
 
 void NETLIST_OBJECT_LIST::sheetLabelConnect( NETLIST_OBJECT* SheetLabel )
 {
-    if( SheetLabel->GetNet() == 0 )
+    if( getNet( SheetLabel ) == 0 )
         return;
 
-    for( unsigned ii = 0; ii < size(); ii++ )
+    std::map< wxString, std::vector<unsigned> >::const_iterator labels =
+            m_labelIndex.find( SheetLabel->m_Label );
+
+    if( labels == m_labelIndex.end() )
+        return;     // no label with this name
+
+    for( unsigned ii : labels->second )
     {
         NETLIST_OBJECT* ObjetNet = GetItem( ii );
 
@@ -512,17 +552,14 @@ void NETLIST_OBJECT_LIST::sheetLabelConnect( NETLIST_OBJECT* SheetLabel )
         if( (ObjetNet->m_Type != NET_HIERLABEL ) && (ObjetNet->m_Type != NET_HIERBUSLABELMEMBER ) )
             continue;
 
-        if( ObjetNet->GetNet() == SheetLabel->GetNet() )
+        if( getNet( ObjetNet ) == getNet( SheetLabel ) )
             continue;  //already connected.
 
-        if( ObjetNet->m_Label != SheetLabel->m_Label )
-            continue;  //different names.
-
         // Propagate Netcode having all the objects of the same Netcode.
         if( ObjetNet->GetNet() )
-            propagateNetCode( ObjetNet->GetNet(), SheetLabel->GetNet(), IS_WIRE );
+            propagateNetCode( getNet( ObjetNet ), getNet( SheetLabel ), IS_WIRE );
         else
-            ObjetNet->SetNet( SheetLabel->GetNet() );
+            ObjetNet->SetNet( getNet( SheetLabel ) );
     }
 }
 
@@ -532,205 +569,271 @@ void NETLIST_OBJECT_LIST::connectBusLabels()
     // Propagate the net code between all bus label member objects connected by they name.
     // If the net code is not yet existing, a new one is created
     // Search is done in the entire list
+
+    // Group the bus label members by bus net code and member
+    std::map< std::pair<int, int>, std::vector<unsigned> > busMembers;
+
     for( unsigned ii = 0; ii < size(); ii++ )
     {
         NETLIST_OBJECT* Label = GetItem( ii );
 
         if( Label->IsLabelBusMemberType() )
+            busMembers[ std::make_pair( Label->m_BusNetCode, Label->m_Member ) ].push_back( ii );
+    }
+
+    for( unsigned ii = 0; ii < size(); ii++ )
+    {
+        NETLIST_OBJECT* Label = GetItem( ii );
+
+        if( !Label->IsLabelBusMemberType() )
+            continue;
+
+        if( Label->GetNet() == 0 )
         {
-            if( Label->GetNet() == 0 )
-            {
-                // Not yet existiing net code: create a new one.
-                Label->SetNet( m_lastNetCode );
-                m_lastNetCode++;
-            }
+            // Not yet existiing net code: create a new one.
+            Label->SetNet( m_lastNetCode );
+            m_lastNetCode++;
+        }
 
-            for( unsigned jj = ii + 1; jj < size(); jj++ )
-            {
-                NETLIST_OBJECT* LabelInTst =  GetItem( jj );
+        const std::vector<unsigned>& group =
+                busMembers[ std::make_pair( Label->m_BusNetCode, Label->m_Member ) ];
 
-                if( LabelInTst->IsLabelBusMemberType() )
-                {
-                    if( LabelInTst->m_BusNetCode != Label->m_BusNetCode )
-                        continue;
+        // The first label of a group connects all the others; after that,
+        // the group is already connected
+        if( group.front() != ii )
+            continue;
 
-                    if( LabelInTst->m_Member != Label->m_Member )
-                        continue;
+        for( unsigned jj : group )
+        {
+            if( jj == ii )
+                continue;
 
-                    if( LabelInTst->GetNet() == 0 )
-                        // Append this object to the current net
-                        LabelInTst->SetNet( Label->GetNet() );
-                    else
-                        // Merge the 2 net codes, they are connected.
-                        propagateNetCode( LabelInTst->GetNet(), Label->GetNet(), IS_WIRE );
-                }
-            }
+            NETLIST_OBJECT* LabelInTst = GetItem( jj );
+
+            if( LabelInTst->GetNet() == 0 )
+                // Append this object to the current net
+                LabelInTst->SetNet( getNet( Label ) );
+            else
+                // Merge the 2 net codes, they are connected.
+                propagateNetCode( getNet( LabelInTst ), getNet( Label ), IS_WIRE );
         }
     }
 }
 
 
+int NETLIST_OBJECT_LIST::findNetCode( int aNetCode, bool aIsBus )
+{
+    std::vector<int>& parent = aIsBus ? m_busNetCodeParent : m_netCodeParent;
+
+    while( aNetCode > 0 && aNetCode < (int) parent.size() && parent[aNetCode] )
+    {
+        int next = parent[aNetCode];
+
+        // path halving
+        if( next < (int) parent.size() && parent[next] )
+            parent[aNetCode] = parent[next];
+
+        aNetCode = next;
+    }
+
+    return aNetCode;
+}
+
+
 void NETLIST_OBJECT_LIST::propagateNetCode( int aOldNetCode, int aNewNetCode, bool aIsBus )
 {
-    if( aOldNetCode == aNewNetCode )
+    aOldNetCode = findNetCode( aOldNetCode, aIsBus );
+    aNewNetCode = findNetCode( aNewNetCode, aIsBus );
+
+    if( aOldNetCode == aNewNetCode || aOldNetCode <= 0 || aNewNetCode <= 0 )
         return;
 
-    if( aIsBus == false )    // Propagate NetCode
+    std::vector<int>& parent = aIsBus ? m_busNetCodeParent : m_netCodeParent;
+
+    if( aOldNetCode >= (int) parent.size() )
+        parent.resize( std::max( aOldNetCode + 1, (int) parent.size() * 2 ), 0 );
+
+    // The merged net keeps aNewNetCode
+    parent[aOldNetCode] = aNewNetCode;
+}
+
+
+void NETLIST_OBJECT_LIST::updateNetCodes()
+{
+    for( unsigned ii = 0; ii < size(); ii++ )
     {
-        for( unsigned jj = 0; jj < size(); jj++ )
-        {
-            NETLIST_OBJECT* object = GetItem( jj );
+        NETLIST_OBJECT* item = GetItem( ii );
 
-            if( object->GetNet() == aOldNetCode )
-                object->SetNet( aNewNetCode );
-        }
+        item->SetNet( getNet( item ) );
+        item->m_BusNetCode = getBusNet( item );
     }
-    else               // Propagate BusNetCode
+}
+
+
+void NETLIST_OBJECT_LIST::buildSheetIndex( unsigned aStart, unsigned aEnd )
+{
+    m_pointIndex.clear();
+    m_hSegmentIndex.clear();
+    m_vSegmentIndex.clear();
+    m_otherSegments.clear();
+
+    for( unsigned ii = aStart; ii < aEnd; ii++ )
     {
-        for( unsigned jj = 0; jj < size(); jj++ )
-        {
-            NETLIST_OBJECT* object = GetItem( jj );
+        NETLIST_OBJECT* item = GetItem( ii );
 
-            if( object->m_BusNetCode == aOldNetCode )
-                object->m_BusNetCode = aNewNetCode;
-        }
+        m_pointIndex[ pointKey( item->m_Start ) ].push_back( ii );
+
+        if( item->m_End != item->m_Start )
+            m_pointIndex[ pointKey( item->m_End ) ].push_back( ii );
+
+        if( item->m_Type != NET_SEGMENT && item->m_Type != NET_BUS )
+            continue;
+
+        if( item->m_Start.y == item->m_End.y )
+            m_hSegmentIndex[ item->m_Start.y ].push_back( ii );
+        else if( item->m_Start.x == item->m_End.x )
+            m_vSegmentIndex[ item->m_Start.x ].push_back( ii );
+        else
+            m_otherSegments.push_back( ii );
     }
 }
 
 
-void NETLIST_OBJECT_LIST::pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus, int start )
+void NETLIST_OBJECT_LIST::pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus )
 {
-    int netCode;
+    int netCode = aIsBus ? getBusNet( aRef ) : getNet( aRef );
 
-    if( aIsBus == false )    // Objects other than BUS and BUSLABELS
+    for( int ii = 0; ii < 2; ii++ )
     {
-        netCode = aRef->GetNet();
+        const wxPoint& refPoint = ii ? aRef->m_End : aRef->m_Start;
 
-        for( unsigned i = start; i < size(); i++ )
-        {
-            NETLIST_OBJECT* item = GetItem( i );
+        if( ii && aRef->m_End == aRef->m_Start )
+            break;
 
-            if( item->m_SheetPath != aRef->m_SheetPath )  //used to be > (why?)
-                continue;
+        std::unordered_map< long long, std::vector<unsigned> >::const_iterator candidates =
+                m_pointIndex.find( pointKey( refPoint ) );
 
-            switch( item->m_Type )
+        if( candidates == m_pointIndex.end() )
+            continue;
+
+        for( unsigned idx : candidates->second )
+        {
+            NETLIST_OBJECT* item = GetItem( idx );
+
+            if( aIsBus == false )    // Objects other than BUS and BUSLABELS
             {
-            case NET_SEGMENT:
-            case NET_PIN:
-            case NET_LABEL:
-            case NET_HIERLABEL:
-            case NET_GLOBLABEL:
-            case NET_SHEETLABEL:
-            case NET_PINLABEL:
-            case NET_JUNCTION:
-            case NET_NOCONNECT:
-                if( aRef->m_Start == item->m_Start
-                    || aRef->m_Start == item->m_End
-                    || aRef->m_End   == item->m_Start
-                    || aRef->m_End   == item->m_End )
+                switch( item->m_Type )
                 {
+                case NET_SEGMENT:
+                case NET_PIN:
+                case NET_LABEL:
+                case NET_HIERLABEL:
+                case NET_GLOBLABEL:
+                case NET_SHEETLABEL:
+                case NET_PINLABEL:
+                case NET_JUNCTION:
+                case NET_NOCONNECT:
                     if( item->GetNet() == 0 )
                         item->SetNet( netCode );
                     else
-                        propagateNetCode( item->GetNet(), netCode, IS_WIRE );
+                        propagateNetCode( getNet( item ), netCode, IS_WIRE );
+                    break;
+
+                case NET_BUS:
+                case NET_BUSLABELMEMBER:
+                case NET_SHEETBUSLABELMEMBER:
+                case NET_HIERBUSLABELMEMBER:
+                case NET_GLOBBUSLABELMEMBER:
+                case NET_ITEM_UNSPECIFIED:
+                    break;
                 }
-                break;
-
-            case NET_BUS:
-            case NET_BUSLABELMEMBER:
-            case NET_SHEETBUSLABELMEMBER:
-            case NET_HIERBUSLABELMEMBER:
-            case NET_GLOBBUSLABELMEMBER:
-            case NET_ITEM_UNSPECIFIED:
-                break;
             }
-        }
-    }
-    else    // Object type BUS, BUSLABELS, and junctions.
-    {
-        netCode = aRef->m_BusNetCode;
-
-        for( unsigned i = start; i < size(); i++ )
-        {
-            NETLIST_OBJECT* item = GetItem( i );
-
-            if( item->m_SheetPath != aRef->m_SheetPath )
-                continue;
-
-            switch( item->m_Type )
+            else    // Object type BUS, BUSLABELS, and junctions.
             {
-            case NET_ITEM_UNSPECIFIED:
-            case NET_SEGMENT:
-            case NET_PIN:
-            case NET_LABEL:
-            case NET_HIERLABEL:
-            case NET_GLOBLABEL:
-            case NET_SHEETLABEL:
-            case NET_PINLABEL:
-            case NET_NOCONNECT:
-                break;
-
-            case NET_BUS:
-            case NET_BUSLABELMEMBER:
-            case NET_SHEETBUSLABELMEMBER:
-            case NET_HIERBUSLABELMEMBER:
-            case NET_GLOBBUSLABELMEMBER:
-            case NET_JUNCTION:
-                if(  aRef->m_Start == item->m_Start
-                  || aRef->m_Start == item->m_End
-                  || aRef->m_End   == item->m_Start
-                  || aRef->m_End   == item->m_End )
+                switch( item->m_Type )
                 {
+                case NET_ITEM_UNSPECIFIED:
+                case NET_SEGMENT:
+                case NET_PIN:
+                case NET_LABEL:
+                case NET_HIERLABEL:
+                case NET_GLOBLABEL:
+                case NET_SHEETLABEL:
+                case NET_PINLABEL:
+                case NET_NOCONNECT:
+                    break;
+
+                case NET_BUS:
+                case NET_BUSLABELMEMBER:
+                case NET_SHEETBUSLABELMEMBER:
+                case NET_HIERBUSLABELMEMBER:
+                case NET_GLOBBUSLABELMEMBER:
+                case NET_JUNCTION:
                     if( item->m_BusNetCode == 0 )
                         item->m_BusNetCode = netCode;
                     else
-                        propagateNetCode( item->m_BusNetCode, netCode, IS_BUS );
+                        propagateNetCode( getBusNet( item ), netCode, IS_BUS );
+                    break;
                 }
-                break;
             }
         }
     }
 }
 
 
-void NETLIST_OBJECT_LIST::segmentToPointConnect( NETLIST_OBJECT* aJonction,
-                                                 bool aIsBus, int aIdxStart )
+void NETLIST_OBJECT_LIST::segmentToPointConnect( NETLIST_OBJECT* aJonction, bool aIsBus )
 {
-    for( unsigned i = aIdxStart; i < size(); i++ )
-    {
-        NETLIST_OBJECT* segment = GetItem( i );
+    const wxPoint& point = aJonction->m_Start;
+
+    // Only the segments of the current sheet having the same Y (horizontal ones),
+    // the same X (vertical ones), or not axis aligned can contain the point
+    const std::vector<unsigned>* candidateLists[3] = { NULL, NULL, &m_otherSegments };
+
+    std::unordered_map< int, std::vector<unsigned> >::const_iterator it;
 
-        // if different sheets, obviously no physical connection between elements.
-        if( segment->m_SheetPath != aJonction->m_SheetPath )
+    if( ( it = m_hSegmentIndex.find( point.y ) ) != m_hSegmentIndex.end() )
+        candidateLists[0] = &it->second;
+
+    if( ( it = m_vSegmentIndex.find( point.x ) ) != m_vSegmentIndex.end() )
+        candidateLists[1] = &it->second;
+
+    for( const std::vector<unsigned>* candidates : candidateLists )
+    {
+        if( !candidates )
             continue;
 
-        if( aIsBus == IS_WIRE )
-        {
-            if( segment->m_Type != NET_SEGMENT )
-                continue;
-        }
-        else
+        for( unsigned idx : *candidates )
         {
-            if( segment->m_Type != NET_BUS )
-                continue;
-        }
+            NETLIST_OBJECT* segment = GetItem( idx );
 
-        if( IsPointOnSegment( segment->m_Start, segment->m_End, aJonction->m_Start ) )
-        {
-            // Propagation Netcode has all the objects of the same Netcode.
             if( aIsBus == IS_WIRE )
             {
-                if( segment->GetNet() )
-                    propagateNetCode( segment->GetNet(), aJonction->GetNet(), aIsBus );
-                else
-                    segment->SetNet( aJonction->GetNet() );
+                if( segment->m_Type != NET_SEGMENT )
+                    continue;
             }
             else
             {
-                if( segment->m_BusNetCode )
-                    propagateNetCode( segment->m_BusNetCode, aJonction->m_BusNetCode, aIsBus );
+                if( segment->m_Type != NET_BUS )
+                    continue;
+            }
+
+            if( IsPointOnSegment( segment->m_Start, segment->m_End, point ) )
+            {
+                // Propagation Netcode has all the objects of the same Netcode.
+                if( aIsBus == IS_WIRE )
+                {
+                    if( segment->GetNet() )
+                        propagateNetCode( getNet( segment ), getNet( aJonction ), aIsBus );
+                    else
+                        segment->SetNet( getNet( aJonction ) );
+                }
                 else
-                    segment->m_BusNetCode = aJonction->m_BusNetCode;
+                {
+                    if( segment->m_BusNetCode )
+                        propagateNetCode( getBusNet( segment ), getBusNet( aJonction ), aIsBus );
+                    else
+                        segment->m_BusNetCode = getBusNet( aJonction );
+                }
             }
         }
     }
@@ -739,14 +842,21 @@ void NETLIST_OBJECT_LIST::segmentToPointConnect( NETLIST_OBJECT* aJonction,
 
 void NETLIST_OBJECT_LIST::labelConnect( NETLIST_OBJECT* aLabelRef )
 {
-    if( aLabelRef->GetNet() == 0 )
+    if( getNet( aLabelRef ) == 0 )
         return;
 
-    for( unsigned i = 0; i < size(); i++ )
+    // Only labels having the same text can be connected
+    std::map< wxString, std::vector<unsigned> >::const_iterator labels =
+            m_labelIndex.find( aLabelRef->m_Label );
+
+    if( labels == m_labelIndex.end() )
+        return;
+
+    for( unsigned i : labels->second )
     {
         NETLIST_OBJECT* item = GetItem( i );
 
-        if( item->GetNet() == aLabelRef->GetNet() )
+        if( getNet( item ) == getNet( aLabelRef ) )
             continue;
 
         if( item->m_SheetPath != aLabelRef->m_SheetPath )
@@ -766,16 +876,10 @@ void NETLIST_OBJECT_LIST::labelConnect( NETLIST_OBJECT* aLabelRef )
         // NET_LABEL are local to a sheet
         // NET_GLOBLABEL are global.
         // NET_PINLABEL is a kind of global label (generated by a power pin invisible)
-        if( item->IsLabelType() )
-        {
-            if( item->m_Label != aLabelRef->m_Label )
-                continue;
-
-            if( item->GetNet() )
-                propagateNetCode( item->GetNet(), aLabelRef->GetNet(), IS_WIRE );
-            else
-                item->SetNet( aLabelRef->GetNet() );
-        }
+        if( item->GetNet() )
+            propagateNetCode( getNet( item ), getNet( aLabelRef ), IS_WIRE );
+        else
+            item->SetNet( getNet( aLabelRef ) );
     }
 }
 
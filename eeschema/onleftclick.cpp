@@ -322,7 +322,7 @@ void SCH_EDIT_FRAME::OnLeftClick( wxDC* aDC, const wxPoint& aPosition )
             if( !item )
                 break;
 
-            std::unique_ptr<NETLIST_OBJECT_LIST> netlist( BuildNetListBase() );
+            NETLIST_OBJECT_LIST* netlist = GetConnectedItems();
 
             for( NETLIST_OBJECT* obj : *netlist )
             {
@@ -0,0 +1,132 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file annotation_bench.cpp
+ * measures the time spent annotating and checking the annotation of a synthetic
+ * hierarchy of sheets filled with single unit and multi-unit components.
+ *
+ * usage: qa_annotation_bench [component count]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <wx/init.h>
+
+#include <kiway.h>
+#include <pgm_base.h>
+#include <profile.h>
+#include <reporter.h>
+#include <class_libentry.h>
+#include <sch_component.h>
+#include <sch_sheet.h>
+#include <sch_sheet_path.h>
+#include <sch_reference_list.h>
+
+
+static struct PGM_ANNOTATION_BENCH : public PGM_BASE
+{
+    bool OnPgmInit() override { return true; }
+    void OnPgmExit() override {}
+    void MacOpenFile( const wxString& aFileName ) override {}
+} program;
+
+
+static const int SHEET_COUNT = 80;
+
+
+int main( int argc, char* argv[] )
+{
+    wxInitializer initializer;
+    int           kifaceVersion;
+    int           count = argc > 1 ? atoi( argv[1] ) : 10000;
+
+    // The eeschema kiface needs the program for the default field names.
+    KIFACE_GETTER( &kifaceVersion, KIFACE_VERSION, &program );
+
+    LIB_PART resistor( wxT( "R" ) );
+    LIB_PART capacitor( wxT( "C" ) );
+    LIB_PART opamp( wxT( "OPAMP" ) );
+
+    opamp.SetUnitCount( 4 );
+
+    SCH_SHEET                                     root;
+    std::vector< std::unique_ptr< SCH_SHEET > >   sheets;
+    std::vector< SCH_SHEET_PATH >                 paths( SHEET_COUNT );
+    std::vector< std::unique_ptr< SCH_COMPONENT > > components;
+
+    for( int ii = 0; ii < SHEET_COUNT; ii++ )
+    {
+        sheets.emplace_back( new SCH_SHEET );
+        paths[ii].push_back( &root );
+        paths[ii].push_back( sheets.back().get() );
+    }
+
+    SCH_REFERENCE_LIST references;
+
+    for( int ii = 0; ii < count; ii++ )
+    {
+        SCH_SHEET_PATH& path = paths[ ii % SHEET_COUNT ];
+        LIB_PART*       part;
+        wxString        ref;
+
+        switch( ii % 4 )
+        {
+        case 0:
+        case 1:  part = &resistor;  ref = wxT( "R?" ); break;
+        case 2:  part = &capacitor; ref = wxT( "C?" ); break;
+        default: part = &opamp;     ref = wxT( "U?" ); break;
+        }
+
+        wxPoint pos( ( ii * 7919 ) % 100000, ( ii * 104729 ) % 100000 );
+
+        components.emplace_back( new SCH_COMPONENT( *part, &path, 1, 0, pos ) );
+        components.back()->SetRef( &path, ref );
+
+        SCH_REFERENCE reference( components.back().get(), part, path );
+        references.AddItem( reference );
+    }
+
+    references.SplitReferences();
+    references.SortByXCoordinate();
+
+    PROF_COUNTER annotate( "annotate" );
+    references.Annotate( false, 0, 0, SCH_MULTI_UNIT_REFERENCE_MAP() );
+    annotate.Stop();
+
+    PROF_COUNTER check( "check annotation" );
+    int errors = references.CheckAnnotation( NULL_REPORTER::GetInstance() );
+    check.Stop();
+
+    printf( "%d components on %d sheets\n", count, SHEET_COUNT );
+    annotate.Show();
+    check.Show();
+
+    if( errors )
+        printf( "%d annotation errors\n", errors );
+
+    return errors ? 1 : 0;
+}
@@ -55,6 +55,8 @@
 #include <wx/tokenzr.h>
 #include <iostream>
 #include <cctype>
+#include <atomic>
+#include <thread>
 
 #include <eeschema_id.h>    // for MAX_UNIT_COUNT_PER_PACKAGE definition
 
@@ -387,34 +389,18 @@ void SCH_COMPONENT::ResolveAll( const SCH_COLLECTOR& aComponents, PART_LIBS* aLi
     // sort it by lib part. Cmp will be grouped by same lib part.
     std::sort( cmp_list.begin(), cmp_list.end(), sort_by_libid );
 
-    LIB_ID curr_libid;
+    std::vector<size_t> groups;
 
-    for( unsigned ii = 0; ii < cmp_list.size (); ++ii )
+    for( size_t ii = 0; ii < cmp_list.size(); ++ii )
     {
-        SCH_COMPONENT* cmp = cmp_list[ii];
-        curr_libid = cmp->m_lib_id;
-        cmp->Resolve( aLibs );
-        cmp->UpdatePinCache();
-
-        // Propagate the m_part pointer to other members using the same lib_id
-        for( unsigned jj = ii+1; jj < cmp_list.size (); ++jj )
+        if( ii == 0 || cmp_list[ii]->m_lib_id != cmp_list[ii - 1]->m_lib_id )
         {
-            SCH_COMPONENT* next_cmp = cmp_list[jj];
-
-            if( curr_libid != next_cmp->m_lib_id )
-                break;
-
-            next_cmp->m_part = cmp->m_part;
-
-            if( ( cmp->m_unit == next_cmp->m_unit ) && ( cmp->m_convert == next_cmp->m_convert ) )
-                // Propagate the pin cache vector as well
-                next_cmp->m_Pins = cmp->m_Pins;
-            else
-                next_cmp->UpdatePinCache();
-
-            ii = jj;
+            groups.push_back( ii );
+            cmp_list[ii]->Resolve( aLibs );
         }
     }
+
+    propagateParts( cmp_list, groups );
 }
 
 
@@ -435,34 +421,81 @@ void SCH_COMPONENT::ResolveAll( const SCH_COLLECTOR& aComponents, SYMBOL_LIB_TAB
     // sort it by lib part. Cmp will be grouped by same lib part.
     std::sort( cmp_list.begin(), cmp_list.end(), sort_by_libid );
 
-    LIB_ID curr_libid;
+    std::vector<size_t> groups;
 
-    for( unsigned ii = 0; ii < cmp_list.size (); ++ii )
+    for( size_t ii = 0; ii < cmp_list.size(); ++ii )
     {
-        SCH_COMPONENT* cmp = cmp_list[ii];
-        curr_libid = cmp->m_lib_id;
-        cmp->Resolve( aLibTable, aCacheLib );
-        cmp->UpdatePinCache();
-
-        // Propagate the m_part pointer to other members using the same lib_id
-        for( unsigned jj = ii+1; jj < cmp_list.size (); ++jj )
+        if( ii == 0 || cmp_list[ii]->m_lib_id != cmp_list[ii - 1]->m_lib_id )
         {
-            SCH_COMPONENT* next_cmp = cmp_list[jj];
+            groups.push_back( ii );
+            cmp_list[ii]->Resolve( aLibTable, aCacheLib );
+        }
+    }
 
-            if( curr_libid != next_cmp->m_lib_id )
-                break;
+    propagateParts( cmp_list, groups );
+}
+
+
+void SCH_COMPONENT::propagateParts( const std::vector<SCH_COMPONENT*>& aComponents,
+                                    const std::vector<size_t>& aGroups )
+{
+    // Assign the part of the first member of a group to the other members and update the
+    // pin caches.  Members are also sorted by unit and convert, so the pin cache of the
+    // previous member can be reused when they match.
+    auto propagate = [&]( size_t aGroup )
+    {
+        size_t first = aGroups[aGroup];
+        size_t last = aGroup + 1 < aGroups.size() ? aGroups[aGroup + 1] : aComponents.size();
+        SCH_COMPONENT* prev = aComponents[first];
+
+        prev->UpdatePinCache();
+
+        for( size_t ii = first + 1; ii < last; ++ii )
+        {
+            SCH_COMPONENT* cmp = aComponents[ii];
 
-            next_cmp->m_part = cmp->m_part;
+            cmp->m_part = prev->m_part;
 
-            if( ( cmp->m_unit == next_cmp->m_unit ) && ( cmp->m_convert == next_cmp->m_convert ) )
-                // Propagate the pin cache vector as well
-                next_cmp->m_Pins = cmp->m_Pins;
+            if( ( cmp->m_unit == prev->m_unit ) && ( cmp->m_convert == prev->m_convert ) )
+                cmp->m_Pins = prev->m_Pins;
             else
-                next_cmp->UpdatePinCache();
+                cmp->UpdatePinCache();
 
-            ii = jj;
+            prev = cmp;
         }
+    };
+
+    // The groups are independent once their first member is resolved.  Threads are only
+    // worth starting for large schematics.
+    const size_t parallelThreshold = 1000;
+
+    if( aComponents.size() < parallelThreshold || aGroups.size() < 2 )
+    {
+        for( size_t ii = 0; ii < aGroups.size(); ++ii )
+            propagate( ii );
+
+        return;
+    }
+
+    std::atomic<size_t>      nextGroup( 0 );
+    std::vector<std::thread> workers;
+    size_t parallelThreadCount = std::min<size_t>( aGroups.size(),
+            std::max<size_t>( std::thread::hardware_concurrency(), 2 ) );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        workers.push_back( std::thread( [&]()
+        {
+            for( size_t i = nextGroup.fetch_add( 1 ); i < aGroups.size();
+                 i = nextGroup.fetch_add( 1 ) )
+            {
+                propagate( i );
+            }
+        } ) );
     }
+
+    for( auto& worker : workers )
+        worker.join();
 }
 
 
@@ -470,19 +503,16 @@ void SCH_COMPONENT::UpdatePinCache()
 {
     if( PART_SPTR part = m_part.lock() )
     {
-        m_Pins.clear();
-        for( LIB_PIN* pin = part->GetNextPin();  pin;  pin = part->GetNextPin( pin ) )
-        {
-            wxASSERT( pin->Type() == LIB_PIN_T );
+        LIB_PINS pins;
 
-            if( pin->GetUnit() && m_unit && ( m_unit != pin->GetUnit() ) )
-                continue;
+        // LIB_PART::GetNextPin() searches the previous pin on each call, use the pin list.
+        part->GetPins( pins, m_unit, m_convert );
 
-            if( pin->GetConvert() && m_convert && ( m_convert != pin->GetConvert() ) )
-                continue;
+        m_Pins.clear();
+        m_Pins.reserve( pins.size() );
 
+        for( LIB_PIN* pin : pins )
             m_Pins.push_back( pin->GetPosition() );
-        }
     }
 }
 
@@ -628,6 +628,17 @@ public:
 
 private:
     bool doIsConnected( const wxPoint& aPosition ) const override;
+
+    /**
+     * Propagate the part of the first member of each group to the other members and update
+     * their pin caches.
+     *
+     * @param aComponents is the list of components sorted by #LIB_ID, unit and convert.
+     * @param aGroups is the index in \a aComponents of the first member of each group of
+     *                components using the same #LIB_ID.
+     */
+    static void propagateParts( const std::vector<SCH_COMPONENT*>& aComponents,
+                                const std::vector<size_t>& aGroups );
 };
 
 
@@ -372,6 +372,9 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ):
     m_findReplaceStatus = new wxString( wxEmptyString );
     m_undoItem = NULL;
     m_hasAutoSave = true;
+    m_connectedItems = NULL;
+    m_connectedItemsLibHash = 0;
+    m_connectedItemsModifySerial = 0;
 
     SetForceHVLines( true );
     SetSpiceAjustPassiveValues( false );
@@ -459,6 +462,8 @@ SCH_EDIT_FRAME::~SCH_EDIT_FRAME()
 
     SetScreen( NULL );
 
+    InvalidateConnectedItems();
+
     delete m_CurrentSheet;          // a SCH_SHEET_PATH, on the heap.
     delete m_undoItem;
     delete g_RootSheet;
@@ -774,6 +779,8 @@ void SCH_EDIT_FRAME::OnModify()
 
     m_foundItems.SetForceSearch();
 
+    InvalidateConnectedItems();
+
     m_canvas->Refresh();
 }
 
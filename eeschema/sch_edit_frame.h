@@ -172,6 +172,15 @@ private:
     /// Use netcodes (net number) as net names when generating spice net lists.
     bool        m_spiceAjustPassiveValues;
 
+    /// Connected items of the whole hierarchy, see GetConnectedItems().
+    NETLIST_OBJECT_LIST* m_connectedItems;
+
+    /// The symbol library table modify hash #m_connectedItems was built with.
+    int         m_connectedItemsLibHash;
+
+    /// The last modify serial number of the screens #m_connectedItems was built with.
+    unsigned    m_connectedItemsModifySerial;
+
     /*  these are PROJECT specific, not schematic editor specific
     wxString        m_userLibraryPath;
     wxArrayString   m_componentLibFiles;
@@ -538,6 +547,22 @@ public:
      */
     NETLIST_OBJECT_LIST* BuildNetListBase( bool updateStatusText = true );
 
+    /**
+     * Return the connected items of the whole hierarchy.
+     *
+     * The list is kept across calls and only rebuilt after a screen of the hierarchy was
+     * modified (see BASE_SCREEN::GetModifySerial()) or the symbol libraries changed, so
+     * repeated read only queries such as net highlighting do not rebuild the netlist.
+     *
+     * @return NETLIST_OBJECT_LIST* - the frame owns the object, it must not be modified.
+     */
+    NETLIST_OBJECT_LIST* GetConnectedItems();
+
+    /**
+     * Discard the list returned by GetConnectedItems(), it will be rebuilt on next use.
+     */
+    void InvalidateConnectedItems();
+
     /**
      * Create a netlist for the current schematic.
      *
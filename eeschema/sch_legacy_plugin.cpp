@@ -22,6 +22,10 @@
 
 #include <ctype.h>
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <map>
+#include <thread>
 
 #include <wx/mstream.h>
 #include <wx/filename.h>
@@ -572,6 +576,7 @@ SCH_LEGACY_PLUGIN::~SCH_LEGACY_PLUGIN()
 void SCH_LEGACY_PLUGIN::init( KIWAY* aKiway, const PROPERTIES* aProperties )
 {
     m_version = 0;
+    m_modified = false;
     m_rootSheet = NULL;
     m_props = aProperties;
     m_kiway = aKiway;
@@ -642,89 +647,200 @@ SCH_SHEET* SCH_LEGACY_PLUGIN::Load( const wxString& aFileName, KIWAY* aKiway,
 
     wxASSERT( m_currentPath.size() == 1 );  // only the project path should remain
 
+    // Set the file as modified if it had to be fixed, so the user can be warned.
+    if( m_modified && m_rootSheet->GetScreen() )
+        m_rootSheet->GetScreen()->SetModify();
+
     return sheet;
 }
 
 
-// Everything below this comment is recursive.  Modify with care.
-
 void SCH_LEGACY_PLUGIN::loadHierarchy( SCH_SHEET* aSheet )
 {
-    SCH_SCREEN* screen = NULL;
+    // The hierarchy is loaded one level at a time.  The sheet files of a level do not depend
+    // on each other until they are linked to their SCH_SHEET objects, so all the distinct
+    // files of a level are parsed concurrently.  Each sheet is paired with the path its file
+    // name is relative to, which allows for sheet schematic files to be nested in folders
+    // relative to the last path a schematic was loaded from.
+    std::vector< std::pair< SCH_SHEET*, wxString > > pending;
+
+    // The screens loaded so far by full file name.  Complex hierarchies can have multiple
+    // copies of a sheet which all share the same screen.
+    std::map< wxString, SCH_SCREEN* > screens;
+
+    pending.push_back( std::make_pair( aSheet, m_currentPath.top() ) );
 
-    if( !aSheet->GetScreen() )
+    while( !pending.empty() )
     {
-        // SCH_SCREEN objects store the full path and file name where the SCH_SHEET object only
-        // stores the file name and extension.  Add the project path to the file name and
-        // extension to compare when calling SCH_SHEET::SearchHierarchy().
-        wxFileName fileName = aSheet->GetFileName();
+        std::vector< SCH_SHEET* > loading;
 
-        if( !fileName.IsAbsolute() )
-            fileName.MakeAbsolute( m_currentPath.top() );
+        for( const std::pair< SCH_SHEET*, wxString >& entry : pending )
+        {
+            SCH_SHEET* sheet = entry.first;
+
+            if( sheet->GetScreen() )
+                continue;
 
-        // Save the current path so that it gets restored when decending and ascending the
-        // sheet hierarchy which allows for sheet schematic files to be nested in folders
-        // relative to the last path a schematic was loaded from.
-        wxLogTrace( traceSchLegacyPlugin, "Saving path    \"%s\"", m_currentPath.top() );
-        m_currentPath.push( fileName.GetPath() );
-        wxLogTrace( traceSchLegacyPlugin, "Current path   \"%s\"", m_currentPath.top() );
-        wxLogTrace( traceSchLegacyPlugin, "Loading        \"%s\"", fileName.GetFullPath() );
+            // SCH_SCREEN objects store the full path and file name where the SCH_SHEET object
+            // only stores the file name and extension.  Add the sheet path to the file name
+            // and extension to compare when calling SCH_SHEET::SearchHierarchy().
+            wxFileName fileName = sheet->GetFileName();
 
-        m_rootSheet->SearchHierarchy( fileName.GetFullPath(), &screen );
+            if( !fileName.IsAbsolute() )
+                fileName.MakeAbsolute( entry.second );
 
-        if( screen )
-        {
-            aSheet->SetScreen( screen );
+            wxString    fullName = fileName.GetFullPath();
+            SCH_SCREEN* screen = NULL;
+            auto        loaded = screens.find( fullName );
+
+            if( loaded != screens.end() )
+                screen = loaded->second;
+            else
+                m_rootSheet->SearchHierarchy( fullName, &screen );
+
+            if( screen )
+            {
+                sheet->SetScreen( screen );
+
+                // Do not need to load the sub-sheets - this has already been done.
+                continue;
+            }
 
-            // Do not need to load the sub-sheets - this has already been done.
+            wxLogTrace( traceSchLegacyPlugin, "Loading        \"%s\"", fullName );
+
+            screen = new SCH_SCREEN( m_kiway );
+            screen->SetFileName( fullName );
+            sheet->SetScreen( screen );
+            screens[ fullName ] = screen;
+            loading.push_back( sheet );
         }
-        else
-        {
-            aSheet->SetScreen( new SCH_SCREEN( m_kiway ) );
-            aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
 
+        pending.clear();
+
+        std::vector< std::exception_ptr > errors( loading.size() );
+
+        if( loading.size() == 1 )
+        {
             try
             {
-                loadFile( fileName.GetFullPath(), aSheet->GetScreen() );
+                loadFile( loading[0]->GetScreen()->GetFileName(), loading[0]->GetScreen() );
+            }
+            catch( ... )
+            {
+                errors[0] = std::current_exception();
+            }
+        }
+        else if( loading.size() > 1 )
+        {
+            // The file version and the fixed file flag are per file state, so each file is
+            // parsed by its own plugin.
+            std::atomic<size_t>      nextFile( 0 );
+            std::atomic<bool>        modified( false );
+            std::vector<std::thread> workers;
+            size_t parallelThreadCount = std::min<size_t>( loading.size(),
+                    std::max<size_t>( std::thread::hardware_concurrency(), 2 ) );
+
+            // Fetch the translated default field names before they are shared by the workers.
+            TEMPLATE_FIELDNAME::GetDefaultFieldName( 0 );
+
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            {
+                workers.push_back( std::thread( [this, &loading, &errors, &nextFile, &modified]()
+                {
+                    SCH_LEGACY_PLUGIN parser;
 
-                EDA_ITEM* item = aSheet->GetScreen()->GetDrawItems();
+                    parser.init( m_kiway, m_props );
 
-                while( item )
-                {
-                    if( item->Type() == SCH_SHEET_T )
+                    for( size_t i = nextFile.fetch_add( 1 ); i < loading.size();
+                         i = nextFile.fetch_add( 1 ) )
                     {
-                        SCH_SHEET* sheet = (SCH_SHEET*) item;
+                        SCH_SCREEN* screen = loading[i]->GetScreen();
+
+                        try
+                        {
+                            parser.loadFile( screen->GetFileName(), screen );
+                        }
+                        catch( ... )
+                        {
+                            errors[i] = std::current_exception();
+                        }
+                    }
+
+                    if( parser.m_modified )
+                        modified = true;
+                } ) );
+            }
 
-                        // Set the parent to aSheet.  This effectively creates a method to find
-                        // the root sheet from any sheet so a pointer to the root sheet does not
-                        // need to be stored globally.  Note: this is not the same as a hierarchy.
-                        // Complex hierarchies can have multiple copies of a sheet.  This only
-                        // provides a simple tree to find the root sheet.
-                        sheet->SetParent( aSheet );
+            for( auto& worker : workers )
+                worker.join();
 
-                        // Recursion starts here.
-                        loadHierarchy( sheet );
-                    }
+            if( modified )
+                m_modified = true;
+        }
+
+        // Link the sub-sheets of the new screens, in the order of the hierarchy.
+        for( size_t ii = 0; ii < loading.size(); ++ii )
+        {
+            SCH_SHEET* sheet = loading[ii];
+
+            // The items read before an error are kept, bitmaps included.
+            createBitmaps( sheet->GetScreen() );
+
+            if( errors[ii] )
+            {
+                try
+                {
+                    std::rethrow_exception( errors[ii] );
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    // If there is a problem loading the root sheet, there is no recovery.
+                    if( sheet == m_rootSheet )
+                        throw;
+
+                    // For all subsheets, queue up the error message for the caller.
+                    if( !m_error.IsEmpty() )
+                        m_error += "\n";
 
-                    item = item->Next();
+                    m_error += ioe.What();
                 }
+
+                continue;
             }
-            catch( const IO_ERROR& ioe )
-            {
-                // If there is a problem loading the root sheet, there is no recovery.
-                if( aSheet == m_rootSheet )
-                    throw( ioe );
 
-                // For all subsheets, queue up the error message for the caller.
-                if( !m_error.IsEmpty() )
-                    m_error += "\n";
+            wxString path = wxFileName( sheet->GetScreen()->GetFileName() ).GetPath();
 
-                m_error += ioe.What();
+            for( EDA_ITEM* item = sheet->GetScreen()->GetDrawItems(); item; item = item->Next() )
+            {
+                if( item->Type() == SCH_SHEET_T )
+                {
+                    SCH_SHEET* subSheet = (SCH_SHEET*) item;
+
+                    // Set the parent to sheet.  This effectively creates a method to find
+                    // the root sheet from any sheet so a pointer to the root sheet does not
+                    // need to be stored globally.  Note: this is not the same as a hierarchy.
+                    // Complex hierarchies can have multiple copies of a sheet.  This only
+                    // provides a simple tree to find the root sheet.
+                    subSheet->SetParent( sheet );
+                    pending.push_back( std::make_pair( subSheet, path ) );
+                }
             }
         }
+    }
+}
+
+
+void SCH_LEGACY_PLUGIN::createBitmaps( SCH_SCREEN* aScreen )
+{
+    for( EDA_ITEM* item = aScreen->GetDrawItems(); item; item = item->Next() )
+    {
+        if( item->Type() != SCH_BITMAP_T )
+            continue;
+
+        BITMAP_BASE* image = static_cast<SCH_BITMAP*>( item )->GetImage();
 
-        m_currentPath.pop();
-        wxLogTrace( traceSchLegacyPlugin, "Restoring path \"%s\"", m_currentPath.top() );
+        if( image->GetImageData() )
+            image->SetBitmap( new wxBitmap( *image->GetImageData() ) );
     }
 }
 
@@ -1091,12 +1207,13 @@ SCH_BITMAP* SCH_LEGACY_PLUGIN::loadBitmap( FILE_LINE_READER& aReader )
                 if( strCompare( "EndData", line ) )
                 {
                     // all the PNG date is read.
-                    // We expect here m_image and m_bitmap are void
+                    // We expect here m_image and m_bitmap are void.  The files can be
+                    // read by worker threads, so the bitmap, a GUI object, is built by
+                    // loadHierarchy() once the files are read (see createBitmaps()).
                     wxImage* image = new wxImage();
                     wxMemoryInputStream istream( stream );
                     image->LoadFile( istream, wxBITMAP_TYPE_PNG );
                     bitmap->GetImage()->SetImage( image );
-                    bitmap->GetImage()->SetBitmap( new wxBitmap( *image ) );
                     break;
                 }
 
@@ -1472,8 +1589,7 @@ SCH_COMPONENT* SCH_LEGACY_PLUGIN::loadComponent( FILE_LINE_READER& aReader )
                 unit = 1;
 
                 // Set the file as modified so the user can be warned.
-                if( m_rootSheet && m_rootSheet->GetScreen() )
-                    m_rootSheet->GetScreen()->SetModify();
+                m_modified = true;
             }
 
             component->SetUnit( unit );
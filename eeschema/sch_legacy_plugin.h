@@ -133,6 +133,9 @@ private:
     void loadHeader( FILE_LINE_READER& aReader, SCH_SCREEN* aScreen );
     void loadPageSettings( FILE_LINE_READER& aReader, SCH_SCREEN* aScreen );
     void loadFile( const wxString& aFileName, SCH_SCREEN* aScreen );
+
+    /// Build the wxBitmaps of the images loaded in \a aScreen, in the main thread.
+    void createBitmaps( SCH_SCREEN* aScreen );
     SCH_SHEET* loadSheet( FILE_LINE_READER& aReader );
     SCH_BITMAP* loadBitmap( FILE_LINE_READER& aReader );
     SCH_JUNCTION* loadJunction( FILE_LINE_READER& aReader );
@@ -158,6 +161,7 @@ private:
 
 protected:
     int               m_version;    ///< Version of file being loaded.
+    bool              m_modified;   ///< A loaded file was fixed and should be saved again.
 
     /** For throwing exceptions or errors on partial schematic loads. */
     wxString          m_error;
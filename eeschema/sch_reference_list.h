@@ -493,16 +493,17 @@ private:
 
     /**
      * Function CreateFirstFreeRefId
-     * searches for the first free reference number in \a aListId of reference numbers in use.
+     * searches for the first free reference number in \a aIdList of reference numbers in use.
      * This function just searches for a hole in a list of incremented numbers, this list must
-     * be sorted by increasing values and each value can be stored only once.  The new value
-     * is added to the list.
-     * @see BuildRefIdInUseList to prepare this list
+     * be sorted by increasing values and each value can be stored only once.  Successive calls
+     * return increasing values, the search starts where the previous one ended.
+     * @see GetRefsInUse to prepare this list
      * @param aIdList The buffer that contains the reference numbers in use.
-     * @param aFirstValue The first expected free value
+     * @param aIdPos The position in \a aIdList where the search starts, 0 for the first call.
+     * @param aNextId The first expected free value, updated for the next call.
      * @return The first free (not yet used) value.
      */
-    int CreateFirstFreeRefId( std::vector<int>& aIdList, int aFirstValue );
+    int CreateFirstFreeRefId( const std::vector<int>& aIdList, size_t& aIdPos, int& aNextId );
 };
 
 #endif    // _SCH_REFERENCE_LIST_H_
@@ -54,6 +54,10 @@
 #include <sch_text.h>
 #include <lib_pin.h>
 #include <symbol_lib_table.h>
+#include <trigo.h>
+
+#include <algorithm>
+#include <unordered_map>
 
 #define EESCHEMA_FILE_STAMP   "EESchema"
 
@@ -910,6 +914,125 @@ int SCH_SCREEN::UpdatePickList()
 }
 
 
+// key of a point in the dangling end index
+static inline long long pointKey( const wxPoint& aPoint )
+{
+    return (long long) ( ( (unsigned long long) (unsigned) aPoint.x << 32 ) | (unsigned) aPoint.y );
+}
+
+
+/**
+ * Class DANGLING_END_INDEX
+ * is a spatial index of the end points of a screen.  Wires and buses are indexed by the
+ * horizontal or vertical line they lie on, and all other end points by position, so the
+ * end points that can touch a given connection point are found without scanning the
+ * whole screen.
+ */
+class DANGLING_END_INDEX
+{
+public:
+    DANGLING_END_INDEX( const std::vector< DANGLING_END_ITEM >& aEndPoints ) :
+        m_endPoints( aEndPoints )
+    {
+        for( size_t ii = 0; ii < m_endPoints.size(); ii++ )
+        {
+            const DANGLING_END_ITEM& item = m_endPoints[ii];
+
+            if( item.GetType() == WIRE_START_END || item.GetType() == BUS_START_END )
+            {
+                // Wires and buses are stored as a start and end pair.
+                if( ii + 1 >= m_endPoints.size() )
+                    break;
+
+                const wxPoint& start = item.GetPosition();
+                const wxPoint& end = m_endPoints[++ii].GetPosition();
+
+                if( start.y == end.y )
+                    m_hSegments[ start.y ].push_back( ii - 1 );
+                else if( start.x == end.x )
+                    m_vSegments[ start.x ].push_back( ii - 1 );
+                else
+                    m_otherSegments.push_back( ii - 1 );
+            }
+            else
+            {
+                m_points[ pointKey( item.GetPosition() ) ].push_back( ii );
+            }
+        }
+    }
+
+    /**
+     * Collect the end points touching \a aPoints.  Wires and buses are copied as start and
+     * end pair, as expected by SCH_ITEM::IsDanglingStateChanged().
+     */
+    void Collect( const std::vector< wxPoint >& aPoints,
+                  std::vector< DANGLING_END_ITEM >& aItemList )
+    {
+        aItemList.clear();
+        m_collected.clear();
+
+        for( const wxPoint& pt : aPoints )
+        {
+            auto points = m_points.find( pointKey( pt ) );
+
+            if( points != m_points.end() )
+            {
+                for( size_t ii : points->second )
+                    add( ii, aItemList );
+            }
+
+            auto hSegments = m_hSegments.find( pt.y );
+
+            if( hSegments != m_hSegments.end() )
+                addSegments( hSegments->second, pt, aItemList );
+
+            auto vSegments = m_vSegments.find( pt.x );
+
+            if( vSegments != m_vSegments.end() )
+                addSegments( vSegments->second, pt, aItemList );
+
+            addSegments( m_otherSegments, pt, aItemList );
+        }
+    }
+
+private:
+    void add( size_t aIndex, std::vector< DANGLING_END_ITEM >& aItemList )
+    {
+        // An item is usually only reached through one or two of its connection points.
+        if( std::find( m_collected.begin(), m_collected.end(), aIndex ) != m_collected.end() )
+            return;
+
+        m_collected.push_back( aIndex );
+        aItemList.push_back( m_endPoints[aIndex] );
+    }
+
+    void addSegments( const std::vector< size_t >& aSegments, const wxPoint& aPoint,
+                      std::vector< DANGLING_END_ITEM >& aItemList )
+    {
+        for( size_t ii : aSegments )
+        {
+            if( !IsPointOnSegment( m_endPoints[ii].GetPosition(),
+                                   m_endPoints[ii + 1].GetPosition(), aPoint ) )
+                continue;
+
+            if( std::find( m_collected.begin(), m_collected.end(), ii ) != m_collected.end() )
+                continue;
+
+            m_collected.push_back( ii );
+            aItemList.push_back( m_endPoints[ii] );
+            aItemList.push_back( m_endPoints[ii + 1] );
+        }
+    }
+
+    const std::vector< DANGLING_END_ITEM >&                   m_endPoints;
+    std::unordered_map< long long, std::vector< size_t > >    m_points;
+    std::unordered_map< int, std::vector< size_t > >          m_hSegments;
+    std::unordered_map< int, std::vector< size_t > >          m_vSegments;
+    std::vector< size_t >                                     m_otherSegments;
+    std::vector< size_t >                                     m_collected;
+};
+
+
 bool SCH_SCREEN::TestDanglingEnds()
 {
     SCH_ITEM* item;
@@ -919,9 +1042,19 @@ bool SCH_SCREEN::TestDanglingEnds()
     for( item = m_drawList.begin(); item; item = item->Next() )
         item->GetEndPoints( endPoints );
 
+    // Each item only needs the end points at its own connection points, or the wires and
+    // buses passing through them.
+    DANGLING_END_INDEX index( endPoints );
+    std::vector< wxPoint > connections;
+    std::vector< DANGLING_END_ITEM > itemEndPoints;
+
     for( item = m_drawList.begin(); item; item = item->Next() )
     {
-        if( item->IsDanglingStateChanged( endPoints ) )
+        connections.clear();
+        item->GetConnectionPoints( connections );
+        index.Collect( connections, itemEndPoints );
+
+        if( item->IsDanglingStateChanged( itemEndPoints ) )
         {
             hasStateChanged = true;
         }
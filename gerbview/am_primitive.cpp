@@ -95,8 +95,7 @@ bool AM_PRIMITIVE::IsAMPrimitiveExposureOn( const GERBER_DRAW_ITEM* aParent ) co
 const int seg_per_circle = 64;   // Number of segments to approximate a circle
 
 void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
-                                   SHAPE_POLY_SET& aShapeBuffer,
-                                   wxPoint aShapePos )
+                                   SHAPE_POLY_SET& aShapeBuffer )
 {
     #define TO_POLY_SHAPE { aShapeBuffer.NewOutline(); \
                             for( unsigned jj = 0; jj < polybuffer.size(); jj++ )\
@@ -104,10 +103,9 @@ void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
                             aShapeBuffer.Append( polybuffer[0].x, polybuffer[0].y );}
 
     // Draw the primitive shape for flashed items.
-    static std::vector<wxPoint> polybuffer;     // create a static buffer to avoid a lot of memory reallocation
-    polybuffer.clear();
+    std::vector<wxPoint> polybuffer;    // not static: gerber files can be read concurrently
 
-    wxPoint curPos = aShapePos;
+    wxPoint curPos;     // the shape is built at origin
     D_CODE* tool   = aParent->GetDcodeDescr();
     double rotation;
 
@@ -136,13 +134,6 @@ void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
         }
 
 
-        // Move to current position:
-        for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
-        {
-            polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
-        }
-
         TO_POLY_SHAPE;
     }
     break;
@@ -170,13 +161,6 @@ void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
                 RotatePoint( &polybuffer[ii], -rotation );
         }
 
-        // Move to current position:
-        for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
-        {
-            polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
-        }
-
         TO_POLY_SHAPE;
     }
     break;
@@ -202,13 +186,6 @@ void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
                 RotatePoint( &polybuffer[ii], -rotation );
         }
 
-        // Move to current position:
-        for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
-        {
-            polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
-        }
-
         TO_POLY_SHAPE;
     }
     break;
@@ -230,13 +207,6 @@ void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
                 RotatePoint( &polybuffer[ii], -rotation );
         }
 
-        // Move to current position:
-        for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
-        {
-            polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
-        }
-
         TO_POLY_SHAPE;
     }
     break;
@@ -269,10 +239,7 @@ void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
 
             // Move to current position:
             for( unsigned jj = 0; jj < polybuffer.size(); jj++ )
-            {
                 polybuffer[jj] += curPos;
-                polybuffer[jj] = aParent->GetABPosition( polybuffer[jj] );
-            }
 
             TO_POLY_SHAPE;
         }
@@ -299,7 +266,7 @@ void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
         int numCircles = KiROUND( params[5].GetValue( tool ) );
 
         // Draw circles:
-        wxPoint center = aParent->GetABPosition( curPos );
+        wxPoint center = curPos;
         // adjust outerDiam by this on each nested circle
         int diamAdjust = (gap + penThickness) * 2;
 
@@ -332,7 +299,6 @@ void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
             RotatePoint( &polybuffer[ii], -rotation );
             // Move to current position:
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
         }
 
         TO_POLY_SHAPE;
@@ -388,13 +354,6 @@ void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
             RotatePoint( &polybuffer[ii], -rotation );
        }
 
-        // Move to current position:
-        for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
-        {
-            polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
-        }
-
         TO_POLY_SHAPE;
     }
         break;
@@ -419,7 +378,6 @@ void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
         {
             RotatePoint( &polybuffer[ii], -rotation );
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
         }
 
         TO_POLY_SHAPE;
@@ -776,36 +734,47 @@ int AM_PRIMITIVE::GetShapeDim( const GERBER_DRAW_ITEM* aParent )
 SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
                                                        wxPoint aShapePos )
 {
-    SHAPE_POLY_SET holeBuffer;
-    bool hasHole = false;
-
-    m_shape.RemoveAllContours();
+    D_CODE* tool = aParent->GetDcodeDescr();
 
-    for( AM_PRIMITIVES::iterator prim_macro = primitives.begin();
-         prim_macro != primitives.end(); ++prim_macro )
+    // The shape only depends on the D_CODE parameters, so it is built once at origin
+    // and then moved to the position of each flash.
+    if( tool->m_MacroShape.OutlineCount() == 0 )
     {
-        if( prim_macro->primitive_id == AMP_COMMENT )
-            continue;
+        SHAPE_POLY_SET& shape = tool->m_MacroShape;
+        SHAPE_POLY_SET holeBuffer;
+        bool hasHole = false;
 
-        if( prim_macro->IsAMPrimitiveExposureOn( aParent ) )
-            prim_macro->DrawBasicShape( aParent, m_shape, aShapePos );
-        else
+        for( AM_PRIMITIVES::iterator prim_macro = primitives.begin();
+             prim_macro != primitives.end(); ++prim_macro )
         {
-            prim_macro->DrawBasicShape( aParent, holeBuffer, aShapePos );
+            if( prim_macro->primitive_id == AMP_COMMENT )
+                continue;
 
-            if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
+            if( prim_macro->IsAMPrimitiveExposureOn( aParent ) )
+                prim_macro->DrawBasicShape( aParent, shape );
+            else
             {
-                m_shape.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
-                holeBuffer.RemoveAllContours();
-                hasHole = true;
+                prim_macro->DrawBasicShape( aParent, holeBuffer );
+
+                if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
+                {
+                    shape.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
+                    holeBuffer.RemoveAllContours();
+                    hasHole = true;
+                }
             }
         }
+
+        // If a hole is defined inside a polygon, we must fracture the polygon
+        // to be able to drawn it (i.e link holes by overlapping edges)
+        if( hasHole )
+            shape.Fracture( SHAPE_POLY_SET::PM_FAST );
     }
 
-    // If a hole is defined inside a polygon, we must fracture the polygon
-    // to be able to drawn it (i.e link holes by overlapping edges)
-    if( hasHole )
-        m_shape.Fracture( SHAPE_POLY_SET::PM_FAST );
+    m_shape = tool->m_MacroShape;
+
+    for( auto it = m_shape.IterateWithHoles(); it; ++it )
+        *it = aParent->GetABPosition( *it + VECTOR2I( aShapePos ) );
 
     m_boundingBox = EDA_RECT( wxPoint( 0, 0 ), wxSize( 1, 1 ) );
     auto bb = m_shape.BBox();
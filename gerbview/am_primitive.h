@@ -133,13 +133,12 @@ public: AM_PRIMITIVE( bool aGerbMetric, AM_PRIMITIVE_ID aId = AMP_UNKNOWN )
     /**
      * Function drawBasicShape
      * Draw (in fact generate the actual polygonal shape of) the primitive shape of an aperture macro instance.
+     * The shape is generated at origin, in gerber coordinates.
      * @param aParent = the parent GERBER_DRAW_ITEM which is actually drawn
      * @param aShapeBuffer = a SHAPE_POLY_SET to put the shape converted to a polygon
-     * @param aShapePos = the actual shape position
      */
     void DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
-                         SHAPE_POLY_SET& aShapeBuffer,
-                         wxPoint aShapePos );
+                         SHAPE_POLY_SET& aShapeBuffer );
 private:
 
     /**
@@ -194,7 +193,9 @@ struct APERTURE_MACRO
      * Function GetApertureMacroShape
      * Calculate the primitive shape for flashed items.
      * When an item is flashed, this is the shape of the item
+     * The shape at origin is cached in the D_CODE of aParent, and only moved to aShapePos.
      * @param aParent = the parent GERBER_DRAW_ITEM which is actually drawn
+     * @param aShapePos = the actual shape position
      * @return The shape of the item
      */
     SHAPE_POLY_SET* GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent, wxPoint aShapePos );
@@ -108,6 +108,11 @@ public:
                                              * complex shapes which are converted to polygon
                                              * (shapes with hole )
                                              */
+    SHAPE_POLY_SET        m_MacroShape;     /* Shape of the aperture macro (if any) at origin,
+                                             * for the parameters of this D_CODE.
+                                             * Calculated on the first flash, and then only
+                                             * moved to the position of each flash
+                                             */
 
 public:
     D_CODE( int num_dcode );
@@ -122,6 +127,7 @@ public:
     void AppendParam( double aValue )
     {
         m_am_params.push_back( aValue );
+        m_MacroShape.RemoveAllContours();
     }
 
     /**
@@ -151,6 +157,7 @@ public:
     void SetMacro( APERTURE_MACRO* aMacro )
     {
         m_Macro = aMacro;
+        m_MacroShape.RemoveAllContours();
     }
 
 
@@ -159,33 +159,49 @@ static EXCELLON_CMD excellon_G_CmdList[] =
 
 
 bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
+{
+    // A file loaded on a layer holding a drill image is added to this image
+    auto drill_layer = dynamic_cast<EXCELLON_IMAGE*>( GetGbrImage( GetActiveLayer() ) );
+
+    if( drill_layer == nullptr )
+        drill_layer = new EXCELLON_IMAGE( GetActiveLayer() );
+
+    // Read the Excellon drill file:
+    bool success = drill_layer->LoadFile( aFullFileName );
+
+    return addExcellonImage( drill_layer, success, aFullFileName );
+}
+
+
+bool GERBVIEW_FRAME::addExcellonImage( EXCELLON_IMAGE* aDrill, bool aLoaded,
+                                       const wxString& aFullFileName )
 {
     wxString msg;
     int layerId = GetActiveLayer();      // current layer used in GerbView
     GERBER_FILE_IMAGE_LIST* images = GetGerberLayout()->GetImagesList();
     auto gerber_layer = images->GetGbrImage( layerId );
-    auto drill_layer = dynamic_cast<EXCELLON_IMAGE*>( gerber_layer );
+    auto drill_layer = aDrill;
 
-    if( gerber_layer && !drill_layer )
+    if( gerber_layer != drill_layer )
     {
-        // The active layer contains old gerber data we have to clear
-        Erase_Current_DrawLayer( false );
-    }
+        if( gerber_layer )
+        {
+            // The active layer contains old data we have to clear
+            Erase_Current_DrawLayer( false );
+        }
 
-    if( drill_layer == nullptr )
-    {
-        drill_layer = new EXCELLON_IMAGE( layerId );
+        drill_layer->m_GraphicLayer = layerId;
         layerId = images->AddGbrImage( drill_layer, layerId );
     }
 
     if( layerId < 0 )
     {
+        delete drill_layer;
         DisplayError( this, _( "No room to load file" ) );
         return false;
     }
 
-    // Read the Excellon drill file:
-    bool success = drill_layer->LoadFile( aFullFileName );
+    bool success = aLoaded;
 
     if( !success )
     {
@@ -528,6 +528,7 @@ void GBR_TO_PCB_EXPORTER::writePcbPolygonItem( GERBER_DRAW_ITEM* aGbrItem, LAYER
     fprintf( m_fp, "(gr_poly (pts " );
 
     SHAPE_POLY_SET polys = aGbrItem->m_Polygon;
+    polys.Move( aGbrItem->m_PolygonOffset );
     SHAPE_LINE_CHAIN& poly = polys.Outline( 0 );
 
     #define MAX_COORD_CNT 4
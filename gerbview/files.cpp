@@ -26,6 +26,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+
 #include <fctsys.h>
 #include <wx/fs_zip.h>
 #include <wx/wfstream.h>
@@ -40,6 +45,7 @@
 #include <gerbview_id.h>
 #include <gerber_file_image.h>
 #include <gerber_file_image_list.h>
+#include <excellon_image.h>
 #include <gerbview_layer_widget.h>
 #include <wildcards_and_files_ext.h>
 #include <widgets/progress_reporter.h>
@@ -223,6 +229,93 @@ bool GERBVIEW_FRAME::LoadGerberFiles( const wxString& aFullFileName )
 }
 
 
+void GERBVIEW_FRAME::readFilesOnLayers( size_t aFileCount, int aLayer, std::vector<char>& aLoaded,
+                                        const std::function<void( size_t )>& aReadFile,
+                                        std::unique_ptr<WX_PROGRESS_REPORTER>& aProgress,
+                                        long long aStartTime, const wxString& aTitle )
+{
+    // Show progress dialog after 1 second of loading
+    static const long long progressShowDelay = 1000;
+
+    // The files go on the active layer, whose image is replaced, then on the free layers.
+    // A file uses its layer only if it is loaded, the next file goes on the same layer
+    // otherwise, so the files after the last free layer is used are not read.
+    size_t layersLeft = 1;
+
+    for( unsigned ii = 0; ii < ImagesMaxCount(); ++ii )
+    {
+        if( (int) ii != aLayer && GetGbrImage( ii ) == NULL )
+            layersLeft++;
+    }
+
+    // The files are read in batches of the number of layers left, so no file is read in
+    // vain.  Usually all the files fit, and they are read in a single batch.
+    size_t begin = 0;
+    size_t filesDone = 0;
+
+    while( begin < aFileCount && layersLeft > 0 )
+    {
+        size_t              end = std::min( aFileCount, begin + layersLeft );
+        std::atomic<size_t> nextFile( begin );
+        std::atomic<size_t> batchDone( 0 );
+
+        auto reader = [&]()
+        {
+            for( size_t ii = nextFile.fetch_add( 1 ); ii < end; ii = nextFile.fetch_add( 1 ) )
+            {
+                aReadFile( ii );
+                batchDone.fetch_add( 1 );
+            }
+        };
+
+        size_t parallelThreadCount = std::min<size_t>( end - begin,
+                std::max<size_t>( std::thread::hardware_concurrency(), 2 ) );
+        std::vector<std::thread> readers;
+
+        if( parallelThreadCount > 1 )
+        {
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+                readers.push_back( std::thread( reader ) );
+
+            while( batchDone.load() < end - begin )
+            {
+                if( !aProgress && wxGetUTCTimeMillis() - aStartTime > progressShowDelay )
+                {
+                    aProgress = std::make_unique<WX_PROGRESS_REPORTER>( this, aTitle, 1, false );
+                    aProgress->SetMaxProgress( aFileCount );
+                    aProgress->Report( aTitle );
+                }
+
+                if( aProgress )
+                {
+                    for( ; filesDone < begin + batchDone.load(); filesDone++ )
+                        aProgress->AdvanceProgress();
+
+                    aProgress->KeepRefreshing();
+                }
+
+                wxMilliSleep( 20 );
+            }
+
+            for( size_t ii = 0; ii < readers.size(); ++ii )
+                readers[ii].join();
+        }
+        else
+        {
+            reader();
+        }
+
+        filesDone = end;
+
+        for( ; begin < end; ++begin )
+        {
+            if( aLoaded[begin] )
+                layersLeft--;
+        }
+    }
+}
+
+
 bool GERBVIEW_FRAME::loadListOfGerberFiles( const wxString& aPath,
                                             const wxArrayString& aFilenameList )
 {
@@ -237,51 +330,64 @@ bool GERBVIEW_FRAME::loadListOfGerberFiles( const wxString& aPath,
     wxString msg;
     WX_STRING_REPORTER reporter( &msg );
 
-    // Show progress dialog after 1 second of loading
-    static const long long progressShowDelay = 1000;
-
     auto startTime = wxGetUTCTimeMillis();
     std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
 
-    for( unsigned ii = 0; ii < aFilenameList.GetCount(); ii++ )
-    {
-        if( !progress && wxGetUTCTimeMillis() - startTime > progressShowDelay )
-        {
-            progress = std::make_unique<WX_PROGRESS_REPORTER>( this,
-                            _( "Loading Gerber files..." ), 1, false );
-            progress->SetMaxProgress( aFilenameList.GetCount() - 1 );
-            progress->Report( _("Loading Gerber files..." ) );
-        }
-        else if( progress )
-        {
-            progress->KeepRefreshing();
-        }
+    // The files do not depend on each other, so they are read concurrently.
+    // They are put on their layers afterwards, in the list order.
+    size_t fileCount = aFilenameList.GetCount();
+    std::vector<wxString> fullFileNames( fileCount );
+    std::vector<std::unique_ptr<GERBER_FILE_IMAGE>> images( fileCount );
+    std::vector<char> loaded( fileCount, false );
 
+    for( size_t ii = 0; ii < fileCount; ii++ )
+    {
         filename = aFilenameList[ii];
 
         if( !filename.IsAbsolute() )
             filename.SetPath( aPath );
 
-        m_lastFileName = filename.GetFullPath();
+        fullFileNames[ii] = filename.GetFullPath();
+    }
+
+    auto readFile = [&]( size_t ii )
+    {
+        // The layer is set when the image is put on the board
+        images[ii].reset( new GERBER_FILE_IMAGE( layer ) );
+        loaded[ii] = images[ii]->LoadGerberFile( fullFileNames[ii] );
+    };
+
+    {
+        // Switch to the C locale once for all the readers, rather than letting each
+        // reader thread toggle it.
+        LOCALE_IO toggleIo;
+
+        readFilesOnLayers( fileCount, layer, loaded, readFile, progress, startTime,
+                           _( "Loading Gerber files..." ) );
+    }
+
+    for( unsigned ii = 0; ii < fileCount; ii++ )
+    {
+        m_lastFileName = fullFileNames[ii];
 
         SetActiveLayer( layer, false );
 
         visibility |= ( 1 << layer );
 
-        if( Read_GERBER_File( filename.GetFullPath() ) )
+        if( addGerberImage( images[ii].release(), loaded[ii], m_lastFileName ) )
         {
             UpdateFileHistory( m_lastFileName );
 
             layer = getNextAvailableLayer( layer );
 
-            if( layer == NO_AVAILABLE_LAYERS && ii < aFilenameList.GetCount()-1 )
+            if( layer == NO_AVAILABLE_LAYERS && ii < fileCount-1 )
             {
                 success = false;
                 reporter.Report( MSG_NO_MORE_LAYER, REPORTER::RPT_ERROR );
 
                 // Report the name of not loaded files:
                 ii += 1;
-                while( ii < aFilenameList.GetCount() )
+                while( ii < fileCount )
                 {
                     filename = aFilenameList[ii++];
                     wxString txt;
@@ -294,9 +400,6 @@ bool GERBVIEW_FRAME::loadListOfGerberFiles( const wxString& aPath,
 
             SetActiveLayer( layer, false );
         }
-
-        if( progress )
-            progress->AdvanceProgress();
     }
 
     if( !success )
@@ -378,32 +481,78 @@ bool GERBVIEW_FRAME::LoadExcellonFiles( const wxString& aFullFileName )
     wxString msg;
     WX_STRING_REPORTER reporter( &msg );
 
-    for( unsigned ii = 0; ii < filenamesList.GetCount(); ii++ )
+    auto startTime = wxGetUTCTimeMillis();
+    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+
+    // The files are read concurrently, like gerber files, and put on their layers
+    // afterwards, in the list order.
+    size_t fileCount = filenamesList.GetCount();
+    std::vector<wxString> fullFileNames( fileCount );
+    std::vector<std::unique_ptr<EXCELLON_IMAGE>> images( fileCount );
+    std::vector<char> loaded( fileCount, false );
+
+    for( size_t ii = 0; ii < fileCount; ii++ )
     {
         filename = filenamesList[ii];
 
         if( !filename.IsAbsolute() )
             filename.SetPath( currentPath );
 
-        m_lastFileName = filename.GetFullPath();
+        fullFileNames[ii] = filename.GetFullPath();
+    }
+
+    // A file loaded on a layer holding a drill image is added to this image, which is
+    // shown meanwhile: the first file is then read by Read_EXCELLON_File() when it is
+    // put on the layer.  It counts as not loaded for the number of files to read, so at
+    // worst one more file is read than there are layers.
+    bool addToActiveImage = dynamic_cast<EXCELLON_IMAGE*>( GetGbrImage( layer ) ) != NULL;
+
+    auto readFile = [&]( size_t ii )
+    {
+        if( ii == 0 && addToActiveImage )
+            return;
+
+        // The layer is set when the image is put on the board
+        images[ii].reset( new EXCELLON_IMAGE( layer ) );
+        loaded[ii] = images[ii]->LoadFile( fullFileNames[ii] );
+    };
+
+    {
+        // Switch to the C locale once for all the readers
+        LOCALE_IO toggleIo;
+
+        readFilesOnLayers( fileCount, layer, loaded, readFile, progress, startTime,
+                           _( "Loading drill files..." ) );
+    }
+
+    for( size_t ii = 0; ii < fileCount; ii++ )
+    {
+        m_lastFileName = fullFileNames[ii];
 
         SetActiveLayer( layer, false );
 
-        if( Read_EXCELLON_File( filename.GetFullPath() ) )
+        bool added;
+
+        if( ii == 0 && addToActiveImage )
+            added = Read_EXCELLON_File( m_lastFileName );
+        else
+            added = addExcellonImage( images[ii].release(), loaded[ii], m_lastFileName );
+
+        if( added )
         {
             // Update the list of recent drill files.
-            UpdateFileHistory( filename.GetFullPath(),  &m_drillFileHistory );
+            UpdateFileHistory( m_lastFileName,  &m_drillFileHistory );
 
             layer = getNextAvailableLayer( layer );
 
-            if( layer == NO_AVAILABLE_LAYERS && ii < filenamesList.GetCount()-1 )
+            if( layer == NO_AVAILABLE_LAYERS && ii < fileCount-1 )
             {
                 success = false;
                 reporter.Report( MSG_NO_MORE_LAYER, REPORTER::RPT_ERROR );
 
                 // Report the name of not loaded files:
                 ii += 1;
-                while( ii < filenamesList.GetCount() )
+                while( ii < fileCount )
                 {
                     filename = filenamesList[ii++];
                     wxString txt;
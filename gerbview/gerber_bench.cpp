@@ -0,0 +1,122 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gerber_bench.cpp
+ * measures the time spent loading gerber files and building the shapes of their
+ * flashed items, the way they are built to draw and hit test them.  The files given
+ * on the command line are used; with no arguments the files of gerber_test_files.
+ *
+ * usage: gerber_bench [file.gbr ...]
+ */
+
+#include <cstdio>
+#include <wx/init.h>
+#include <wx/dir.h>
+
+#include <kiway.h>
+#include <pgm_base.h>
+#include <profile.h>
+#include <gerber_file_image.h>
+#include <gerber_draw_item.h>
+#include <dcode.h>
+#include <am_primitive.h>
+
+
+static struct PGM_GERBER_BENCH : public PGM_BASE
+{
+    bool OnPgmInit() override { return true; }
+    void OnPgmExit() override {}
+    void MacOpenFile( const wxString& aFileName ) override {}
+} program;
+
+
+// Shapes are built each time an item is drawn or hit tested, so build them several times.
+static const int SHAPE_PASSES = 100;
+
+
+int main( int argc, char* argv[] )
+{
+    wxInitializer initializer;
+    int           kifaceVersion;
+    wxArrayString files;
+
+    KIFACE_GETTER( &kifaceVersion, KIFACE_VERSION, &program );
+
+    for( int i = 1; i < argc; ++i )
+        files.Add( wxString::FromUTF8Unchecked( argv[i] ) );
+
+    if( files.IsEmpty() )
+        wxDir::GetAllFiles( wxT( GERBER_TEST_FILES_DIR ), &files, wxT( "*.gbr" ) );
+
+    files.Sort();
+
+    for( const wxString& fname : files )
+    {
+        GERBER_FILE_IMAGE image( 0 );
+
+        PROF_COUNTER load( std::string( "load " ) + (const char*) fname.ToUTF8() );
+
+        if( !image.LoadGerberFile( fname ) )
+        {
+            fprintf( stderr, "cannot load %s\n", (const char*) fname.ToUTF8() );
+            return 1;
+        }
+
+        load.Stop();
+
+        int flashes = 0;
+        int vertices = 0;
+
+        PROF_COUNTER shapes( "build flashed shapes" );
+
+        for( int pass = 0; pass < SHAPE_PASSES; ++pass )
+        {
+            for( GERBER_DRAW_ITEM* item = image.GetItemsList(); item; item = item->Next() )
+            {
+                D_CODE* code = item->GetDcodeDescr();
+
+                if( item->m_Shape != GBR_SPOT_MACRO || !code )
+                    continue;
+
+                SHAPE_POLY_SET* shape = code->GetMacro()->GetApertureMacroShape( item,
+                                                                                 item->m_Start );
+                flashes++;
+                vertices += shape->TotalVertices();
+            }
+        }
+
+        shapes.Stop();
+
+        load.Show();
+
+        if( flashes )
+        {
+            printf( "%d macro flashes, %d vertices\n", flashes / SHAPE_PASSES,
+                    vertices / SHAPE_PASSES );
+            shapes.Show();
+        }
+    }
+
+    return 0;
+}
@@ -299,7 +299,8 @@ const EDA_RECT GERBER_DRAW_ITEM::GetBoundingBox() const
     {
         auto bb = m_Polygon.BBox();
         bbox.Inflate( bb.GetWidth() / 2, bb.GetHeight() / 2 );
-        bbox.SetOrigin( bb.GetOrigin().x, bb.GetOrigin().y );
+        bbox.SetOrigin( bb.GetOrigin().x + m_PolygonOffset.x,
+                        bb.GetOrigin().y + m_PolygonOffset.y );
         break;
     }
 
@@ -375,7 +376,8 @@ const EDA_RECT GERBER_DRAW_ITEM::GetBoundingBox() const
             {
                 auto bb = m_Polygon.BBox();
                 bbox.Inflate( bb.GetWidth() / 2, bb.GetHeight() / 2 );
-                bbox.SetOrigin( bb.GetOrigin().x, bb.GetOrigin().y );
+                bbox.SetOrigin( bb.GetOrigin().x + m_PolygonOffset.x,
+                                bb.GetOrigin().y + m_PolygonOffset.y );
             }
         }
         else
@@ -415,29 +417,19 @@ void GERBER_DRAW_ITEM::MoveAB( const wxPoint& aMoveVector )
 {
     wxPoint xymove = GetXYPosition( aMoveVector );
 
-    m_Start     += xymove;
-    m_End       += xymove;
-    m_ArcCentre += xymove;
-
-    if( m_Polygon.OutlineCount() > 0 )
-    {
-        for( auto it = m_Polygon.Iterate( 0 ); it; ++it )
-            *it += xymove;
-    }
+    m_Start         += xymove;
+    m_End           += xymove;
+    m_ArcCentre     += xymove;
+    m_PolygonOffset += xymove;
 }
 
 
 void GERBER_DRAW_ITEM::MoveXY( const wxPoint& aMoveVector )
 {
-    m_Start     += aMoveVector;
-    m_End       += aMoveVector;
-    m_ArcCentre += aMoveVector;
-
-    if( m_Polygon.OutlineCount() > 0 )
-    {
-        for( auto it = m_Polygon.Iterate( 0 ); it; ++it )
-            *it += aMoveVector;
-    }
+    m_Start         += aMoveVector;
+    m_End           += aMoveVector;
+    m_ArcCentre     += aMoveVector;
+    m_PolygonOffset += aMoveVector;
 }
 
 
@@ -595,6 +587,8 @@ void GERBER_DRAW_ITEM::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDC, GR_DRAWMODE aDra
 
 void GERBER_DRAW_ITEM::ConvertSegmentToPolygon()
 {
+    // The polygon is built from m_Start, which already includes any move
+    m_PolygonOffset = wxPoint( 0, 0 );
     m_Polygon.RemoveAllContours();
     m_Polygon.NewOutline();
 
@@ -667,15 +661,15 @@ void GERBER_DRAW_ITEM::DrawGbrPoly( EDA_RECT*      aClipBox,
                                     bool           aFilledShape )
 {
     std::vector<wxPoint> points;
-    SHAPE_LINE_CHAIN& poly = m_Polygon.Outline( 0 );
+    const SHAPE_LINE_CHAIN& poly = m_Polygon.COutline( 0 );
     int pointCount = poly.PointCount() - 1;
 
     points.reserve( pointCount );
 
     for( int ii = 0; ii < pointCount; ii++ )
     {
-        wxPoint p( poly.Point( ii ).x, poly.Point( ii ).y );
-        points[ii] = p + aOffset;
+        wxPoint p( poly.CPoint( ii ).x, poly.CPoint( ii ).y );
+        points[ii] = p + m_PolygonOffset + aOffset;
         points[ii] = GetABPosition( points[ii] );
     }
 
@@ -804,8 +798,7 @@ bool GERBER_DRAW_ITEM::HitTest( const wxPoint& aRefPos ) const
     switch( m_Shape )
     {
     case GBR_POLYGON:
-        poly = m_Polygon;
-        return poly.Contains( VECTOR2I( ref_pos ), 0 );
+        return m_Polygon.Contains( VECTOR2I( ref_pos - m_PolygonOffset ), 0 );
 
     case GBR_SPOT_POLY:
         poly = GetDcodeDescr()->m_Polygon;
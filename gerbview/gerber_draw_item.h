@@ -84,6 +84,8 @@ public:
     wxPoint m_ArcCentre;                    // for arcs only: Centre of arc
     SHAPE_POLY_SET m_Polygon;               // Polygon shape data (G36 to G37 coordinates)
                                             // or for complex shapes which are converted to polygon
+    wxPoint m_PolygonOffset;                // Move of m_Polygon: items copied by a step and
+                                            // repeat share the polygon of the repeated item
     wxSize  m_Size;                         // Flashed shapes: size of the shape
                                             // Lines : m_Size.x = m_Size.y = line width
     bool    m_Flashed;                      // True for flashed items
@@ -184,6 +186,7 @@ public:
      /**
      * Function MoveXY
      * move this object.
+     * m_Polygon is not modified: the move is added to m_PolygonOffset.
      * @param aMoveVector - the move vector for this object, in XY gerber axis.
      */
     void MoveXY( const wxPoint& aMoveVector );
@@ -293,6 +293,7 @@ void GERBER_FILE_IMAGE::InitToolTable()
  * This function must be called when reading a gerber file and
  * after creating a new gerber item that must be repeated
  * (i.e when m_XRepeatCount or m_YRepeatCount are > 1)
+ * The copies share the polygon of aItem, moved by their m_PolygonOffset
  * @param aItem = the item to repeat
  */
 void GERBER_FILE_IMAGE::StepAndRepeatItem( const GERBER_DRAW_ITEM& aItem )
@@ -363,6 +363,7 @@ public:
      * This function must be called when reading a gerber file and
      * after creating a new gerber item that must be repeated
      * (i.e when m_XRepeatCount or m_YRepeatCount are > 1)
+     * The copies share the polygon of aItem, moved by their m_PolygonOffset
      * @param aItem = the item to repeat
      */
     void            StepAndRepeatItem( const GERBER_DRAW_ITEM& aItem );
@@ -27,6 +27,10 @@
 #define  WX_GERBER_STRUCT_H
 
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include <config_params.h>
 #include <draw_frame.h>
 #include <layers_id_colors_and_visibility.h>
@@ -48,7 +52,9 @@ class GBR_LAYER_BOX_SELECTOR;
 class GERBER_DRAW_ITEM;
 class GERBER_FILE_IMAGE;
 class GERBER_FILE_IMAGE_LIST;
+class EXCELLON_IMAGE;
 class REPORTER;
+class WX_PROGRESS_REPORTER;
 
 
 /**
@@ -218,6 +224,44 @@ private:
      */
     bool loadListOfGerberFiles( const wxString& aPath, const wxArrayString& aFilenameList );
 
+    /**
+     * Puts an already read gerber image on the active layer, replacing the current one,
+     * and reports the messages found when reading it.
+     * @param aGerber is the gerber image; the images list takes ownership of it
+     * @param aLoaded is the value returned by GERBER_FILE_IMAGE::LoadGerberFile()
+     * @param aFullFileName is the file the image was read from
+     * @return aLoaded
+     */
+    bool addGerberImage( GERBER_FILE_IMAGE* aGerber, bool aLoaded,
+                         const wxString& aFullFileName );
+
+    /**
+     * Puts an already read drill image on the active layer, and reports the messages found
+     * when reading it.  The current image of the layer is replaced, unless it is aDrill.
+     * @param aDrill is the drill image; the images list takes ownership of it
+     * @param aLoaded is the value returned by EXCELLON_IMAGE::LoadFile()
+     * @param aFullFileName is the file the image was read from
+     * @return true if the image was loaded and put on the layer
+     */
+    bool addExcellonImage( EXCELLON_IMAGE* aDrill, bool aLoaded, const wxString& aFullFileName );
+
+    /**
+     * Reads the files of a list which is to be put on layers from aLayer, concurrently.
+     * The files which would not get a layer are not read: each file loaded uses a layer.
+     * @param aFileCount is the number of files of the list
+     * @param aLayer is the layer the first file goes on
+     * @param aLoaded receives for each file read if it was loaded
+     * @param aReadFile reads the file of the given index and sets its aLoaded entry; it is
+     *                  called from worker threads
+     * @param aProgress receives the progress reporter, shown if reading takes more than a
+     *                  second from aStartTime
+     * @param aTitle is the title of the progress reporter
+     */
+    void readFilesOnLayers( size_t aFileCount, int aLayer, std::vector<char>& aLoaded,
+                            const std::function<void( size_t )>& aReadFile,
+                            std::unique_ptr<WX_PROGRESS_REPORTER>& aProgress,
+                            long long aStartTime, const wxString& aTitle );
+
 public:
     GERBVIEW_FRAME( KIWAY* aKiway, wxWindow* aParent );
     ~GERBVIEW_FRAME();
@@ -257,6 +257,7 @@ void GERBVIEW_PAINTER::draw( /*const*/ GERBER_DRAW_ITEM* aItem, int aLayer )
             m_gal->SetLineWidth( m_gerbviewSettings.m_outlineWidth );
 
         SHAPE_POLY_SET absolutePolygon = aItem->m_Polygon;
+        absolutePolygon.Move( aItem->m_PolygonOffset );
 
         for( auto it = absolutePolygon.Iterate( 0 ); it; ++it )
             *it = aItem->GetABPosition( *it );
@@ -354,7 +355,10 @@ void GERBVIEW_PAINTER::draw( /*const*/ GERBER_DRAW_ITEM* aItem, int aLayer )
         {
             if( aItem->m_Polygon.OutlineCount() == 0 )
                 aItem->ConvertSegmentToPolygon();
-            drawPolygon( aItem, aItem->m_Polygon, isFilled );
+
+            SHAPE_POLY_SET poly = aItem->m_Polygon;
+            poly.Move( aItem->m_PolygonOffset );
+            drawPolygon( aItem, poly, isFilled );
         }
         else
         {
@@ -38,6 +38,18 @@
 /* Read a gerber file, RS274D, RS274X or RS274X2 format.
  */
 bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
+{
+    GERBER_FILE_IMAGE* gerber = new GERBER_FILE_IMAGE( GetActiveLayer() );
+
+    /* Read the gerber file */
+    bool success = gerber->LoadGerberFile( GERBER_FullFileName );
+
+    return addGerberImage( gerber, success, GERBER_FullFileName );
+}
+
+
+bool GERBVIEW_FRAME::addGerberImage( GERBER_FILE_IMAGE* aGerber, bool aLoaded,
+                                     const wxString& aFullFileName )
 {
     wxString msg;
 
@@ -50,15 +62,13 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
         Erase_Current_DrawLayer( false );
     }
 
-    gerber = new GERBER_FILE_IMAGE( layer );
+    gerber = aGerber;
+    gerber->m_GraphicLayer = layer;
     images->AddGbrImage( gerber, layer );
 
-    /* Read the gerber file */
-    bool success = gerber->LoadGerberFile( GERBER_FullFileName );
-
-    if( !success )
+    if( !aLoaded )
     {
-        msg.Printf( _( "File \"%s\" not found" ), GetChars( GERBER_FullFileName ) );
+        msg.Printf( _( "File \"%s\" not found" ), GetChars( aFullFileName ) );
         DisplayError( this, msg, 10 );
         return false;
     }
@@ -108,8 +118,6 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
 // size of a single line of text from a gerber file.
 // warning: some files can have *very long* lines, so the buffer must be large.
 #define GERBER_BUFZ 1000000
-// A large buffer to store one line
-static char lineBuffer[GERBER_BUFZ+1];
 
 bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 {
@@ -117,6 +125,11 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
     int      D_commande = 0;       // command number for D commands like D02
     char*    text;
 
+    // A large buffer to store one line.  It is not shared, so several files can be
+    // read at the same time.
+    std::vector<char> buffer( GERBER_BUFZ + 1 );
+    char*    lineBuffer = buffer.data();
+
     ClearMessageList( );
     ResetDefaultValues();
 
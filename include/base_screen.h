@@ -78,6 +78,7 @@ class BASE_SCREEN : public EDA_ITEM
 private:
     GRIDS       m_grids;            ///< List of valid grid sizes.
     bool        m_FlagModified;     ///< Indicates current drawing has been modified.
+    unsigned    m_ModifySerial;     ///< Serial number of the last modification.
     bool        m_FlagSave;         ///< Indicates automatic file save.
     EDA_ITEM*   m_CurrentItem;      ///< Currently selected object
     GRID_TYPE   m_Grid;             ///< Current grid selection.
@@ -321,13 +322,22 @@ public:
         }
     }
 
-    void SetModify()        { m_FlagModified = true; }
+    void SetModify();
     void ClrModify()        { m_FlagModified = false; }
     void SetSave()          { m_FlagSave = true; }
     void ClrSave()          { m_FlagSave = false; }
     bool IsModify() const   { return m_FlagModified; }
     bool IsSave() const     { return m_FlagSave; }
 
+    /**
+     * Function GetModifySerial
+     * returns the serial number of the last modification of this drawing (the last
+     * SetModify() call).  Serial numbers increase with each modification of any screen,
+     * so data derived from drawings can record the greatest one to tell if they are
+     * outdated, even after the drawing was saved and IsModify() was cleared.
+     */
+    unsigned GetModifySerial() const { return m_ModifySerial; }
+
 
     //----<zoom stuff>---------------------------------------------------------
 
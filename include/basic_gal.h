@@ -117,6 +117,7 @@ public:
      * @param aPointList is a list of 2D-Vectors containing the polyline points.
      */
     virtual void DrawPolyline( const std::deque<VECTOR2D>& aPointList ) override;
+    virtual void DrawPolyline( const VECTOR2D aPointList[], int aListSize ) override;
 
     /** Start and end points are defined as 2D-Vectors.
      * @param aStartPoint   is the start point of the line.
@@ -149,6 +150,9 @@ private:
     // Apply the roation/translation transform to aPoint
     const VECTOR2D transform( const VECTOR2D& aPoint ) const;
 
+    // Draw a polyline whose corners are already transformed
+    void drawPolyline( std::vector<wxPoint>& aCorners );
+
     // A clip box, to clip drawings in a wxDC (mandatory to avoid draw issues)
     EDA_RECT  m_clipBox;        // The clip box
     bool      m_isClipped;      // Allows/disallows clipping
@@ -165,6 +169,6 @@ private:
 };
 
 
-extern BASIC_GAL basic_gal;
+extern thread_local BASIC_GAL basic_gal;
 
 #endif      // define BASIC_GAL_H
@@ -319,6 +319,15 @@ public:
      */
     static std::string FormatInternalUnits( int aValue );
 
+#ifndef SWIG
+    /**
+     * Function FormatInternalUnits
+     * writes the text of FormatInternalUnits( int ) to \a aBuffer, without building a string.
+     * @return a pointer to the terminating nul of the text written in \a aBuffer.
+     */
+    static char* FormatInternalUnits( char* aBuffer, int aValue );
+#endif
+
     /**
      * Function FormatAngle
      * converts \a aAngle from board units to a string appropriate for writing to file.
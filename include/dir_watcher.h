@@ -0,0 +1,78 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DIR_WATCHER_H
+#define DIR_WATCHER_H
+
+#include <wx/string.h>
+
+/**
+ * Tells if the content of a directory has changed since the watcher was created.
+ *
+ * When the system can send change notifications (inotify on Linux, for local file systems
+ * only), any change to the directory or to one of its files is seen without accessing the
+ * files.  Otherwise only the modification time of the directory is checked: it changes when
+ * a file is added, removed or renamed, but not when a file is modified in place, so callers
+ * must check the files themselves when IsWatching() is false.
+ *
+ * Unlike wxFileSystemWatcher, it does not need an event loop and can be used from any
+ * thread.
+ */
+class DIR_WATCHER
+{
+public:
+    DIR_WATCHER( const wxString& aDirPath );
+    ~DIR_WATCHER();
+
+    /**
+     * @return true if the directory is watched through change notifications.
+     */
+    bool IsWatching() const { return m_watch >= 0; }
+
+    /**
+     * @return true if the directory or one of its files may have changed since the watcher
+     *         was created.
+     */
+    bool IsModified();
+
+    /**
+     * Sum the modification times of a directory and of its files, to compare the content
+     * of a directory which is not watched.  The modification time of a symbolic link is the
+     * one of its target.
+     *
+     * @param aDirPath is the directory.
+     * @param aWildcard selects the files, e.g. "*.kicad_mod".
+     * @param aHasSymlinks, if not NULL, is set to true if one of the files is a symbolic
+     *                     link: a change to its target is not notified to a watcher of
+     *                     the directory, and the files must be checked with this timestamp.
+     * @return the timestamp, or 0 if the directory cannot be read.
+     */
+    static long long Timestamp( const wxString& aDirPath, const wxString& aWildcard,
+                                bool* aHasSymlinks = NULL );
+
+private:
+    wxString            m_path;
+    int                 m_watch;        ///< watch descriptor, or -1 if not watching
+    unsigned long long  m_events;       ///< count of events received when created
+    long long           m_dir_time;     ///< directory modification time when created
+
+    long long dirTime() const;
+};
+
+#endif // DIR_WATCHER_H
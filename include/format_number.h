@@ -0,0 +1,63 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file format_number.h
+ * @brief Number formatting without printf() nor the locale.
+ *
+ * These functions do not depend on wxWidgets, so that the files which use them can also be
+ * built in the 3D plugins and the tools which do not link the common library.
+ */
+
+#ifndef FORMAT_NUMBER_H
+#define FORMAT_NUMBER_H
+
+/**
+ * Function FormatInt
+ * writes \a aValue in decimal to \a aBuffer, as sprintf( aBuffer, "%0*lld", aWidth, aValue )
+ * does, but without parsing a format string.  The result is padded with zeros after the
+ * sign up to \a aWidth characters.
+ * @return a pointer to the terminating nul of the string written in \a aBuffer.
+ */
+char* FormatInt( char* aBuffer, long long aValue, int aWidth = 0 );
+
+/**
+ * Function FormatFixed
+ * writes \a aValue with \a aDigits decimals to \a aBuffer, as
+ * sprintf( aBuffer, "%.*f", aDigits, aValue ) does in the C locale, whatever the current
+ * locale.  The value is rounded exactly, like printf, so the results are identical.
+ * \a aBuffer must have room for all the integer digits of \a aValue.
+ * @return a pointer to the terminating nul of the string written in \a aBuffer.
+ */
+char* FormatFixed( char* aBuffer, double aValue, int aDigits );
+
+/**
+ * Function FormatDecimal
+ * writes the exact value of \a aValue / 10^\a aDecimals to \a aBuffer with the shortest
+ * text, i.e. without trailing zeros in the decimals, nor a decimal point for integer
+ * values: FormatDecimal( buf, -1250000, 6 ) writes "-1.25".  No locale is involved.
+ * @return a pointer to the terminating nul of the string written in \a aBuffer.
+ */
+char* FormatDecimal( char* aBuffer, long long aValue, int aDecimals );
+
+#endif  // FORMAT_NUMBER_H
@@ -30,6 +30,7 @@
 #define STROKE_FONT_H_
 
 #include <deque>
+#include <memory>
 #include <algorithm>
 
 #include <utf8.h>
@@ -42,13 +43,14 @@ namespace KIGFX
 {
 class GAL;
 
-typedef std::deque< std::deque<VECTOR2D> > GLYPH;
-typedef std::vector<GLYPH>                 GLYPH_LIST;
-
 /**
  * @brief Class STROKE_FONT implements stroke font drawing.
  *
  * A stroke font is composed of lines.
+ *
+ * The glyphs of a font are parsed once and shared by all the STROKE_FONT instances, and
+ * the lines of text already laid out are kept in a cache shared by all the instances too,
+ * because the GAL canvases, the plotters and DRC all draw the same texts.
  */
 class STROKE_FONT
 {
@@ -116,9 +118,18 @@ public:
 
 
 private:
-    GAL*                m_gal;                  ///< Pointer to the GAL
-    GLYPH_LIST          m_glyphs;               ///< Glyph list
-    std::vector<BOX2D>  m_glyphBoundingBoxes;   ///< Bounding boxes of the glyphs
+    struct GLYPH_TABLE;
+    struct TEXT_LAYOUT;
+    class TEXT_LAYOUT_CACHE;
+
+    GAL*                                m_gal;      ///< Pointer to the GAL
+    std::shared_ptr<const GLYPH_TABLE>  m_glyphs;   ///< Glyphs and their bounding boxes
+
+    /**
+     * @brief Parse the glyphs of a font.
+     */
+    static std::shared_ptr<const GLYPH_TABLE> parseFont( const char* const aNewStrokeFont[],
+                                                         int aNewStrokeFontSize );
 
     /**
      * @brief Compute the X and Y size of a given text. The text is expected to be
@@ -146,11 +157,12 @@ private:
     /**
      * @brief Compute the bounding box of a given glyph.
      *
-     * @param aGlyph is the glyph.
+     * @param aPoints are the points of the glyph strokes.
      * @param aGlyphBoundingX is the x-component of the bounding box size.
      * @return is the complete bounding box size.
      */
-    BOX2D computeBoundingBox( const GLYPH& aGlyph, const VECTOR2D& aGlyphBoundingX ) const;
+    static BOX2D computeBoundingBox( const std::vector<VECTOR2D>& aPoints,
+                                     const VECTOR2D& aGlyphBoundingX );
 
     /**
      * @brief Draws a single line of text. Multiline texts should be split before using the
@@ -160,6 +172,16 @@ private:
      */
     void drawSingleLineText( const UTF8& aText );
 
+    /**
+     * @brief Lays out the strokes of a single line of text with the current GAL text
+     * attributes, before the justification.  The layout comes from the cache when the same
+     * line was already laid out with the same attributes.
+     *
+     * @param aText is the text (one line).
+     * @return the strokes of the text.
+     */
+    std::shared_ptr<const TEXT_LAYOUT> layoutSingleLineText( const UTF8& aText ) const;
+
     /**
      * @brief Returns number of lines for a given text.
      *
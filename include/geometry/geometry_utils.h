@@ -42,6 +42,19 @@
  */
 int GetArcToSegmentCount( int aRadius, int aErrorMax, double aArcAngleDegree );
 
+/**
+ * @return the number of segments to approximate a circle by segments with a given max
+ * error, but no more than a given count: a small circle needs fewer segments than the
+ * count chosen for the largest ones.
+ * The count is a multiple of 4, so half and quarter circles (e.g. the ends of ovals and
+ * the corners of inflated rectangles) have a whole number of segments, and is >= 8
+ * unless aMaxSegCount is smaller.
+ * @param aRadius is the radius of the circle
+ * @param aErrorMax is the max error
+ * @param aMaxSegCount is the max number of segments
+ */
+int GetCircleToSegmentCount( int aRadius, int aErrorMax, int aMaxSegCount );
+
 /**
  * @return the correction factor to approximate a circle by segments
  * @param aSegCountforCircle is the number of segments to approximate the circle
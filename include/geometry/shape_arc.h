@@ -68,6 +68,24 @@ public:
     bool Collide( const SEG& aSeg, int aClearance = 0 ) const override;
     bool Collide( const VECTOR2I& aP, int aClearance = 0 ) const override;
 
+    /**
+     * Computes the minimum distance between the arc (its center line, the width is not
+     * taken into account) and the point aP.
+     */
+    int Distance( const VECTOR2I& aP ) const;
+
+    /**
+     * Computes the minimum distance between the arc (its center line, the width is not
+     * taken into account) and the segment aSeg.
+     */
+    int Distance( const SEG& aSeg ) const;
+
+    /**
+     * Computes the minimum distance between the arc and the arc aArc (their center lines,
+     * the widths are not taken into account).
+     */
+    int Distance( const SHAPE_ARC& aArc ) const;
+
     void SetWidth( int aWidth )
     {
         m_width = aWidth;
@@ -89,6 +107,22 @@ public:
         m_pc += aVector;
     }
 
+    /**
+     * Function Rotate
+     * rotates the arc by a given angle
+     * @param aAngle rotation angle in radians
+     * @param aCenter is the rotation center
+     */
+    void Rotate( double aAngle, const VECTOR2I& aCenter );
+
+    /**
+     * @return the same arc, going from its end point to its start point.
+     */
+    const SHAPE_ARC Reversed() const
+    {
+        return SHAPE_ARC( m_pc, GetP1(), -m_centralAngle, m_width );
+    }
+
     int GetRadius() const;
 
     SEG GetChord() const
@@ -120,12 +154,16 @@ public:
      *      Other programs should call this using explicit accuracy values
      *      TODO: unify KiCad internal units
      *
-     * @return a SHAPE_LINE_CHAIN
+     * @return a SHAPE_LINE_CHAIN going from GetP0() to GetP1()
      */
     const SHAPE_LINE_CHAIN ConvertToPolyline( double aAccuracy = 500.0 ) const;
 
 private:
 
+    /// @return true if the half line going from the center in the direction aDir crosses
+    /// the arc.
+    bool sweeps( const VECTOR2D& aDir ) const;
+
     bool ccw( const VECTOR2I& aA, const VECTOR2I& aB, const VECTOR2I& aC ) const
     {
         return (ecoord) ( aC.y - aA.y ) * ( aB.x - aA.x ) >
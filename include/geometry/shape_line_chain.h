@@ -33,6 +33,7 @@
 
 #include <math/vector2d.h>
 #include <geometry/shape.h>
+#include <geometry/shape_arc.h>
 #include <geometry/seg.h>
 
 /**
@@ -43,6 +44,12 @@
  * class in pcbnew.
  *
  * SHAPE_LINE_CHAIN class shall not be used for polygons!
+ *
+ * Arcs can be appended: they are approximated by segments like any other part of the
+ * line chain, but the chain remembers which segments approximate which arc.  Collisions
+ * and distances are then computed on the exact arcs, and the arcs can be approximated
+ * again with another accuracy (see ConvertArcs()).  Editing the points of an arc turns
+ * its segments back into plain segments.
  */
 class SHAPE_LINE_CHAIN : public SHAPE
 {
@@ -80,7 +87,8 @@ public:
      * Copy Constructor
      */
     SHAPE_LINE_CHAIN( const SHAPE_LINE_CHAIN& aShape ) :
-        SHAPE( SH_LINE_CHAIN ), m_points( aShape.m_points ), m_closed( aShape.m_closed )
+        SHAPE( SH_LINE_CHAIN ), m_points( aShape.m_points ), m_arcs( aShape.m_arcs ),
+        m_shapes( aShape.m_shapes ), m_closed( aShape.m_closed )
     {}
 
     /**
@@ -137,6 +145,8 @@ public:
     void Clear()
     {
         m_points.clear();
+        m_arcs.clear();
+        m_shapes.clear();
         m_closed = false;
     }
 
@@ -188,6 +198,17 @@ public:
         return m_points.size();
     }
 
+    /**
+     * Function Reserve()
+     *
+     * Allocates room for aSize points, so appending up to aSize points does not reallocate.
+     * @param aSize is the expected number of points
+     */
+    void Reserve( int aSize )
+    {
+        m_points.reserve( aSize );
+    }
+
     /**
      * Function Segment()
      *
@@ -240,6 +261,16 @@ public:
         if( aIndex < 0 )
             aIndex += PointCount();
 
+        // the point may be moved
+        if( !m_shapes.empty() )
+        {
+            breakArcs( aIndex - 1, aIndex );
+
+            // the first point also ends the closing segment
+            if( aIndex == 0 && m_closed )
+                breakArcs( PointCount() - 1, PointCount() - 1 );
+        }
+
         return m_points[aIndex];
     }
 
@@ -265,7 +296,7 @@ public:
      */
     VECTOR2I& LastPoint()
     {
-        return m_points[PointCount() - 1];
+        return Point( PointCount() - 1 );
     }
 
     /**
@@ -276,12 +307,48 @@ public:
         return m_points[PointCount() - 1];
     }
 
+    /**
+     * Function ArcIndex()
+     *
+     * @param aSegment index of a segment of the line chain.
+     * @return the index of the arc approximated by the segment, or -1 if it is a plain
+     * segment.
+     */
+    int ArcIndex( int aSegment ) const
+    {
+        if( m_shapes.empty() )
+            return -1;
+
+        if( aSegment < 0 )
+            aSegment += SegmentCount();
+
+        return m_shapes[aSegment];
+    }
+
+    /**
+     * Function Arc()
+     *
+     * @param aArc index of the arc, as returned by ArcIndex().
+     * @return the exact arc.
+     */
+    const SHAPE_ARC& Arc( int aArc ) const
+    {
+        return m_arcs[aArc];
+    }
+
     /// @copydoc SHAPE::BBox()
     const BOX2I BBox( int aClearance = 0 ) const override
     {
         BOX2I bbox;
         bbox.Compute( m_points );
 
+        // the segments approximating an arc are inside of it
+        for( size_t i = 0; i < m_shapes.size(); i++ )
+        {
+            if( m_shapes[i] >= 0 && ( i == 0 || m_shapes[i - 1] != m_shapes[i] ) )
+                bbox.Merge( m_arcs[m_shapes[i]].BBox() );
+        }
+
         if( aClearance != 0 )
             bbox.Inflate( aClearance );
 
@@ -367,6 +434,9 @@ public:
         {
             m_points.push_back( aP );
             m_bbox.Merge( aP );
+
+            if( !m_shapes.empty() )
+                m_shapes.push_back( -1 );
         }
     }
 
@@ -376,30 +446,20 @@ public:
      * Appends another line chain at the end.
      * @param aOtherLine the line chain to be appended.
      */
-    void Append( const SHAPE_LINE_CHAIN& aOtherLine )
-    {
-        if( aOtherLine.PointCount() == 0 )
-            return;
-
-        else if( PointCount() == 0 || aOtherLine.CPoint( 0 ) != CPoint( -1 ) )
-        {
-            const VECTOR2I p = aOtherLine.CPoint( 0 );
-            m_points.push_back( p );
-            m_bbox.Merge( p );
-        }
+    void Append( const SHAPE_LINE_CHAIN& aOtherLine );
 
-        for( int i = 1; i < aOtherLine.PointCount(); i++ )
-        {
-            const VECTOR2I p = aOtherLine.CPoint( i );
-            m_points.push_back( p );
-            m_bbox.Merge( p );
-        }
-    }
+    /**
+     * Function Append()
+     *
+     * Appends an arc at the end of the line chain, approximated by segments.  The arc
+     * itself is kept for collisions and for ConvertArcs().  Its width is not used.
+     * @param aArc the arc to be appended.
+     * @param aAccuracy maximum divergence between the segments and the arc, in internal
+     * units.
+     */
+    void Append( const SHAPE_ARC& aArc, double aAccuracy );
 
-    void Insert( int aVertex, const VECTOR2I& aP )
-    {
-        m_points.insert( m_points.begin() + aVertex, aP );
-    }
+    void Insert( int aVertex, const VECTOR2I& aP );
 
     /**
      * Function Replace()
@@ -570,6 +630,7 @@ public:
      * Function Simplify()
      *
      * Simplifies the line chain by removing colinear adjacent segments and duplicate vertices.
+     * The arcs are turned into plain segments.
      * @return reference to self.
      */
     SHAPE_LINE_CHAIN& Simplify();
@@ -615,10 +676,23 @@ public:
 
     bool CompareGeometry( const SHAPE_LINE_CHAIN& aOther ) const;
 
+    /**
+     * Function ConvertArcs()
+     *
+     * Approximates the arcs of the line chain again, from the exact arcs.
+     * @param aAccuracy maximum divergence between the segments and the arcs, in internal
+     * units.
+     * @return line chain with the same plain segments and arcs.
+     */
+    const SHAPE_LINE_CHAIN ConvertArcs( double aAccuracy ) const;
+
     void Move( const VECTOR2I& aVector ) override
     {
         for( std::vector<VECTOR2I>::iterator i = m_points.begin(); i != m_points.end(); ++i )
             (*i) += aVector;
+
+        for( SHAPE_ARC& arc : m_arcs )
+            arc.Move( aVector );
     }
 
     /**
@@ -639,9 +713,22 @@ public:
     double Area() const;
 
 private:
+    /**
+     * Turns the arcs approximated by one of the segments in the [aFirst, aLast] range into
+     * plain segments, because these segments are modified.
+     */
+    void breakArcs( int aFirst, int aLast );
+
     /// array of vertices
     std::vector<VECTOR2I> m_points;
 
+    /// arcs approximated by segments of the line chain
+    std::vector<SHAPE_ARC> m_arcs;
+
+    /// for each segment (the one starting at the point with the same index), index in
+    /// m_arcs of the arc it approximates, or -1.  Empty if the line chain has no arcs.
+    std::vector<int> m_shapes;
+
     /// is the line chain closed?
     bool m_closed;
 
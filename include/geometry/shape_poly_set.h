@@ -29,6 +29,7 @@
 #include <vector>
 #include <cstdio>
 #include <memory>
+#include <atomic>
 #include <geometry/shape.h>
 #include <geometry/shape_line_chain.h>
 
@@ -51,6 +52,12 @@
  *      outline or a hole.
  *      - Vertex (or corner): each one of the points that define a contour.
  *
+ * Copies of a set share their polygons until one of them is modified (copy on write), so
+ * copying large sets (e.g. zone fills kept in the undo list) is cheap.  The non-const
+ * accessors make the polygons unique to the set before returning, so a reference obtained
+ * from them must not be kept across a copy of the set, and they must not be called from
+ * several threads at once on the same set; use the const accessors to read.
+ *
  * TODO: add convex partitioning & spatial index
  */
 class SHAPE_POLY_SET : public SHAPE
@@ -422,11 +429,14 @@ class SHAPE_POLY_SET : public SHAPE
 
         /**
          * Copy constructor SHAPE_POLY_SET
-         * Performs a deep copy of \p aOther into \p this.
+         * Makes \p this share the polygons of \p aOther; they are copied when one of the sets
+         * is modified.
          * @param aOther is the SHAPE_POLY_SET object that will be copied.
          */
         SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther );
 
+        SHAPE_POLY_SET( SHAPE_POLY_SET&& aOther );
+
         ~SHAPE_POLY_SET();
 
         /**
@@ -850,6 +860,75 @@ class SHAPE_POLY_SET : public SHAPE
         ///> For aFastMode meaning, see function booleanOp
         void Simplify( POLYGON_MODE aFastMode );
 
+        /**
+         * Class BOOLEAN_PIPELINE
+         *
+         * Chains boolean operations and inflations on a copy of a set, keeping the intermediate
+         * results in Clipper's format instead of converting them to SHAPE_LINE_CHAINs and back
+         * after each operation.  The result is the same as the one of the same operations done
+         * on a SHAPE_POLY_SET.
+         */
+        class BOOLEAN_PIPELINE
+        {
+        public:
+            BOOLEAN_PIPELINE( const SHAPE_POLY_SET& aSource );
+
+            void BooleanAdd( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
+            {
+                booleanOp( ClipperLib::ctUnion, b, aFastMode );
+            }
+
+            void BooleanAdd( const BOOLEAN_PIPELINE& b, POLYGON_MODE aFastMode )
+            {
+                booleanOp( ClipperLib::ctUnion, b, aFastMode );
+            }
+
+            void BooleanSubtract( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
+            {
+                booleanOp( ClipperLib::ctDifference, b, aFastMode );
+            }
+
+            void BooleanSubtract( const BOOLEAN_PIPELINE& b, POLYGON_MODE aFastMode )
+            {
+                booleanOp( ClipperLib::ctDifference, b, aFastMode );
+            }
+
+            void BooleanIntersection( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
+            {
+                booleanOp( ClipperLib::ctIntersection, b, aFastMode );
+            }
+
+            void BooleanIntersection( const BOOLEAN_PIPELINE& b, POLYGON_MODE aFastMode )
+            {
+                booleanOp( ClipperLib::ctIntersection, b, aFastMode );
+            }
+
+            void Inflate( int aFactor, int aCircleSegmentsCount );
+
+            void Simplify( POLYGON_MODE aFastMode );
+
+            ///> Returns the polygons resulting from the operations done so far
+            SHAPE_POLY_SET Result() const;
+
+        private:
+            void booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aOther,
+                            POLYGON_MODE aFastMode );
+
+            void booleanOp( ClipperLib::ClipType aType, const BOOLEAN_PIPELINE& aOther,
+                            POLYGON_MODE aFastMode );
+
+            void execute( ClipperLib::Clipper& aClipper, ClipperLib::ClipType aType,
+                          POLYGON_MODE aFastMode );
+
+            void importTree( ClipperLib::PolyTree& aTree );
+
+            ///> one entry per polygon: the outline, then the holes, oriented for Clipper
+            std::vector<ClipperLib::Paths> m_polys;
+
+            ///> conversion buffer kept between operations
+            ClipperLib::Path m_scratch;
+        };
+
         /**
          * Function NormalizeAreaOutlines
          * Convert a self-intersecting polygon to one (or more) non self-intersecting polygon(s)
@@ -1009,7 +1088,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @param aIndex is the index of the polygon to be chamfered.
          * @return POLYGON - A polygon containing the chamfered version of the aIndex-th polygon.
          */
-        POLYGON ChamferPolygon( unsigned int aDistance, int aIndex = 0 );
+        POLYGON ChamferPolygon( unsigned int aDistance, int aIndex = 0 ) const;
 
         /**
          * Function Fillet
@@ -1019,7 +1098,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @param aIndex is the index of the polygon to be filleted
          * @return POLYGON - A polygon containing the filleted version of the aIndex-th polygon.
          */
-        POLYGON FilletPolygon( unsigned int aRadius, int aErrorMax, int aIndex = 0 );
+        POLYGON FilletPolygon( unsigned int aRadius, int aErrorMax, int aIndex = 0 ) const;
 
         /**
          * Function Chamfer
@@ -1027,7 +1106,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @param aDistance is the chamfering distance.
          * @return SHAPE_POLY_SET - A set containing the chamfered version of this set.
          */
-        SHAPE_POLY_SET Chamfer(  int aDistance );
+        SHAPE_POLY_SET Chamfer(  int aDistance ) const;
 
         /**
          * Function Fillet
@@ -1036,7 +1115,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @param aErrorMax is the maximum allowable deviation of the polygon from the circle
          * @return SHAPE_POLY_SET - A set containing the filleted version of this set.
          */
-        SHAPE_POLY_SET Fillet(  int aRadius, int aErrorMax );
+        SHAPE_POLY_SET Fillet(  int aRadius, int aErrorMax ) const;
 
         /**
          * Function DistanceToPolygon
@@ -1120,8 +1199,6 @@ class SHAPE_POLY_SET : public SHAPE
 
         bool pointInPolygon( const VECTOR2I& aP, const SHAPE_LINE_CHAIN& aPath ) const;
 
-        const ClipperLib::Path convertToClipper( const SHAPE_LINE_CHAIN& aPath, bool aRequiredOrientation );
-        const SHAPE_LINE_CHAIN convertFromClipper( const ClipperLib::Path& aPath );
 
         /**
          * containsSingle function
@@ -1165,18 +1242,89 @@ class SHAPE_POLY_SET : public SHAPE
          * @return POLYGON - the chamfered/filleted version of the polygon.
          */
         POLYGON chamferFilletPolygon( CORNER_MODE aMode, unsigned int aDistance,
-                                      int aIndex, int aErrorMax = -1 );
+                                      int aIndex, int aErrorMax = -1 ) const;
 
         ///> Returns true if the polygon set has any holes that touch share a vertex.
         bool hasTouchingHoles( const POLYGON& aPoly ) const;
 
         typedef std::vector<POLYGON> POLYSET;
 
-        POLYSET m_polys;
+        /**
+         * Class SHARED_POLYSET
+         *
+         * The polygons of a set, shared with its copies.  It has the subset of the std::vector
+         * interface used by SHAPE_POLY_SET: const access reads the shared polygons, non-const
+         * access first copies them if another set still uses them.
+         */
+        class SHARED_POLYSET
+        {
+        public:
+            typedef POLYSET::iterator       iterator;
+            typedef POLYSET::const_iterator const_iterator;
+
+            ///> Returns the polygons for reading, without copying them
+            const POLYSET& get() const
+            {
+                static const POLYSET empty;
+
+                return m_data ? *m_data : empty;
+            }
+
+            ///> Returns the polygons for writing, after making them unique to this set
+            POLYSET& mut()
+            {
+                if( !m_data )
+                {
+                    m_data = std::make_shared<POLYSET>();
+                }
+                else if( m_data.use_count() > 1 )
+                {
+                    m_data = std::make_shared<POLYSET>( *m_data );
+                }
+                else
+                {
+                    // The last other owner may just have released the polygons: see its
+                    // changes before modifying them
+                    std::atomic_thread_fence( std::memory_order_acquire );
+                }
+
+                return *m_data;
+            }
+
+            size_t size() const { return get().size(); }
+
+            const POLYGON& operator[]( size_t aIndex ) const { return get()[aIndex]; }
+            POLYGON& operator[]( size_t aIndex ) { return mut()[aIndex]; }
+
+            const POLYGON& back() const { return get().back(); }
+            POLYGON& back() { return mut().back(); }
+
+            const_iterator begin() const { return get().begin(); }
+            const_iterator end() const { return get().end(); }
+            iterator begin() { return mut().begin(); }
+            iterator end() { return mut().end(); }
+
+            void push_back( const POLYGON& aPolygon ) { mut().push_back( aPolygon ); }
+            void push_back( POLYGON&& aPolygon ) { mut().push_back( std::move( aPolygon ) ); }
+
+            iterator erase( iterator aPos ) { return mut().erase( aPos ); }
+
+            template <class IT>
+            void insert( iterator aPos, IT aFirst, IT aLast ) { mut().insert( aPos, aFirst, aLast ); }
+
+            ///> Releases the polygons; nothing is copied if they are shared
+            void clear() { m_data.reset(); }
+
+        private:
+            std::shared_ptr<POLYSET> m_data;
+        };
+
+        SHARED_POLYSET m_polys;
 
     public:
 
         SHAPE_POLY_SET& operator=( const SHAPE_POLY_SET& );
+        SHAPE_POLY_SET& operator=( SHAPE_POLY_SET&& );
 
         void CacheTriangulation();
         bool IsTriangulationUpToDate() const;
@@ -36,6 +36,7 @@
 // but the errorText needs to be wide char so wxString rules.
 #include <wx/wx.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <ki_exception.h>
 
@@ -396,6 +397,50 @@ public:
      */
     int PRINTF_FUNC Print( int nestLevel, const char* fmt, ... );
 
+    /**
+     * Function Indent
+     * writes the spaces preceding the output of a nesting level, as Print() does.
+     *
+     * @param nestLevel The multiple of spaces to write.
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void Indent( int nestLevel );
+
+    /**
+     * Function Append
+     * writes \a aText to the output stream as is.  Unlike Print(), no format string is
+     * parsed, and no locale is involved: writing a line piece by piece with the Append
+     * functions is much faster than formatting it.
+     *
+     * @param aText The text to write.
+     * @param aCount The number of bytes of \a aText to write, or -1 for the whole C string.
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void Append( const char* aText, int aCount = -1 )
+    {
+        write( aText, aCount < 0 ? strlen( aText ) : aCount );
+    }
+
+    void Append( const std::string& aText )
+    {
+        write( aText.data(), aText.size() );
+    }
+
+    /**
+     * Function AppendInt
+     * writes \a aValue in decimal, as Print( 0, "%lld", aValue ) does.
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void AppendInt( long long aValue );
+
+    /**
+     * Function AppendDecimal
+     * writes the exact value of \a aValue / 10^\a aDecimals, with the shortest text
+     * (see FormatDecimal()).
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void AppendDecimal( long long aValue, int aDecimals );
+
     /**
      * Function GetQuoteChar
      * performs quote character need determination.
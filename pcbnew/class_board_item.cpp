@@ -34,6 +34,9 @@
 #include <wx/debug.h>
 
 #include <class_board.h>
+#include <kicad_string.h>
+#include <format_number.h>
+#include <cmath>
 #include <string>
 
 wxString BOARD_ITEM::ShowShape( STROKE_T aShape )
@@ -87,92 +90,38 @@ wxString BOARD_ITEM::GetLayerName() const
 }
 
 
-std::string BOARD_ITEM::FormatInternalUnits( int aValue )
+char* BOARD_ITEM::FormatInternalUnits( char* aBuffer, int aValue )
 {
-#if 1
-
-    char    buf[50];
-    int     len;
-    double  mm = aValue / IU_PER_MM;
-
-    if( mm != 0.0 && fabs( mm ) <= 0.0001 )
-    {
-        len = sprintf( buf, "%.10f", mm );
-
-        while( --len > 0 && buf[len] == '0' )
-            buf[len] = '\0';
-
-        if( buf[len] == '.' )
-            buf[len] = '\0';
-        else
-            ++len;
-    }
-    else
-    {
-        len = sprintf( buf, "%.10g", mm );
-    }
-
-    return std::string( buf, len );
-
-#else
-
-    // Assume aValue is in nanometers, and that we want the result in millimeters,
-    // and that int is 32 bits wide.  Then perform an alternative algorithm.
-    // Can be used to verify that the above algorithm is correctly generating text.
-    // Convert aValue into an integer string, then insert a decimal point manually.
-    // Results are the same as above general purpose algorithm.
-
-    wxASSERT( sizeof(int) == 4 );
+    // Internal units are nanometers: the value in millimeters is written by inserting a
+    // decimal point 6 digits from the right, and removing the trailing zeros.  This is the
+    // exact value, and the same text as "%.10g" (or "%.10f" without its trailing zeros for
+    // values below 0.0001 mm) since an int has at most 10 digits.
+    static_assert( IU_PER_MM == 1e6, "FormatInternalUnits() expects nanometer internal units" );
 
-    if( aValue == 0 )
-        return std::string( 1, '0' );
-    else
-    {
-        char    buf[50];
-        int     len = sprintf( buf, aValue > 0 ? "%06d" : "%07d", aValue );     // optionally pad w/leading zeros
-
-        std::string ret( buf, len );
-
-        std::string::iterator it = ret.end() - 1;           // last byte
-
-        // insert '.' at 6 positions from end, dividing by 10e6 (a million), nm => mm
-        std::string::iterator decpoint = ret.end() - 6;
+    return FormatDecimal( aBuffer, aValue, 6 );
+}
 
-        // truncate trailing zeros, up to decimal point position
-        for(  ; *it=='0' && it >= decpoint;  --it )
-            ret.erase( it );    // does not invalidate iterators it or decpoint
 
-        if( it >= decpoint )
-        {
-            ret.insert( decpoint, '.' );
-
-            // decpoint is invalidated here, after insert()
-
-#if 1       // want a leading zero when decimal point is in first position?
-            if( ret[0] == '.' )
-            {
-                // insert leading zero ahead of decimal point.
-                ret.insert( ret.begin(), '0' );
-            }
-            else if( ret[0]=='-' && ret[1]=='.' )
-            {
-                ret.insert( ret.begin() + 1, '0' );
-            }
-#endif
-        }
-
-        return ret;
-    }
+std::string BOARD_ITEM::FormatInternalUnits( int aValue )
+{
+    char buf[50];
 
-#endif
+    return std::string( buf, FormatInternalUnits( buf, aValue ) );
 }
 
 
 std::string BOARD_ITEM::FormatAngle( double aAngle )
 {
     char temp[50];
+    int  len;
 
-    int len = snprintf( temp, sizeof(temp), "%.10g", aAngle / 10.0 );
+    // Angles are nearly always integer tenths of degree, which are written exactly with
+    // one decimal: the same text as "%.10g" of the degrees, without formatting it.
+    if( aAngle == std::trunc( aAngle ) && std::fabs( aAngle ) < 1e10
+            && !( aAngle == 0.0 && std::signbit( aAngle ) ) )
+        len = FormatDecimal( temp, (long long) aAngle, 1 ) - temp;
+    else
+        len = snprintf( temp, sizeof(temp), "%.10g", aAngle / 10.0 );
 
     return std::string( temp, len );
 }
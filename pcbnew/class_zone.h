@@ -540,20 +540,21 @@ public:
 
    /**
      * Function SetFilledPolysList
-     * sets the list of filled polygons.
+     * sets the list of filled polygons.  Pass a temporary (or use std::move) to give the
+     * polygons to the zone without copying them.
      */
-    void SetFilledPolysList( SHAPE_POLY_SET& aPolysList )
+    void SetFilledPolysList( SHAPE_POLY_SET aPolysList )
     {
-        m_FilledPolysList = aPolysList;
+        m_FilledPolysList = std::move( aPolysList );
     }
 
     /**
       * Function SetFilledPolysList
       * sets the list of filled polygons.
       */
-    void SetRawPolysList( SHAPE_POLY_SET& aPolysList )
+    void SetRawPolysList( SHAPE_POLY_SET aPolysList )
     {
-        m_RawPolysList = aPolysList;
+        m_RawPolysList = std::move( aPolysList );
     }
 
 
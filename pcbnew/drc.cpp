@@ -55,6 +55,7 @@
 #include <dialog_drc.h>
 #include <wx/progdlg.h>
 #include <board_commit.h>
+#include <zone_filler.h>
 
 void DRC::ShowDRCDialog( wxWindow* aParent )
 {
@@ -106,11 +107,34 @@ void DRC::addMarkerToPcb( MARKER_PCB* aMarker )
         m_currentMarker = nullptr;
     }
     else
+    {
+        commitMarkers( { aMarker } );
+    }
+}
+
+
+void DRC::commitMarkers( const std::vector<MARKER_PCB*>& aMarkers )
+{
+    if( m_pcbEditorFrame )
     {
         BOARD_COMMIT commit( m_pcbEditorFrame );
-        commit.Add( aMarker );
+
+        for( auto marker : aMarkers )
+            commit.Add( marker );
+
         commit.Push( wxEmptyString, false, false );
     }
+    else
+    {
+        for( auto marker : aMarkers )
+            m_pcb->Add( marker );
+    }
+}
+
+
+EDA_UNITS_T DRC::userUnits() const
+{
+    return m_pcbEditorFrame ? m_pcbEditorFrame->GetUserUnits() : m_units;
 }
 
 
@@ -126,12 +150,19 @@ void DRC::DestroyDRCDialog( int aReason )
 }
 
 
-DRC::DRC( PCB_EDIT_FRAME* aPcbWindow )
+DRC::DRC( PCB_EDIT_FRAME* aPcbWindow ) :
+    DRC( aPcbWindow->GetBoard(), aPcbWindow->GetUserUnits() )
 {
     m_pcbEditorFrame = aPcbWindow;
-    m_pcb = aPcbWindow->GetBoard();
+}
+
+
+DRC::DRC( BOARD* aBoard, EDA_UNITS_T aUnits )
+{
+    m_pcbEditorFrame = NULL;
+    m_pcb = aBoard;
     m_drcDialog  = NULL;
-    m_units = aPcbWindow->GetUserUnits();
+    m_units = aUnits;
 
     // establish initial values for everything:
     m_drcInLegacyRoutingMode = false;
@@ -205,9 +236,11 @@ int DRC::DrcOnCreatingTrack( TRACK* aRefSegm, TRACK* aList )
 
 int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
 {
-    BOARD* board = m_pcbEditorFrame->GetBoard();
-    EDA_UNITS_T units = m_pcbEditorFrame->GetUserUnits();
-    BOARD_COMMIT commit( m_pcbEditorFrame );
+    updatePointers();
+
+    BOARD* board = m_pcb;
+    EDA_UNITS_T units = userUnits();
+    std::vector<MARKER_PCB*> markers;
     int nerrors = 0;
 
     // iterate through all areas
@@ -276,7 +309,7 @@ int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
                         wxPoint pt( currentVertex.x, currentVertex.y );
                         auto marker = new MARKER_PCB( units, COPPERAREA_INSIDE_COPPERAREA,
                                                       pt, zoneRef, pt, zoneToTest, pt );
-                        commit.Add( marker );
+                        markers.push_back( marker );
                     }
 
                     nerrors++;
@@ -296,7 +329,7 @@ int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
                         wxPoint pt( currentVertex.x, currentVertex.y );
                         auto marker = new MARKER_PCB( units, COPPERAREA_INSIDE_COPPERAREA,
                                                       pt, zoneToTest, pt, zoneRef, pt );
-                        commit.Add( marker );
+                        markers.push_back( marker );
                     }
 
                     nerrors++;
@@ -342,7 +375,7 @@ int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
                         {
                             auto marker = new MARKER_PCB( units, COPPERAREA_CLOSE_TO_COPPERAREA,
                                                           pt, zoneRef, pt, zoneToTest, pt );
-                            commit.Add( marker );
+                            markers.push_back( marker );
                         }
 
                         nerrors++;
@@ -353,7 +386,7 @@ int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
     }
 
     if( aCreateMarkers )
-        commit.Push( wxEmptyString, false, false );
+        commitMarkers( markers );
 
     return nerrors;
 }
@@ -390,7 +423,8 @@ void DRC::RunTests( wxTextCtrl* aMessages )
 {
     // be sure m_pcb is the current board, not a old one
     // ( the board can be reloaded )
-    m_pcb = m_pcbEditorFrame->GetBoard();
+    if( m_pcbEditorFrame )
+        m_pcb = m_pcbEditorFrame->GetBoard();
 
     // someone should have cleared the two lists before calling this.
 
@@ -437,12 +471,24 @@ void DRC::RunTests( wxTextCtrl* aMessages )
         wxSafeYield();
     }
 
-    testTracks( aMessages ? aMessages->GetParent() : m_pcbEditorFrame, true );
+    testTracks( aMessages ? aMessages->GetParent() : m_pcbEditorFrame,
+                m_pcbEditorFrame != NULL );
 
     // caller (a wxTopLevelFrame) is the wxDialog or the Pcb Editor frame that call DRC:
     wxWindow* caller = aMessages ? aMessages->GetParent() : m_pcbEditorFrame;
 
-    if( m_refillZones )
+    if( !m_pcbEditorFrame )
+    {
+        // Without user interface, the zones cannot be checked (refilling them needs
+        // a confirmation), only refilled
+        if( m_refillZones )
+        {
+            ZONE_FILLER filler( m_pcb );
+
+            filler.Fill( m_pcb->Zones() );
+        }
+    }
+    else if( m_refillZones )
     {
         if( aMessages )
             aMessages->AppendText( _( "Refilling all zones...\n" ) );
@@ -545,7 +591,8 @@ void DRC::ListUnconnectedPads()
 void DRC::updatePointers()
 {
     // update my pointers, m_pcbEditorFrame is the only unchangeable one
-    m_pcb = m_pcbEditorFrame->GetBoard();
+    if( m_pcbEditorFrame )
+        m_pcb = m_pcbEditorFrame->GetBoard();
 
     if( m_drcDialog )  // Use diag list boxes only in DRC dialog
     {
@@ -565,7 +612,7 @@ bool DRC::doNetClass( const NETCLASSPTR& nc, wxString& msg )
 
     const BOARD_DESIGN_SETTINGS& g = m_pcb->GetDesignSettings();
 
-#define FmtVal( x ) GetChars( StringFromValue( m_pcbEditorFrame->GetUserUnits(), x ) )
+#define FmtVal( x ) GetChars( StringFromValue( userUnits(), x ) )
 
 #if 0   // set to 1 when (if...) BOARD_DESIGN_SETTINGS has a m_MinClearance value
     if( nc->GetClearance() < g.m_MinClearance )
@@ -781,7 +828,7 @@ void DRC::testDrilledHoles()
             if( KiROUND( GetLineLength( checkHole.m_location, refHole.m_location ) )
                     <  checkHole.m_drillRadius + refHole.m_drillRadius + holeToHoleMin )
             {
-                addMarkerToPcb( new MARKER_PCB( m_pcbEditorFrame->GetUserUnits(),
+                addMarkerToPcb( new MARKER_PCB( userUnits(),
                                                 DRCE_DRILLED_HOLES_TOO_CLOSE, refHole.m_location,
                                                 refHole.m_owner, refHole.m_location,
                                                 checkHole.m_owner, checkHole.m_location ) );
@@ -867,7 +914,7 @@ void DRC::testUnconnected()
         auto src = edge.GetSourcePos();
         auto dst = edge.GetTargetPos();
 
-        m_unconnected.emplace_back( new DRC_ITEM( m_pcbEditorFrame->GetUserUnits(),
+        m_unconnected.emplace_back( new DRC_ITEM( userUnits(),
                                                   DRCE_UNCONNECTED_ITEMS,
                                                   edge.GetSourceNode()->Parent(),
                                                   wxPoint( src.x, src.y ),
@@ -1095,7 +1142,7 @@ void DRC::testTexts()
 
 void DRC::testDisabledLayers()
 {
-    BOARD* board = m_pcbEditorFrame->GetBoard();
+    BOARD* board = m_pcb;
     wxCHECK( board, /*void*/ );
     LSET disabledLayers = board->GetEnabledLayers().flip();
 
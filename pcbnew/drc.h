@@ -211,7 +211,8 @@ private:
     int                 m_xcliphi;
     int                 m_ycliphi;
 
-    PCB_EDIT_FRAME*     m_pcbEditorFrame;   ///< The pcb frame editor which owns the board
+    PCB_EDIT_FRAME*     m_pcbEditorFrame;   ///< The pcb frame editor which owns the board,
+                                            ///< or NULL when running without user interface
     BOARD*              m_pcb;
     DIALOG_DRC_CONTROL* m_drcDialog;
     EDA_UNITS_T         m_units;
@@ -224,6 +225,16 @@ private:
      */
     void updatePointers();
 
+    /**
+     * @return the units of the messages: the current units of the editor frame if any.
+     */
+    EDA_UNITS_T userUnits() const;
+
+    /**
+     * Add markers to the board, through a commit when there is an editor frame.
+     */
+    void commitMarkers( const std::vector<MARKER_PCB*>& aMarkers );
+
 
     /**
      * Function fillMarker
@@ -431,6 +442,16 @@ private:
 public:
     DRC( PCB_EDIT_FRAME* aPcbWindow );
 
+    /**
+     * Create a DRC working directly on a board, without user interface: markers are added
+     * to the board without a commit and no progress is displayed.  Zones are refilled only
+     * if requested by SetSettings(), and otherwise not checked.
+     *
+     * @param aBoard is the board to test.
+     * @param aUnits are the units of the messages.
+     */
+    DRC( BOARD* aBoard, EDA_UNITS_T aUnits );
+
     ~DRC();
 
     /**
@@ -538,6 +559,14 @@ public:
      */
     void ListUnconnectedPads();
 
+    /**
+     * @return the unconnected items found by the last RunTests() or ListUnconnectedPads().
+     */
+    const DRC_LIST& GetUnconnectedItems() const
+    {
+        return m_unconnected;
+    }
+
     /**
      * @return a pointer to the current marker (last created marker
      */
@@ -160,12 +160,7 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACK* aStart, bool testPads )
         }
         else
         {
-            BOARD_COMMIT commit( m_pcbEditorFrame );
-
-            for( auto marker : markers )
-                commit.Add( marker );
-
-            commit.Push( wxEmptyString, false, false );
+            DRC::commitMarkers( markers );
         }
     };
 
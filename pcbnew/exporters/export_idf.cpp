@@ -27,6 +27,7 @@
 
 
 #include <list>
+#include <mutex>
 #include <pcb_edit_frame.h>
 #include <macros.h>
 #include <pcbnew.h>
@@ -40,6 +41,7 @@
 #include "kiway.h"
 #include "3d_cache/3d_cache.h"
 #include "filename_resolver.h"
+#include <exporters/export_idf.h>
 
 #ifndef PCBNEW
 #define PCBNEW                  // needed to define the right value of Millimeter2iu(x)
@@ -545,20 +547,19 @@ static void idf_export_module( BOARD* aPcb, MODULE* aModule,
 }
 
 
-/**
- * Function Export_IDF3
- * generates IDFv3 compliant board (*.emn) and library (*.emp)
- * files representing the user's PCB design.
- */
-bool PCB_EDIT_FRAME::Export_IDF3( BOARD* aPcb, const wxString& aFullFileName,
-    bool aUseThou, double aXRef, double aYRef )
+bool ExportBoardToIDF3( BOARD* aPcb, S3D_CACHE* aCache, const wxString& aFullFileName,
+                        bool aUseThou, double aXRef, double aYRef, wxString* aErrorMsg )
 {
+    // The model path resolver is kept in a static variable
+    static std::mutex exportLock;
+    std::lock_guard<std::mutex> lock( exportLock );
+
     IDF3_BOARD idfBoard( IDF3::CAD_ELEC );
 
     // Switch the locale to standard C (needed to print floating point numbers)
     LOCALE_IO toggle;
 
-    resolver = Prj().Get3DCacheManager()->GetResolver();
+    resolver = aCache->GetResolver();
 
     bool ok = true;
     double scale = MM_PER_IU;   // we must scale internal units to mm for IDF
@@ -601,28 +602,48 @@ bool PCB_EDIT_FRAME::Export_IDF3( BOARD* aPcb, const wxString& aFullFileName,
 
         if( !idfBoard.WriteFile( aFullFileName, idfUnit, false ) )
         {
-            wxString msg;
-            msg << _( "IDF Export Failed:\n" ) << FROM_UTF8( idfBoard.GetError().c_str() );
-            wxMessageBox( msg );
+            if( aErrorMsg )
+                *aErrorMsg = FROM_UTF8( idfBoard.GetError().c_str() );
 
             ok = false;
         }
     }
     catch( const IO_ERROR& ioe )
     {
-        wxString msg;
-        msg << _( "IDF Export Failed:\n" ) << ioe.What();
-        wxMessageBox( msg );
+        if( aErrorMsg )
+            *aErrorMsg = ioe.What();
 
         ok = false;
     }
     catch( const std::exception& e )
     {
-        wxString msg;
-        msg << _( "IDF Export Failed:\n" ) << FROM_UTF8( e.what() );
-        wxMessageBox( msg );
+        if( aErrorMsg )
+            *aErrorMsg = FROM_UTF8( e.what() );
+
         ok = false;
     }
 
     return ok;
 }
+
+
+/**
+ * Function Export_IDF3
+ * generates IDFv3 compliant board (*.emn) and library (*.emp)
+ * files representing the user's PCB design.
+ */
+bool PCB_EDIT_FRAME::Export_IDF3( BOARD* aPcb, const wxString& aFullFileName,
+    bool aUseThou, double aXRef, double aYRef )
+{
+    wxString error;
+
+    if( ExportBoardToIDF3( aPcb, Prj().Get3DCacheManager(), aFullFileName, aUseThou,
+                           aXRef, aYRef, &error ) )
+        return true;
+
+    wxString msg;
+    msg << _( "IDF Export Failed:\n" ) << error;
+    wxMessageBox( msg );
+
+    return false;
+}
@@ -24,10 +24,14 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
 #include <cmath>
 #include <exception>
 #include <fstream>
 #include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <wx/dir.h>
 
@@ -41,6 +45,7 @@
 #include "class_zone.h"
 #include "convert_to_biu.h"
 #include "draw_graphic_text.h"
+#include "export_vrml.h"
 #include "macros.h"
 #include "pgm_base.h"
 #include "plugins/3dapi/ifsg_all.h"
@@ -69,7 +74,6 @@ static double WORLD_SCALE = 1.0;    // scaling from 0.1 in to desired VRML unit
 static double BOARD_SCALE;          // scaling from mm to desired VRML world scale
 static const int PRECISION = 6;     // legacy precision factor (now set to 6)
 static wxString SUBDIR_3D;          // legacy 3D subdirectory
-static wxString PROJ_DIR;           // project directory
 
 struct VRML_COLOR
 {
@@ -419,11 +423,66 @@ static void write_triangle_bag( std::ostream& aOut_file, VRML_COLOR& aColor,
 }
 
 
+// Tesselate the layers of the model concurrently.  The tesselation renumbers the
+// vertices of the holes it is given, so each layer but the first one is tesselated
+// with its own copy of the holes, which is returned in aHoles: the layer refers to
+// it until it is written.
+static void tesselate_layers( MODEL_VRML& aModel,
+                              std::vector<std::unique_ptr<VRML_LAYER>>& aHoles )
+{
+    std::vector<VRML_LAYER*> layers = { &aModel.m_board };
+
+    if( !aModel.m_plainPCB )
+    {
+        layers.insert( layers.end(), { &aModel.m_top_copper, &aModel.m_top_tin,
+                                       &aModel.m_bot_copper, &aModel.m_bot_tin,
+                                       &aModel.m_plated_holes,
+                                       &aModel.m_top_silk, &aModel.m_bot_silk } );
+    }
+
+    aHoles.resize( layers.size() );
+
+    for( size_t i = 1; i < layers.size(); ++i )
+    {
+        if( layers[i] != &aModel.m_plated_holes )
+        {
+            aHoles[i].reset( new VRML_LAYER );
+            aHoles[i]->CopyContours( aModel.m_holes );
+        }
+    }
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   layers.size() );
+    std::atomic<size_t> next( 0 );
+    std::vector<std::thread> workers;
+
+    for( size_t ii = 0; ii < std::max<size_t>( parallelThreadCount, 1 ); ++ii )
+    {
+        workers.push_back( std::thread( [ &aModel, &aHoles, &layers, &next ]()
+        {
+            for( size_t i = next.fetch_add( 1 ); i < layers.size(); i = next.fetch_add( 1 ) )
+            {
+                if( layers[i] == &aModel.m_plated_holes )
+                    layers[i]->Tesselate( NULL, true );
+                else
+                    layers[i]->Tesselate( i ? aHoles[i].get() : &aModel.m_holes );
+            }
+        } ) );
+    }
+
+    for( std::thread& worker : workers )
+        worker.join();
+}
+
+
 static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     const char* aFileName, OSTREAM* aOutputFile )
 {
+    std::vector<std::unique_ptr<VRML_LAYER>> holes;
+
+    tesselate_layers( aModel, holes );
+
     // VRML_LAYER board;
-    aModel.m_board.Tesselate( &aModel.m_holes );
     double brdz = aModel.m_brd_thickness / 2.0
                   - ( Millimeter2iu( ART_OFFSET / 2.0 ) ) * BOARD_SCALE;
 
@@ -446,8 +505,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER m_top_copper;
-    aModel.m_top_copper.Tesselate( &aModel.m_holes );
-
     if( USE_INLINES )
     {
         write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TRACK ),
@@ -461,8 +518,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER m_top_tin;
-    aModel.m_top_tin.Tesselate( &aModel.m_holes );
-
     if( USE_INLINES )
     {
         write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TIN ),
@@ -478,8 +533,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER m_bot_copper;
-    aModel.m_bot_copper.Tesselate( &aModel.m_holes );
-
     if( USE_INLINES )
     {
         write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TRACK ),
@@ -493,8 +546,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER m_bot_tin;
-    aModel.m_bot_tin.Tesselate( &aModel.m_holes );
-
     if( USE_INLINES )
     {
         write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TIN ),
@@ -511,8 +562,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER PTH;
-    aModel.m_plated_holes.Tesselate( NULL, true );
-
     if( USE_INLINES )
     {
         write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TIN ),
@@ -528,8 +577,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER m_top_silk;
-    aModel.m_top_silk.Tesselate( &aModel.m_holes );
-
     if( USE_INLINES )
     {
         write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_SILK ), &aModel.m_top_silk,
@@ -542,8 +589,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER m_bot_silk;
-    aModel.m_bot_silk.Tesselate( &aModel.m_holes );
-
     if( USE_INLINES )
     {
         write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_SILK ), &aModel.m_bot_silk,
@@ -1373,6 +1418,10 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
     for( D_PAD* pad = aModule->PadsList(); pad; pad = pad->Next() )
         export_vrml_pad( aModel, aPcb, pad );
 
+    // Without a 3D model cache, the footprint models are not exported
+    if( !cache )
+        return;
+
     bool isFlipped = aModule->GetLayer() == B_Cu;
 
     // Export the object VRML model(s)
@@ -1544,20 +1593,23 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
 }
 
 
-bool PCB_EDIT_FRAME::ExportVRML_File( const wxString& aFullFileName, double aMMtoWRMLunit,
-                                      bool aExport3DFiles, bool aUseRelativePaths,
-                                      bool aUsePlainPCB, const wxString& a3D_Subdir,
-                                      double aXRef, double aYRef )
+bool ExportBoardToVRML( BOARD* aBoard, S3D_CACHE* aCache, const wxString& aFullFileName,
+                        double aMMtoWRMLunit, bool aExport3DFiles, bool aUseRelativePaths,
+                        bool aUsePlainPCB, const wxString& a3D_Subdir,
+                        double aXRef, double aYRef, wxString* aErrorMsg )
 {
-    BOARD*          pcb = GetBoard();
+    // The export settings and the materials are kept in static variables
+    static std::mutex exportLock;
+    std::lock_guard<std::mutex> lock( exportLock );
+
+    BOARD*          pcb = aBoard;
     bool            ok  = true;
 
     USE_INLINES = aExport3DFiles;
     USE_DEFS = true;
     USE_RELPATH = aUseRelativePaths;
 
-    cache = Prj().Get3DCacheManager();
-    PROJ_DIR = Prj().GetProjectPath();
+    cache = aCache;
     SUBDIR_3D = a3D_Subdir;
     MODEL_VRML model3d;
     model_vrml = &model3d;
@@ -1657,9 +1709,8 @@ bool PCB_EDIT_FRAME::ExportVRML_File( const wxString& aFullFileName, double aMMt
     }
     catch( const std::exception& e )
     {
-        wxString msg;
-        msg << _( "IDF Export Failed:\n" ) << FROM_UTF8( e.what() );
-        wxMessageBox( msg );
+        if( aErrorMsg )
+            *aErrorMsg = FROM_UTF8( e.what() );
 
         ok = false;
     }
@@ -1668,6 +1719,26 @@ bool PCB_EDIT_FRAME::ExportVRML_File( const wxString& aFullFileName, double aMMt
 }
 
 
+bool PCB_EDIT_FRAME::ExportVRML_File( const wxString& aFullFileName, double aMMtoWRMLunit,
+                                      bool aExport3DFiles, bool aUseRelativePaths,
+                                      bool aUsePlainPCB, const wxString& a3D_Subdir,
+                                      double aXRef, double aYRef )
+{
+    wxString error;
+
+    if( ExportBoardToVRML( GetBoard(), Prj().Get3DCacheManager(), aFullFileName,
+                           aMMtoWRMLunit, aExport3DFiles, aUseRelativePaths, aUsePlainPCB,
+                           a3D_Subdir, aXRef, aYRef, &error ) )
+        return true;
+
+    wxString msg;
+    msg << _( "IDF Export Failed:\n" ) << error;
+    wxMessageBox( msg );
+
+    return false;
+}
+
+
 static SGNODE* getSGColor( VRML_COLOR_INDEX colorIdx )
 {
     if( colorIdx == -1 )
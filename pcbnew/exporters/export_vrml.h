@@ -0,0 +1,57 @@
+/**
+ * @file export_vrml.h
+ * @brief Export of a board to a VRML file, without user interface
+ */
+
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef EXPORT_VRML_H
+#define EXPORT_VRML_H
+
+#include <wx/string.h>
+
+class BOARD;
+class S3D_CACHE;
+
+/**
+ * Function ExportBoardToVRML
+ * creates the file(s) exporting a board to a VRML file.  This is the work done by
+ * PCB_EDIT_FRAME::ExportVRML_File(), which describes the export options; it needs
+ * no frame and reports errors to the caller.
+ *
+ * The layers of the board are tesselated concurrently.  Exports run one at a time,
+ * their settings being kept in static variables.
+ *
+ * @param aBoard = the board to export
+ * @param aCache = the 3D model cache used to load the footprint models, or NULL to
+ *                 export the board without them
+ * @param aErrorMsg = if not NULL, receives the reason of a failure
+ * @return true if Ok.
+ */
+bool ExportBoardToVRML( BOARD* aBoard, S3D_CACHE* aCache, const wxString& aFullFileName,
+                        double aMMtoWRMLunit, bool aExport3DFiles, bool aUseRelativePaths,
+                        bool aUsePlainPCB, const wxString& a3D_Subdir,
+                        double aXRef, double aYRef, wxString* aErrorMsg = NULL );
+
+#endif  // EXPORT_VRML_H
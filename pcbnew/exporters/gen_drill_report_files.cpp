@@ -56,12 +56,8 @@ inline double diameter_in_mm( double ius )
 
 
 bool GENDRILL_WRITER_BASE::genDrillMapFile( const wxString& aFullFileName,
-                                            PlotFormat aFormat )
+                                            PlotFormat aFormat, const DRILL_HOLE_SET& aSet )
 {
-    // Remark:
-    // Hole list must be created before calling this function, by buildHolesList(),
-    // for the right holes set (PTH, NPTH, buried/blind vias ...)
-
     double          scale = 1.0;
     wxPoint         offset;
     PLOTTER*        plotter = NULL;
@@ -208,7 +204,7 @@ bool GENDRILL_WRITER_BASE::genDrillMapFile( const wxString& aFullFileName,
     plotter->SetCurrentLineWidth( -1 );
 
     // Plot board outlines and drill map
-    plotDrillMarks( plotter );
+    plotDrillMarks( plotter, aSet.m_Holes );
 
     // Print a list of symbols used.
     int     charSize    = 3 * IU_PER_MM;                    // text size in IUs
@@ -229,9 +225,9 @@ bool GENDRILL_WRITER_BASE::genDrillMapFile( const wxString& aFullFileName,
                    GR_TEXT_HJUSTIFY_LEFT, GR_TEXT_VJUSTIFY_CENTER,
                    TextWidth, false, false );
 
-    for( unsigned ii = 0; ii < m_toolListBuffer.size(); ii++ )
+    for( unsigned ii = 0; ii < aSet.m_Tools.size(); ii++ )
     {
-        DRILL_TOOL& tool = m_toolListBuffer[ii];
+        const DRILL_TOOL& tool = aSet.m_Tools[ii];
 
         if( tool.m_TotalCount == 0 )
             continue;
@@ -301,7 +297,7 @@ bool GENDRILL_WRITER_BASE::GenDrillReportFile( const wxString& aFullFileName )
     unsigned    totalHoleCount;
     wxString    brdFilename = m_pcb->GetFileName();
 
-    std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
+    std::vector<DRILL_HOLE_SET> hole_sets = buildHoleSets();
 
     out.Print( 0, "Drill report for %s\n", TO_UTF8( brdFilename ) );
     out.Print( 0, "Created on %s\n\n", TO_UTF8( DateAndTime() ) );
@@ -331,14 +327,13 @@ bool GENDRILL_WRITER_BASE::GenDrillReportFile( const wxString& aFullFileName )
      * 3 - Non Plated through holes
      */
 
-    bool buildNPTHlist = false;     // First pass: build PTH list only
-
     // in this loop are plated only:
-    for( unsigned pair_ndx = 0; pair_ndx < hole_sets.size();  ++pair_ndx )
+    for( const DRILL_HOLE_SET& set : hole_sets )
     {
-        DRILL_LAYER_PAIR  pair = hole_sets[pair_ndx];
+        if( set.m_NPTH )
+            continue;
 
-        buildHolesList( pair, buildNPTHlist );
+        DRILL_LAYER_PAIR  pair = set.m_Pair;
 
         if( pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
         {
@@ -347,7 +342,7 @@ bool GENDRILL_WRITER_BASE::GenDrillReportFile( const wxString& aFullFileName )
 
             out.Print( 0, "    plated through holes:\n" );
             out.Print( 0, separator );
-            totalHoleCount = printToolSummary( out, false );
+            totalHoleCount = printToolSummary( out, set.m_Tools, false );
             out.Print( 0, "    Total plated holes count %u\n", totalHoleCount );
         }
         else    // blind/buried
@@ -362,19 +357,16 @@ bool GENDRILL_WRITER_BASE::GenDrillReportFile( const wxString& aFullFileName )
                 );
 
             out.Print( 0, separator );
-            totalHoleCount = printToolSummary( out, false );
+            totalHoleCount = printToolSummary( out, set.m_Tools, false );
             out.Print( 0, "    Total plated holes count %u\n", totalHoleCount );
         }
 
         out.Print( 0, "\n\n" );
     }
 
-    // NPTHoles. Generate the full list (pads+vias) if PTH and NPTH are merged,
-    // or only the NPTH list (which never has vias)
-    if( !m_merge_PTH_NPTH )
-        buildNPTHlist = true;
-
-    buildHolesList( DRILL_LAYER_PAIR( F_Cu, B_Cu ), buildNPTHlist );
+    // NPTHoles. Use the full list (pads+vias) if PTH and NPTH are merged,
+    // or only the NPTH list (which never has vias), which is the last set
+    const DRILL_HOLE_SET& npth_set = m_merge_PTH_NPTH ? hole_sets.front() : hole_sets.back();
 
     // nothing wrong with an empty NPTH file in report.
     if( m_merge_PTH_NPTH )
@@ -386,21 +378,22 @@ bool GENDRILL_WRITER_BASE::GenDrillReportFile( const wxString& aFullFileName )
 
     out.Print( 0, "    unplated through holes:\n" );
     out.Print( 0, separator );
-    totalHoleCount = printToolSummary( out, true );
+    totalHoleCount = printToolSummary( out, npth_set.m_Tools, true );
     out.Print( 0, "    Total unplated holes count %u\n", totalHoleCount );
 
     return true;
 }
 
 
-bool GENDRILL_WRITER_BASE::plotDrillMarks( PLOTTER* aPlotter )
+bool GENDRILL_WRITER_BASE::plotDrillMarks( PLOTTER* aPlotter,
+                                           const std::vector<HOLE_INFO>& aHoles )
 {
     // Plot the drill map:
     wxPoint pos;
 
-    for( unsigned ii = 0; ii < m_holeListBuffer.size(); ii++ )
+    for( unsigned ii = 0; ii < aHoles.size(); ii++ )
     {
-        const HOLE_INFO& hole = m_holeListBuffer[ii];
+        const HOLE_INFO& hole = aHoles[ii];
         pos = hole.m_Hole_Pos;
 
         // Always plot the drill symbol (for slots identifies the needed cutter!
@@ -417,13 +410,15 @@ bool GENDRILL_WRITER_BASE::plotDrillMarks( PLOTTER* aPlotter )
 }
 
 
-unsigned GENDRILL_WRITER_BASE::printToolSummary( OUTPUTFORMATTER& out, bool aSummaryNPTH ) const
+unsigned GENDRILL_WRITER_BASE::printToolSummary( OUTPUTFORMATTER& out,
+                                                 const std::vector<DRILL_TOOL>& aTools,
+                                                 bool aSummaryNPTH ) const
 {
     unsigned totalHoleCount = 0;
 
-    for( unsigned ii = 0; ii < m_toolListBuffer.size(); ii++ )
+    for( unsigned ii = 0; ii < aTools.size(); ii++ )
     {
-        const DRILL_TOOL& tool = m_toolListBuffer[ii];
+        const DRILL_TOOL& tool = aTools[ii];
 
         if( aSummaryNPTH && !tool.m_Hole_NotPlated )
             continue;
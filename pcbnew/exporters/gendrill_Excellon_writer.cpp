@@ -38,7 +38,7 @@
 #include <fctsys.h>
 
 #include <plotter.h>
-#include <kicad_string.h>
+#include <format_number.h>
 #include <pcb_edit_frame.h>
 #include <pgm_base.h>
 #include <build_version.h>
@@ -58,7 +58,6 @@
 EXCELLON_WRITER::EXCELLON_WRITER( BOARD* aPcb )
     : GENDRILL_WRITER_BASE( aPcb )
 {
-    m_file = NULL;
     m_zeroFormat      = DECIMAL_FORMAT;
     m_conversionUnits = 0.0001;
     m_mirror = false;
@@ -72,77 +71,32 @@ void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                                                  bool aGenDrill, bool aGenMap,
                                                  REPORTER * aReporter )
 {
-    wxFileName  fn;
-    wxString    msg;
+    std::vector<DRILL_HOLE_SET> hole_sets = buildHoleSets();
 
-    std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
-
-    // append a pair representing the NPTH set of holes, for separate drill files.
-    if( !m_merge_PTH_NPTH )
-        hole_sets.push_back( DRILL_LAYER_PAIR( F_Cu, B_Cu ) );
-
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
-    {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = m_merge_PTH_NPTH ? false : ( it == hole_sets.end() - 1 );
-
-        buildHolesList( pair, doing_npth );
-
-        // The file is created if it has holes, or if it is the non plated drill file
-        // to be sure the NPTH file is up to date in separate files mode.
-        if( getHolesCount() > 0 || doing_npth )
-        {
-            fn = getDrillFileName( pair, doing_npth, m_merge_PTH_NPTH );
-            fn.SetPath( aPlotDirectory );
-
-            if( aGenDrill )
-            {
-                wxString fullFilename = fn.GetFullPath();
-
-                FILE* file = wxFopen( fullFilename, wxT( "w" ) );
-
-                if( file == NULL )
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "** Unable to create %s **\n" ), GetChars( fullFilename ) );
-                        aReporter->Report( msg );
-                    }
-                    break;
-                }
-                else
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Create file %s\n" ), GetChars( fullFilename ) );
-                        aReporter->Report( msg );
-                    }
-                }
-
-                createDrillFile( file );
-            }
-        }
-    }
+    if( aGenDrill )
+        createDrillFiles( aPlotDirectory, hole_sets, aReporter );
 
     if( aGenMap )
-        CreateMapFilesSet( aPlotDirectory, aReporter );
+        createMapFiles( aPlotDirectory, hole_sets, aReporter );
 }
 
 
-int EXCELLON_WRITER::createDrillFile( FILE* aFile )
+int EXCELLON_WRITER::createDrillFile( const wxString& aFullFilename,
+                                      const DRILL_HOLE_SET& aSet ) const
 {
-    m_file = aFile;
+    FILE* file = wxFopen( aFullFilename, wxT( "w" ) );
+
+    if( file == NULL )
+        return -1;
 
     int    diam, holes_count;
     int    x0, y0, xf, yf, xc, yc;
     double xt, yt;
     char   line[1024];
 
-    LOCALE_IO dummy;    // Use the standard notation for double numbers
-
-    writeEXCELLONHeader();
+    // Numbers are written by FormatFixed() and FormatInt(), which do not depend on the
+    // locale: no LOCALE_IO is needed.
+    writeEXCELLONHeader( file );
 
     holes_count = 0;
 
@@ -154,50 +108,50 @@ int EXCELLON_WRITER::createDrillFile( FILE* aFile )
 #endif
 
     /* Write the tool list */
-    for( unsigned ii = 0; ii < m_toolListBuffer.size(); ii++ )
+    for( unsigned ii = 0; ii < aSet.m_Tools.size(); ii++ )
     {
-        DRILL_TOOL& tool_descr = m_toolListBuffer[ii];
+        const DRILL_TOOL& tool_descr = aSet.m_Tools[ii];
 
 #ifdef WRITE_PTH_NPTH_COMMENT
         if( writePTHcomment && !tool_descr.m_Hole_NotPlated )
         {
             writePTHcomment = false;
-            fprintf( m_file, ";TYPE=PLATED\n" );
+            fprintf( file, ";TYPE=PLATED\n" );
         }
 
         if( writeNPTHcomment && tool_descr.m_Hole_NotPlated )
         {
             writeNPTHcomment = false;
-            fprintf( m_file, ";TYPE=NON_PLATED\n" );
+            fprintf( file, ";TYPE=NON_PLATED\n" );
         }
 #endif
 
-        if( m_unitsMetric )    // if units are mm, the resolution is 0.001 mm (3 digits in mantissa)
-            fprintf( m_file, "T%dC%.3f\n", ii + 1, tool_descr.m_Diameter * m_conversionUnits );
-        else                    // if units are inches, the resolution is 0.1 mil (4 digits in mantissa)
-            fprintf( m_file, "T%dC%.4f\n", ii + 1, tool_descr.m_Diameter * m_conversionUnits );
+        // if units are mm, the resolution is 0.001 mm (3 digits in mantissa)
+        // if units are inches, the resolution is 0.1 mil (4 digits in mantissa)
+        FormatFixed( line, tool_descr.m_Diameter * m_conversionUnits, m_unitsMetric ? 3 : 4 );
+        fprintf( file, "T%dC%s\n", ii + 1, line );
     }
 
-    fputs( "%\n", m_file );                         // End of header info
-    fputs( "G90\n", m_file );                       // Absolute mode
-    fputs( "G05\n", m_file );                       // Drill mode
+    fputs( "%\n", file );                         // End of header info
+    fputs( "G90\n", file );                       // Absolute mode
+    fputs( "G05\n", file );                       // Drill mode
 
     // Units :
     if( !m_minimalHeader )
     {
         if( m_unitsMetric  )
-            fputs( "M71\n", m_file );       /* M71 = metric mode */
+            fputs( "M71\n", file );       /* M71 = metric mode */
         else
-            fputs( "M72\n", m_file );       /* M72 = inch mode */
+            fputs( "M72\n", file );       /* M72 = inch mode */
     }
 
     /* Read the hole file and generate lines for normal holes (oblong
      * holes will be created later) */
     int tool_reference = -2;
 
-    for( unsigned ii = 0; ii < m_holeListBuffer.size(); ii++ )
+    for( unsigned ii = 0; ii < aSet.m_Holes.size(); ii++ )
     {
-        HOLE_INFO& hole_descr = m_holeListBuffer[ii];
+        const HOLE_INFO& hole_descr = aSet.m_Holes[ii];
 
         if( hole_descr.m_Hole_Shape )
             continue;  // oblong holes will be created later
@@ -205,7 +159,7 @@ int EXCELLON_WRITER::createDrillFile( FILE* aFile )
         if( tool_reference != hole_descr.m_Tool_Reference )
         {
             tool_reference = hole_descr.m_Tool_Reference;
-            fprintf( m_file, "T%d\n", tool_reference );
+            fprintf( file, "T%d\n", tool_reference );
         }
 
         x0 = hole_descr.m_Hole_Pos.x - m_offset.x;
@@ -218,17 +172,17 @@ int EXCELLON_WRITER::createDrillFile( FILE* aFile )
         yt = y0 * m_conversionUnits;
         writeCoordinates( line, xt, yt );
 
-        fputs( line, m_file );
+        fputs( line, file );
         holes_count++;
     }
 
     /* Read the hole file and generate lines for normal holes (oblong holes
      * will be created later) */
     tool_reference = -2;    // set to a value not used for
-                            // m_holeListBuffer[ii].m_Tool_Reference
-    for( unsigned ii = 0; ii < m_holeListBuffer.size(); ii++ )
+                            // aSet.m_Holes[ii].m_Tool_Reference
+    for( unsigned ii = 0; ii < aSet.m_Holes.size(); ii++ )
     {
-        HOLE_INFO& hole_descr = m_holeListBuffer[ii];
+        const HOLE_INFO& hole_descr = aSet.m_Holes[ii];
 
         if( hole_descr.m_Hole_Shape == 0 )
             continue;  // wait for oblong holes
@@ -236,7 +190,7 @@ int EXCELLON_WRITER::createDrillFile( FILE* aFile )
         if( tool_reference != hole_descr.m_Tool_Reference )
         {
             tool_reference = hole_descr.m_Tool_Reference;
-            fprintf( m_file, "T%d\n", tool_reference );
+            fprintf( file, "T%d\n", tool_reference );
         }
 
         diam = std::min( hole_descr.m_Hole_Size.x, hole_descr.m_Hole_Size.y );
@@ -283,19 +237,19 @@ int EXCELLON_WRITER::createDrillFile( FILE* aFile )
                 line[kk] = 0;
         }
 
-        fputs( line, m_file );
-        fputs( "G85", m_file );    // add the "G85" command
+        fputs( line, file );
+        fputs( "G85", file );    // add the "G85" command
 
         xt = xf * m_conversionUnits;
         yt = yf * m_conversionUnits;
         writeCoordinates( line, xt, yt );
 
-        fputs( line, m_file );
-        fputs( "G05\n", m_file );
+        fputs( line, file );
+        fputs( "G05\n", file );
         holes_count++;
     }
 
-    writeEXCELLONEndOfFile();
+    writeEXCELLONEndOfFile( file );
 
     return holes_count;
 }
@@ -328,11 +282,35 @@ void EXCELLON_WRITER::SetFormat( bool      aMetric,
 }
 
 
-void EXCELLON_WRITER::writeCoordinates( char* aLine, double aCoordX, double aCoordY )
+/* Helper function to remove the trailing '0' of a number written from aStart to aEnd,
+ * keeping its first character.
+ * @return the new end of the number
+ */
+static char* removeTrailingZeros( char* aStart, char* aEnd )
+{
+    while( aEnd - 1 > aStart && aEnd[-1] == '0' )
+        --aEnd;
+
+    *aEnd = 0;
+
+    return aEnd;
+}
+
+
+void EXCELLON_WRITER::writeCoordinates( char* aLine, double aCoordX, double aCoordY ) const
+{
+    *aLine++ = 'X';
+    aLine = formatCoordinate( aLine, aCoordX );
+    *aLine++ = 'Y';
+    aLine = formatCoordinate( aLine, aCoordY );
+    *aLine++ = '\n';
+    *aLine = 0;
+}
+
+
+char* EXCELLON_WRITER::formatCoordinate( char* aBuffer, double aCoord ) const
 {
-    wxString xs, ys;
-    int      xpad = m_precision.m_lhs + m_precision.m_rhs;
-    int      ypad = xpad;
+    int pad = m_precision.m_lhs + m_precision.m_rhs;
 
     switch( m_zeroFormat )
     {
@@ -344,93 +322,41 @@ void EXCELLON_WRITER::writeCoordinates( char* aLine, double aCoordX, double aCoo
          * like in non decimal formats, so we trunk coordinates to 3 or 4 digits in mantissa
          * Decimal format just prohibit useless leading 0:
          * 0.45 or .45 is right, but 00.54 is incorrect.
+         * Useless trailing 0 are removed.
          */
-        if( m_unitsMetric )
-        {
-            // resolution is 1/1000 mm
-            xs.Printf( wxT( "%.3f" ), aCoordX );
-            ys.Printf( wxT( "%.3f" ), aCoordY );
-        }
-        else
-        {
-            // resolution is 1/10000 inch
-            xs.Printf( wxT( "%.4f" ), aCoordX );
-            ys.Printf( wxT( "%.4f" ), aCoordY );
-        }
-
-        //Remove useless trailing 0
-        while( xs.Last() == '0' )
-            xs.RemoveLast();
-
-        while( ys.Last() == '0' )
-            ys.RemoveLast();
-
-        sprintf( aLine, "X%sY%s\n", TO_UTF8( xs ), TO_UTF8( ys ) );
-        break;
+        return removeTrailingZeros( aBuffer,
+                                    FormatFixed( aBuffer, aCoord, m_unitsMetric ? 3 : 4 ) );
 
     case SUPPRESS_LEADING:
         for( int i = 0; i< m_precision.m_rhs; i++ )
-        {
-            aCoordX *= 10; aCoordY *= 10;
-        }
+            aCoord *= 10;
 
-        sprintf( aLine, "X%dY%d\n", KiROUND( aCoordX ), KiROUND( aCoordY ) );
-        break;
+        return FormatInt( aBuffer, KiROUND( aCoord ) );
 
     case SUPPRESS_TRAILING:
-    {
         for( int i = 0; i < m_precision.m_rhs; i++ )
-        {
-            aCoordX *= 10;
-            aCoordY *= 10;
-        }
+            aCoord *= 10;
 
-        if( aCoordX < 0 )
-            xpad++;
+        if( aCoord < 0 )
+            pad++;
 
-        if( aCoordY < 0 )
-            ypad++;
-
-        xs.Printf( wxT( "%0*d" ), xpad, KiROUND( aCoordX ) );
-        ys.Printf( wxT( "%0*d" ), ypad, KiROUND( aCoordY ) );
-
-        size_t j = xs.Len() - 1;
-
-        while( xs[j] == '0' && j )
-            xs.Truncate( j-- );
-
-        j = ys.Len() - 1;
-
-        while( ys[j] == '0' && j )
-            ys.Truncate( j-- );
-
-        sprintf( aLine, "X%sY%s\n", TO_UTF8( xs ), TO_UTF8( ys ) );
-        break;
-    }
+        return removeTrailingZeros( aBuffer, FormatInt( aBuffer, KiROUND( aCoord ), pad ) );
 
     case KEEP_ZEROS:
         for( int i = 0; i< m_precision.m_rhs; i++ )
-        {
-            aCoordX *= 10; aCoordY *= 10;
-        }
-
-        if( aCoordX < 0 )
-            xpad++;
+            aCoord *= 10;
 
-        if( aCoordY < 0 )
-            ypad++;
+        if( aCoord < 0 )
+            pad++;
 
-        xs.Printf( wxT( "%0*d" ), xpad, KiROUND( aCoordX ) );
-        ys.Printf( wxT( "%0*d" ), ypad, KiROUND( aCoordY ) );
-        sprintf( aLine, "X%sY%s\n", TO_UTF8( xs ), TO_UTF8( ys ) );
-        break;
+        return FormatInt( aBuffer, KiROUND( aCoord ), pad );
     }
 }
 
 
-void EXCELLON_WRITER::writeEXCELLONHeader()
+void EXCELLON_WRITER::writeEXCELLONHeader( FILE* aFile ) const
 {
-    fputs( "M48\n", m_file );    // The beginning of a header
+    fputs( "M48\n", aFile );    // The beginning of a header
 
     if( !m_minimalHeader )
     {
@@ -438,7 +364,7 @@ void EXCELLON_WRITER::writeEXCELLONHeader()
         wxString msg;
         msg << wxT("KiCad") << wxT( " " ) << GetBuildVersion();
 
-        fprintf( m_file, ";DRILL file {%s} date %s\n", TO_UTF8( msg ), TO_UTF8( DateAndTime() ) );
+        fprintf( aFile, ";DRILL file {%s} date %s\n", TO_UTF8( msg ), TO_UTF8( DateAndTime() ) );
         msg = wxT( ";FORMAT={" );
 
         // Print precision:
@@ -469,33 +395,33 @@ void EXCELLON_WRITER::writeEXCELLONHeader()
 
         msg << zero_fmt[m_zeroFormat];
         msg << wxT( "}\n" );
-        fputs( TO_UTF8( msg ), m_file );
-        fputs( "FMAT,2\n", m_file );     // Use Format 2 commands (version used since 1979)
+        fputs( TO_UTF8( msg ), aFile );
+        fputs( "FMAT,2\n", aFile );     // Use Format 2 commands (version used since 1979)
     }
 
-    fputs( m_unitsMetric ? "METRIC" : "INCH", m_file );
+    fputs( m_unitsMetric ? "METRIC" : "INCH", aFile );
 
     switch( m_zeroFormat )
     {
     case SUPPRESS_LEADING:
     case DECIMAL_FORMAT:
-        fputs( ",TZ\n", m_file );
+        fputs( ",TZ\n", aFile );
         break;
 
     case SUPPRESS_TRAILING:
-        fputs( ",LZ\n", m_file );
+        fputs( ",LZ\n", aFile );
         break;
 
     case KEEP_ZEROS:
-        fputs( ",TZ\n", m_file ); // TZ is acceptable when all zeros are kept
+        fputs( ",TZ\n", aFile ); // TZ is acceptable when all zeros are kept
         break;
     }
 }
 
 
-void EXCELLON_WRITER::writeEXCELLONEndOfFile()
+void EXCELLON_WRITER::writeEXCELLONEndOfFile( FILE* aFile ) const
 {
     //add if minimal here
-    fputs( "T0\nM30\n", m_file );
-    fclose( m_file );
+    fputs( "T0\nM30\n", aFile );
+    fclose( aFile );
 }
@@ -44,7 +44,6 @@ class OUTPUTFORMATTER;
 class EXCELLON_WRITER: public GENDRILL_WRITER_BASE
 {
 private:
-    FILE*                    m_file;                    // The output file
     bool                     m_minimalHeader;           // True to use minimal header
     bool                     m_mirror;
 
@@ -111,10 +110,12 @@ private:
     /**
      * Function CreateDrillFile
      * Creates an Excellon drill file
-     * @param aFile = an opened file to write to will be closed by CreateDrillFile
-     * @return hole count
+     * @param aFullFilename = the full filename
+     * @param aSet = the holes and tools of the file
+     * @return hole count, or -1 if the file cannot be created
      */
-    int  createDrillFile( FILE * aFile );
+    int  createDrillFile( const wxString& aFullFilename,
+                          const DRILL_HOLE_SET& aSet ) const override;
 
 
     /* Print the DRILL file header. The full header is:
@@ -124,15 +125,20 @@ private:
      * FMAT,2
      * INCH,TZ
      */
-    void writeEXCELLONHeader();
+    void writeEXCELLONHeader( FILE* aFile ) const;
 
-    void writeEXCELLONEndOfFile();
+    void writeEXCELLONEndOfFile( FILE* aFile ) const;
 
     /* Created a line like:
      * X48000Y19500
      * According to the selected format
      */
-    void writeCoordinates( char* aLine, double aCoordX, double aCoordY );
+    void writeCoordinates( char* aLine, double aCoordX, double aCoordY ) const;
+
+    /* Write one coordinate of a line to aBuffer, according to the selected format
+     * @return the end of the coordinate written in aBuffer
+     */
+    char* formatCoordinate( char* aBuffer, double aCoord ) const;
 };
 
 #endif  //  #ifndef _GENDRILL_EXCELLON_WRITER_
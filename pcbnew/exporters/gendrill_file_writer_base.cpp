@@ -26,9 +26,12 @@
 
 #include <class_board.h>
 #include <class_module.h>
-#include <collectors.h>
 #include <reporter.h>
 
+#include <atomic>
+#include <map>
+#include <thread>
+
 #include <gendrill_file_writer_base.h>
 
 
@@ -69,165 +72,141 @@ static bool CmpHoleSorting( const HOLE_INFO& a, const HOLE_INFO& b )
 }
 
 
-void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
-                                           bool aGenerateNPTH_list )
+/* Helper function to sort the holes of a set and build its tool list.
+ */
+static void buildToolList( DRILL_HOLE_SET& aSet )
 {
-    HOLE_INFO new_hole;
-
-    m_holeListBuffer.clear();
-    m_toolListBuffer.clear();
-
-    wxASSERT( aLayerPair.first < aLayerPair.second );  // fix the caller
-
-    // build hole list for vias
-    if( ! aGenerateNPTH_list )  // vias are always plated !
-    {
-        for( VIA* via = GetFirstVia( m_pcb->m_Track ); via; via = GetFirstVia( via->Next() ) )
-        {
-            int hole_sz = via->GetDrillValue();
-
-            if( hole_sz == 0 )   // Should not occur.
-                continue;
-
-            new_hole.m_ItemParent = via;
-            new_hole.m_Tool_Reference = -1;         // Flag value for Not initialized
-            new_hole.m_Hole_Orient    = 0;
-            new_hole.m_Hole_Diameter  = hole_sz;
-            new_hole.m_Hole_NotPlated = false;
-            new_hole.m_Hole_Size.x = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
-
-            new_hole.m_Hole_Shape = 0;              // hole shape: round
-            new_hole.m_Hole_Pos = via->GetStart();
-
-            via->LayerPair( &new_hole.m_Hole_Top_Layer, &new_hole.m_Hole_Bottom_Layer );
-
-            // LayerPair() returns params with m_Hole_Bottom_Layer > m_Hole_Top_Layer
-            // Remember: top layer = 0 and bottom layer = 31 for through hole vias
-            // Any captured via should be from aLayerPair.first to aLayerPair.second exactly.
-            if( new_hole.m_Hole_Top_Layer    != aLayerPair.first ||
-                new_hole.m_Hole_Bottom_Layer != aLayerPair.second )
-                continue;
-
-            m_holeListBuffer.push_back( new_hole );
-        }
-    }
-
-    if( aLayerPair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
-    {
-        // add holes for thru hole pads
-        for( MODULE* module = m_pcb->m_Modules;  module;  module = module->Next() )
-        {
-            for( auto& pad : module->Pads() )
-            {
-                if( !m_merge_PTH_NPTH )
-                {
-                    if( !aGenerateNPTH_list && pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED )
-                        continue;
-
-                    if( aGenerateNPTH_list && pad->GetAttribute() != PAD_ATTRIB_HOLE_NOT_PLATED )
-                        continue;
-                }
-
-                if( pad->GetDrillSize().x == 0 )
-                    continue;
-
-                new_hole.m_ItemParent     = pad;
-                new_hole.m_Hole_NotPlated = (pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED);
-                new_hole.m_Tool_Reference = -1;         // Flag is: Not initialized
-                new_hole.m_Hole_Orient    = pad->GetOrientation();
-                new_hole.m_Hole_Shape     = 0;           // hole shape: round
-                new_hole.m_Hole_Diameter  = std::min( pad->GetDrillSize().x, pad->GetDrillSize().y );
-                new_hole.m_Hole_Size.x    = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
-
-                if( pad->GetDrillShape() != PAD_DRILL_SHAPE_CIRCLE )
-                    new_hole.m_Hole_Shape = 1; // oval flag set
-
-                new_hole.m_Hole_Size         = pad->GetDrillSize();
-                new_hole.m_Hole_Pos          = pad->GetPosition();  // hole position
-                new_hole.m_Hole_Bottom_Layer = B_Cu;
-                new_hole.m_Hole_Top_Layer    = F_Cu;    // pad holes are through holes
-                m_holeListBuffer.push_back( new_hole );
-            }
-        }
-    }
+    std::vector<HOLE_INFO>&  holes = aSet.m_Holes;
+    std::vector<DRILL_TOOL>& tools = aSet.m_Tools;
 
     // Sort holes per increasing diameter value
-    sort( m_holeListBuffer.begin(), m_holeListBuffer.end(), CmpHoleSorting );
+    sort( holes.begin(), holes.end(), CmpHoleSorting );
 
     // build the tool list
     int last_hole = -1;     // Set to not initialized (this is a value not used
-                            // for m_holeListBuffer[ii].m_Hole_Diameter)
+                            // for holes[ii].m_Hole_Diameter)
     bool last_notplated_opt = false;
 
     DRILL_TOOL new_tool( 0, false );
     unsigned   jj;
 
-    for( unsigned ii = 0; ii < m_holeListBuffer.size(); ii++ )
+    for( unsigned ii = 0; ii < holes.size(); ii++ )
     {
-        if( m_holeListBuffer[ii].m_Hole_Diameter != last_hole ||
-            m_holeListBuffer[ii].m_Hole_NotPlated != last_notplated_opt )
+        if( holes[ii].m_Hole_Diameter != last_hole ||
+            holes[ii].m_Hole_NotPlated != last_notplated_opt )
         {
-            new_tool.m_Diameter = m_holeListBuffer[ii].m_Hole_Diameter;
-            new_tool.m_Hole_NotPlated = m_holeListBuffer[ii].m_Hole_NotPlated;
-            m_toolListBuffer.push_back( new_tool );
+            new_tool.m_Diameter = holes[ii].m_Hole_Diameter;
+            new_tool.m_Hole_NotPlated = holes[ii].m_Hole_NotPlated;
+            tools.push_back( new_tool );
             last_hole = new_tool.m_Diameter;
             last_notplated_opt = new_tool.m_Hole_NotPlated;
         }
 
-        jj = m_toolListBuffer.size();
+        jj = tools.size();
 
         if( jj == 0 )
             continue;                                        // Should not occurs
 
-        m_holeListBuffer[ii].m_Tool_Reference = jj;          // Tool value Initialized (value >= 1)
+        holes[ii].m_Tool_Reference = jj;          // Tool value Initialized (value >= 1)
 
-        m_toolListBuffer.back().m_TotalCount++;
+        tools.back().m_TotalCount++;
 
-        if( m_holeListBuffer[ii].m_Hole_Shape )
-            m_toolListBuffer.back().m_OvalCount++;
+        if( holes[ii].m_Hole_Shape )
+            tools.back().m_OvalCount++;
     }
 }
 
 
-std::vector<DRILL_LAYER_PAIR> GENDRILL_WRITER_BASE::getUniqueLayerPairs() const
+std::vector<DRILL_HOLE_SET> GENDRILL_WRITER_BASE::buildHoleSets() const
 {
     wxASSERT( m_pcb );
 
-    static const KICAD_T interesting_stuff_to_collect[] = {
-        PCB_VIA_T,
-        EOT
-    };
+    const DRILL_LAYER_PAIR through( F_Cu, B_Cu );
 
-    PCB_TYPE_COLLECTOR  vias;
+    std::vector<DRILL_HOLE_SET> sets;
 
-    vias.Collect( m_pcb, interesting_stuff_to_collect );
+    sets.emplace_back( through, false );        // always first
 
-    std::set< DRILL_LAYER_PAIR >  unique;
+    // the holes of the blind/buried vias, by layer pair.
+    std::map<DRILL_LAYER_PAIR, std::vector<HOLE_INFO>> partialHoles;
 
-    DRILL_LAYER_PAIR  layer_pair;
+    HOLE_INFO new_hole;
 
-    for( int i = 0; i < vias.GetCount(); ++i )
+    // build hole list for vias (vias are always plated !)
+    for( VIA* via = GetFirstVia( m_pcb->m_Track ); via; via = GetFirstVia( via->Next() ) )
     {
-        VIA*  v = (VIA*) vias[i];
+        // LayerPair() returns params with m_Hole_Bottom_Layer > m_Hole_Top_Layer
+        // Remember: top layer = 0 and bottom layer = 31 for through hole vias
+        via->LayerPair( &new_hole.m_Hole_Top_Layer, &new_hole.m_Hole_Bottom_Layer );
 
-        v->LayerPair( &layer_pair.first, &layer_pair.second );
+        DRILL_LAYER_PAIR pair( new_hole.m_Hole_Top_Layer, new_hole.m_Hole_Bottom_Layer );
 
-        // only make note of blind buried.
-        // thru hole is placed unconditionally as first in fetched list.
-        if( layer_pair != DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
-        {
-            unique.insert( layer_pair );
-        }
+        // A layer pair has its set (and its report) even if its vias have no hole
+        std::vector<HOLE_INFO>& holes = pair == through ? sets[0].m_Holes : partialHoles[pair];
+
+        int hole_sz = via->GetDrillValue();
+
+        if( hole_sz == 0 )   // Should not occur.
+            continue;
+
+        new_hole.m_ItemParent = via;
+        new_hole.m_Tool_Reference = -1;         // Flag value for Not initialized
+        new_hole.m_Hole_Orient    = 0;
+        new_hole.m_Hole_Diameter  = hole_sz;
+        new_hole.m_Hole_NotPlated = false;
+        new_hole.m_Hole_Size.x = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
+
+        new_hole.m_Hole_Shape = 0;              // hole shape: round
+        new_hole.m_Hole_Pos = via->GetStart();
+
+        holes.push_back( new_hole );
     }
 
-    std::vector<DRILL_LAYER_PAIR>    ret;
+    for( auto& pairHoles : partialHoles )
+    {
+        sets.emplace_back( pairHoles.first, false );
+        sets.back().m_Holes.swap( pairHoles.second );
+    }
 
-    ret.push_back( DRILL_LAYER_PAIR( F_Cu, B_Cu ) );      // always first in returned list
+    // append a set for the NPTH holes, for separate drill files.
+    if( !m_merge_PTH_NPTH )
+        sets.emplace_back( through, true );
 
-    for( std::set< DRILL_LAYER_PAIR >::const_iterator it = unique.begin();  it != unique.end(); ++it )
-        ret.push_back( *it );
+    // add holes for thru hole pads
+    for( MODULE* module = m_pcb->m_Modules;  module;  module = module->Next() )
+    {
+        for( auto& pad : module->Pads() )
+        {
+            if( pad->GetDrillSize().x == 0 )
+                continue;
 
-    return ret;
+            new_hole.m_ItemParent     = pad;
+            new_hole.m_Hole_NotPlated = (pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED);
+            new_hole.m_Tool_Reference = -1;         // Flag is: Not initialized
+            new_hole.m_Hole_Orient    = pad->GetOrientation();
+            new_hole.m_Hole_Shape     = 0;           // hole shape: round
+            new_hole.m_Hole_Diameter  = std::min( pad->GetDrillSize().x, pad->GetDrillSize().y );
+            new_hole.m_Hole_Size.x    = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
+
+            if( pad->GetDrillShape() != PAD_DRILL_SHAPE_CIRCLE )
+                new_hole.m_Hole_Shape = 1; // oval flag set
+
+            new_hole.m_Hole_Size         = pad->GetDrillSize();
+            new_hole.m_Hole_Pos          = pad->GetPosition();  // hole position
+            new_hole.m_Hole_Bottom_Layer = B_Cu;
+            new_hole.m_Hole_Top_Layer    = F_Cu;    // pad holes are through holes
+
+            if( new_hole.m_Hole_NotPlated && !m_merge_PTH_NPTH )
+                sets.back().m_Holes.push_back( new_hole );
+            else
+                sets[0].m_Holes.push_back( new_hole );
+        }
+    }
+
+    for( DRILL_HOLE_SET& set : sets )
+        buildToolList( set );
+
+    return sets;
 }
 
 
@@ -287,39 +266,103 @@ const wxString GENDRILL_WRITER_BASE::getDrillFileName( DRILL_LAYER_PAIR aPair, b
     return ret;
 }
 
-void GENDRILL_WRITER_BASE::CreateMapFilesSet( const wxString& aPlotDirectory,
-                                              REPORTER * aReporter )
+void GENDRILL_WRITER_BASE::createDrillFiles( const wxString& aPlotDirectory,
+                                             const std::vector<DRILL_HOLE_SET>& aHoleSets,
+                                             REPORTER* aReporter ) const
 {
-    wxFileName  fn;
-    wxString    msg;
+    std::vector<const DRILL_HOLE_SET*> fileSets;
+    std::vector<wxString>              fullFilenames;
+
+    for( const DRILL_HOLE_SET& set : aHoleSets )
+    {
+        // The file is created if it has holes, or if it is the non plated drill file
+        // to be sure the NPTH file is up to date in separate files mode.
+        if( set.m_Holes.size() > 0 || set.m_NPTH )
+        {
+            wxFileName fn = getDrillFileName( set.m_Pair, set.m_NPTH, m_merge_PTH_NPTH );
+            fn.SetPath( aPlotDirectory );
+
+            fileSets.push_back( &set );
+            fullFilenames.push_back( fn.GetFullPath() );
+        }
+    }
 
-    std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
+    std::vector<int>    results( fileSets.size() );
+    std::atomic<size_t> nextFile( 0 );
 
-    // append a pair representing the NPTH set of holes, for separate drill files.
-    if( !m_merge_PTH_NPTH )
-        hole_sets.push_back( DRILL_LAYER_PAIR( F_Cu, B_Cu ) );
+    auto writer = [&]()
+    {
+        for( size_t ii = nextFile.fetch_add( 1 ); ii < fileSets.size();
+             ii = nextFile.fetch_add( 1 ) )
+        {
+            results[ii] = createDrillFile( fullFilenames[ii], *fileSets[ii] );
+        }
+    };
 
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
     {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = m_merge_PTH_NPTH ? false : ( it == hole_sets.end() - 1 );
+        // Switch to the C locale once for all the writers, rather than letting each
+        // writer thread toggle it.
+        LOCALE_IO toggle;
 
-        buildHolesList( pair, doing_npth );
+        size_t parallelThreadCount = std::min<size_t>( fileSets.size(),
+                std::max<size_t>( std::thread::hardware_concurrency(), 2 ) );
+        std::vector<std::thread> writers;
 
+        // The calling thread is one of the writers
+        for( size_t ii = 1; ii < parallelThreadCount; ++ii )
+            writers.push_back( std::thread( writer ) );
+
+        writer();
+
+        for( size_t ii = 0; ii < writers.size(); ++ii )
+            writers[ii].join();
+    }
+
+    if( !aReporter )
+        return;
+
+    wxString msg;
+
+    for( size_t ii = 0; ii < fileSets.size(); ++ii )
+    {
+        if( results[ii] < 0 )
+            msg.Printf( _( "** Unable to create %s **\n" ), GetChars( fullFilenames[ii] ) );
+        else
+            msg.Printf( _( "Create file %s\n" ), GetChars( fullFilenames[ii] ) );
+
+        aReporter->Report( msg );
+    }
+}
+
+
+void GENDRILL_WRITER_BASE::CreateMapFilesSet( const wxString& aPlotDirectory,
+                                              REPORTER * aReporter )
+{
+    createMapFiles( aPlotDirectory, buildHoleSets(), aReporter );
+}
+
+
+void GENDRILL_WRITER_BASE::createMapFiles( const wxString& aPlotDirectory,
+                                           const std::vector<DRILL_HOLE_SET>& aHoleSets,
+                                           REPORTER* aReporter )
+{
+    wxFileName  fn;
+    wxString    msg;
+
+    for( const DRILL_HOLE_SET& set : aHoleSets )
+    {
         // The file is created if it has holes, or if it is the non plated drill file
         // to be sure the NPTH file is up to date in separate files mode.
-        if( getHolesCount() > 0 || doing_npth )
+        if( set.m_Holes.size() > 0 || set.m_NPTH )
         {
-            fn = getDrillFileName( pair, doing_npth, m_merge_PTH_NPTH );
+            fn = getDrillFileName( set.m_Pair, set.m_NPTH, m_merge_PTH_NPTH );
             fn.SetPath( aPlotDirectory );
 
             fn.SetExt( wxEmptyString ); // Will be added by GenDrillMap
             wxString fullfilename = fn.GetFullPath() + wxT( "-drl_map" );
             fullfilename << wxT(".") << GetDefaultPlotExtension( m_mapFileFmt );
 
-            bool success = genDrillMapFile( fullfilename, m_mapFileFmt );
+            bool success = genDrillMapFile( fullfilename, m_mapFileFmt, set );
 
             if( ! success )
             {
@@ -117,6 +117,28 @@ public:
 
 typedef std::pair<PCB_LAYER_ID, PCB_LAYER_ID>   DRILL_LAYER_PAIR;
 
+
+/* the DRILL_HOLE_SET class handles the holes and tools of one drill file:
+ * the plated holes of a layer pair, or the not plated holes.
+ * Holes are sorted by tool, and their m_Tool_Reference is the index + 1 of their tool.
+ */
+class DRILL_HOLE_SET
+{
+public:
+    DRILL_LAYER_PAIR        m_Pair;     // the layers connected by the holes
+    bool                    m_NPTH;     // true for the not plated holes of separate files
+    std::vector<HOLE_INFO>  m_Holes;
+    std::vector<DRILL_TOOL> m_Tools;
+
+public:
+    DRILL_HOLE_SET( DRILL_LAYER_PAIR aPair, bool aNPTH ) :
+        m_Pair( aPair ),
+        m_NPTH( aNPTH )
+    {
+    }
+};
+
+
 /**
  * GENDRILL_WRITER_BASE is a class to create drill maps and drill report,
  * and a helper class to created drill files.
@@ -143,8 +165,6 @@ protected:
                                                         // Excellon/Gerber units (i.e inches or mm)
     wxPoint                  m_offset;                  // Drill offset coordinates
     bool                     m_merge_PTH_NPTH;          // True to generate only one drill file
-    std::vector<HOLE_INFO>   m_holeListBuffer;          // Buffer containing holes
-    std::vector<DRILL_TOOL>  m_toolListBuffer;          // Buffer containing tools
 
     PlotFormat               m_mapFileFmt;              // the format of the map drill file,
                                                         // if this map is needed
@@ -262,36 +282,62 @@ public:
     bool GenDrillReportFile( const wxString& aFullFileName );
 
 protected:
+    /**
+     * Function createDrillFile
+     * Creates the drill file of a hole set, in the format of the derived class.
+     * It is called concurrently for the sets of a board, so it must not modify the writer.
+     * @param aFullFilename = the full filename
+     * @param aSet = the holes and tools of the file
+     * @return hole count, or -1 if the file cannot be created
+     */
+    virtual int createDrillFile( const wxString& aFullFilename,
+                                 const DRILL_HOLE_SET& aSet ) const = 0;
+
+    /**
+     * Function createDrillFiles
+     * Creates the drill files of aHoleSets, each one on its own thread,
+     * and reports them in the order of the sets.
+     * A file is created for each set having holes, and for the NPTH set,
+     * to be sure the NPTH file is up to date in separate files mode.
+     * @param aPlotDirectory = the output folder
+     * @param aHoleSets = the sets returned by buildHoleSets()
+     * @param aReporter = a REPORTER to return activity or any message (can be NULL)
+     */
+    void createDrillFiles( const wxString& aPlotDirectory,
+                           const std::vector<DRILL_HOLE_SET>& aHoleSets,
+                           REPORTER* aReporter ) const;
+
+    /**
+     * Function createMapFiles
+     * Creates the map files of aHoleSets, as CreateMapFilesSet().
+     */
+    void createMapFiles( const wxString& aPlotDirectory,
+                         const std::vector<DRILL_HOLE_SET>& aHoleSets,
+                         REPORTER* aReporter );
+
     /**
      * Function GenDrillMapFile
      * Plot a map of drill marks for holes.
-     * Hole list must be created before calling this function, by buildHolesList()
-     * for the right holes set (PTH, NPTH, buried/blind vias ...)
      * the paper sheet to use to plot the map is set in m_pageInfo
      * ( calls SetPageInfo() to set it )
      * if NULL, A4 format will be used
      * @param aFullFileName : the full filename of the map file to create,
      * @param aFormat : one of the supported plot formats (see enum PlotFormat )
+     * @param aSet : the holes set (PTH, NPTH, buried/blind vias ...) to plot
      */
-    bool genDrillMapFile( const wxString& aFullFileName, PlotFormat aFormat );
+    bool genDrillMapFile( const wxString& aFullFileName, PlotFormat aFormat,
+                          const DRILL_HOLE_SET& aSet );
 
     /**
-     * Function BuildHolesList
-     * Create the list of holes and tools for a given board
-     * The list is sorted by increasing drill size.
-     * Only holes included within aLayerPair are listed.
-     * If aLayerPair identifies with [F_Cu, B_Cu], then
-     * pad holes are always included also.
-     *
-     * @param aLayerPair is an inclusive range of layers.
-     * @param aGenerateNPTH_list :
-     *       true to create NPTH only list (with no plated holes)
-     *       false to created plated holes list (with no NPTH )
+     * Function buildHoleSets
+     * Create the lists of holes and tools of all the drill files of the board,
+     * walking the vias and pads only once.
+     * Each list is sorted by increasing drill size.
+     * The first set is the [F_Cu, B_Cu] pair, which has the pad holes also,
+     * followed by the sets of the blind/buried vias layer pairs, in layer order,
+     * and by the NPTH set when PTH and NPTH are not merged.
      */
-    void buildHolesList( DRILL_LAYER_PAIR aLayerPair,
-                         bool aGenerateNPTH_list );
-
-    int  getHolesCount() const { return m_holeListBuffer.size(); }
+    std::vector<DRILL_HOLE_SET> buildHoleSets() const;
 
     /** Helper function.
      * Writes the drill marks in HPGL, POSTSCRIPT or other supported formats
@@ -300,19 +346,19 @@ protected:
      * If more than PLOTTER::MARKER_COUNT different values,
      * these other values share the same mark shape
      * @param aPlotter = a PLOTTER instance (HPGL, POSTSCRIPT ... plotter).
+     * @param aHoles = the holes to plot
      */
-    bool plotDrillMarks( PLOTTER* aPlotter );
-
-    /// Get unique layer pairs by examining the micro and blind_buried vias.
-    std::vector<DRILL_LAYER_PAIR> getUniqueLayerPairs() const;
+    bool plotDrillMarks( PLOTTER* aPlotter, const std::vector<HOLE_INFO>& aHoles );
 
     /**
      * Function printToolSummary
-     * prints m_toolListBuffer[] tools to aOut and returns total hole count.
+     * prints aTools to aOut and returns total hole count.
      * @param aOut = the current OUTPUTFORMATTER to print summary
+     * @param aTools = the tools of a hole set
      * @param aSummaryNPTH = true to print summary for NPTH, false for PTH
      */
-    unsigned printToolSummary( OUTPUTFORMATTER& aOut, bool aSummaryNPTH ) const;
+    unsigned printToolSummary( OUTPUTFORMATTER& aOut, const std::vector<DRILL_TOOL>& aTools,
+                               bool aSummaryNPTH ) const;
 
     /**
      * minor helper function.
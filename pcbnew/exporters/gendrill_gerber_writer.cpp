@@ -66,70 +66,25 @@ void GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
     // Note: In Gerber drill files, NPTH and PTH are always separate files
     m_merge_PTH_NPTH = false;
 
-    wxFileName  fn;
-    wxString    msg;
+    std::vector<DRILL_HOLE_SET> hole_sets = buildHoleSets();
 
-    std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
-
-    // append a pair representing the NPTH set of holes, for separate drill files.
-    // (Gerber drill files are separate files for PTH and NPTH)
-    hole_sets.push_back( DRILL_LAYER_PAIR( F_Cu, B_Cu ) );
-
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
-    {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = ( it == hole_sets.end() - 1 );
-
-        buildHolesList( pair, doing_npth );
-
-        // The file is created if it has holes, or if it is the non plated drill file
-        // to be sure the NPTH file is up to date in separate files mode.
-        if( getHolesCount() > 0 || doing_npth )
-        {
-            fn = getDrillFileName( pair, doing_npth, false );
-            fn.SetPath( aPlotDirectory );
-
-            if( aGenDrill )
-            {
-                wxString fullFilename = fn.GetFullPath();
-
-                int result = createDrillFile( fullFilename, doing_npth, pair.first, pair.second );
-
-                if( result < 0 )
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "** Unable to create %s **\n" ), GetChars( fullFilename ) );
-                        aReporter->Report( msg );
-                    }
-                    break;
-                }
-                else
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Create file %s\n" ), GetChars( fullFilename ) );
-                        aReporter->Report( msg );
-                    }
-                }
-
-            }
-        }
-    }
+    if( aGenDrill )
+        createDrillFiles( aPlotDirectory, hole_sets, aReporter );
 
     if( aGenMap )
-        CreateMapFilesSet( aPlotDirectory, aReporter );
+        createMapFiles( aPlotDirectory, hole_sets, aReporter );
 }
 
 // A helper class to transform an oblong hole to a segment
 static void convertOblong2Segment( wxSize aSize, double aOrient, wxPoint& aStart, wxPoint& aEnd );
 
-int GERBER_WRITER::createDrillFile( wxString& aFullFilename, bool aIsNpth,
-                                    int aLayer1, int aLayer2 )
+int GERBER_WRITER::createDrillFile( const wxString& aFullFilename,
+                                    const DRILL_HOLE_SET& aSet ) const
 {
     int    holes_count;
+    bool   isNpth = aSet.m_NPTH;
+    int    layer1 = aSet.m_Pair.first;
+    int    layer2 = aSet.m_Pair.second;
 
     LOCALE_IO dummy;    // Use the standard notation for double numbers
 
@@ -150,7 +105,7 @@ int GERBER_WRITER::createDrillFile( wxString& aFullFilename, bool aIsNpth,
     // %TF.FileFunction,Plated[NonPlated],layer1num,layer2num,PTH[NPTH][Blind][Buried],Drill[Route][Mixed]*%
     wxString text( "%TF.FileFunction," );
 
-    if( aIsNpth )
+    if( isNpth )
         text << "NonPlated,";
     else
         text << "Plated,";
@@ -158,25 +113,25 @@ int GERBER_WRITER::createDrillFile( wxString& aFullFilename, bool aIsNpth,
     // In Gerber files, layers num are 1 to copper layer count instead of F_Cu to B_Cu
     // (0 to copper layer count-1)
     // Note also for a n copper layers board, gerber layers num are 1 ... n
-    aLayer1 += 1;
+    layer1 += 1;
 
-    if( aLayer2 == B_Cu )
-        aLayer2 = m_pcb->GetCopperLayerCount();
+    if( layer2 == B_Cu )
+        layer2 = m_pcb->GetCopperLayerCount();
     else
-        aLayer2 += 1;
+        layer2 += 1;
 
-    text << aLayer1 << ",";
-    text << aLayer2 << ",";
+    text << layer1 << ",";
+    text << layer2 << ",";
 
     // Now add PTH or NPTH or Blind or Buried attribute
     int toplayer = 1;
     int bottomlayer = m_pcb->GetCopperLayerCount();
 
-    if( aIsNpth )
+    if( isNpth )
         text << "NPTH";
-    else if( aLayer1 == toplayer && aLayer2 == bottomlayer )
+    else if( layer1 == toplayer && layer2 == bottomlayer )
         text << "PTH";
-    else if( aLayer1 == toplayer || aLayer2 == bottomlayer )
+    else if( layer1 == toplayer || layer2 == bottomlayer )
         text << "Blind";
     else
         text << "Buried";
@@ -188,9 +143,9 @@ int GERBER_WRITER::createDrillFile( wxString& aFullFilename, bool aIsNpth,
     bool hasOblong = false;
     bool hasDrill = false;
 
-    for( unsigned ii = 0; ii < m_holeListBuffer.size(); ii++ )
+    for( unsigned ii = 0; ii < aSet.m_Holes.size(); ii++ )
     {
-        HOLE_INFO& hole_descr = m_holeListBuffer[ii];
+        const HOLE_INFO& hole_descr = aSet.m_Holes[ii];
 
         if( hole_descr.m_Hole_Shape )   // m_Hole_Shape not 0 is an oblong hole)
             hasOblong = true;
@@ -226,9 +181,9 @@ int GERBER_WRITER::createDrillFile( wxString& aFullFilename, bool aIsNpth,
     wxPoint hole_pos;
     bool last_item_is_via = true;   // a flag to clear object attributes when a via hole is created.
 
-    for( unsigned ii = 0; ii < m_holeListBuffer.size(); ii++ )
+    for( unsigned ii = 0; ii < aSet.m_Holes.size(); ii++ )
     {
-        HOLE_INFO& hole_descr = m_holeListBuffer[ii];
+        const HOLE_INFO& hole_descr = aSet.m_Holes[ii];
         hole_pos = hole_descr.m_Hole_Pos;
 
         // Manage the aperture attributes: in drill files 3 attributes can be used:
@@ -81,15 +81,14 @@ public:
 private:
     /**
      * Function createDrillFile
-     * Creates an Excellon drill file
+     * Creates a Gerber drill file
      * @param aFullFilename = the full filename
-     * @param aIsNpth = true for a NPTH file, false for a PTH file
-     * @param aLayer1 = the first board layer
-     * @param aLayer2 = the last board layer
-     * for blind buried vias, they are not always top and bottom layers
+     * @param aSet = the holes and tools of the file. For blind buried vias, its layers
+     * are not always top and bottom layers
      * @return hole count, or -1 if the file cannot be created
      */
-    int  createDrillFile( wxString& aFullFilename, bool aIsNpth, int aLayer1, int aLayer2 );
+    int  createDrillFile( const wxString& aFullFilename,
+                          const DRILL_HOLE_SET& aSet ) const override;
 
     /**
      * @return a filename which identify the drill file function.
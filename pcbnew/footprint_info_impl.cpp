@@ -38,10 +38,84 @@
 #include <wildcards_and_files_ext.h>
 #include <widgets/progress_reporter.h>
 
+#include <richio.h>
+
+#include <wx/filename.h>
+
 #include <thread>
 #include <mutex>
 
 
+///> Name of the footprint info cache file, in the user configuration directory.
+static const wxChar FP_INFO_CACHE_FILE[] = wxT( "fp-info-cache" );
+
+///> Version of the footprint info cache file format.
+static const int FP_INFO_CACHE_VERSION = 1;
+
+
+static wxString cacheFileName()
+{
+    wxFileName fn( GetKicadConfigPath(), FP_INFO_CACHE_FILE );
+
+    return fn.GetFullPath();
+}
+
+
+// The cache file holds one field per line: line breaks and backslashes in the
+// footprint fields are escaped.
+static std::string escapeField( const wxString& aField )
+{
+    std::string field = TO_UTF8( aField );
+    std::string escaped;
+
+    escaped.reserve( field.size() );
+
+    for( char c : field )
+    {
+        if( c == '\\' )
+            escaped += "\\\\";
+        else if( c == '\n' )
+            escaped += "\\n";
+        else if( c == '\r' )
+            escaped += "\\r";
+        else
+            escaped += c;
+    }
+
+    return escaped;
+}
+
+
+static wxString unescapeField( const char* aLine )
+{
+    std::string field;
+
+    for( const char* c = aLine; *c && *c != '\n' && *c != '\r'; ++c )
+    {
+        if( *c == '\\' && c[1] )
+        {
+            ++c;
+            field += *c == 'n' ? '\n' : *c == 'r' ? '\r' : *c;
+        }
+        else
+        {
+            field += *c;
+        }
+    }
+
+    return FROM_UTF8( field.c_str() );
+}
+
+
+static wxString readField( LINE_READER& aReader )
+{
+    if( !aReader.ReadLine() )
+        THROW_IO_ERROR( _( "Unexpected end of footprint info cache file" ) );
+
+    return unescapeField( aReader.Line() );
+}
+
+
 void FOOTPRINT_INFO_IMPL::load()
 {
     FP_LIB_TABLE* fptable = m_owner->GetTable();
@@ -119,7 +193,8 @@ void FOOTPRINT_LIST_IMPL::loader_job()
 bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* aNickname,
                                               PROGRESS_REPORTER* aProgressReporter )
 {
-    if( m_list_timestamp == aTable->GenerateTimestamp( aNickname ) )
+    // A null timestamp means the list was never read: don't compute the table timestamp
+    if( m_list_timestamp && m_list_timestamp == aTable->GenerateTimestamp( aNickname ) )
         return true;
 
     m_progress_reporter = aProgressReporter;
@@ -182,12 +257,26 @@ void FOOTPRINT_LIST_IMPL::StartWorkers( FP_LIB_TABLE* aTable, wxString const* aN
     m_queue_in.clear();
     m_queue_out.clear();
 
+    m_lib_timestamps.clear();
+    m_cached_list.clear();
+
     if( aNickname )
         m_queue_in.push( *aNickname );
     else
     {
-        for( auto const& nickname : aTable->GetLogicalLibs() )
-            m_queue_in.push( nickname );
+        std::vector<wxString> nicknames = aTable->GetLogicalLibs();
+
+        for( auto const& nickname : nicknames )
+            m_lib_timestamps[nickname] = aTable->GenerateTimestamp( &nickname );
+
+        // Only the libraries changed since the cache was written are enumerated
+        std::set<wxString> cachedLibs = readCacheFile();
+
+        for( auto const& nickname : nicknames )
+        {
+            if( !cachedLibs.count( nickname ) )
+                m_queue_in.push( nickname );
+        }
     }
 
     m_loader->m_total_libs = m_queue_in.size();
@@ -211,6 +300,7 @@ void FOOTPRINT_LIST_IMPL::StopWorkers()
 
     m_threads.clear();
     m_queue_in.clear();
+    m_cached_list.clear();
     m_count_finished.store( 0 );
 
     // If we have cancelled in the middle of a load, clear our timestamp to re-load next time
@@ -307,6 +397,11 @@ bool FOOTPRINT_LIST_IMPL::JoinWorkers()
     while( queue_parsed.pop( fpi ) )
         m_list.push_back( std::move( fpi ) );
 
+    for( auto& cached : m_cached_list )
+        m_list.push_back( std::move( cached ) );
+
+    m_cached_list.clear();
+
     std::sort( m_list.begin(), m_list.end(),
             []( std::unique_ptr<FOOTPRINT_INFO> const&     lhs,
                     std::unique_ptr<FOOTPRINT_INFO> const& rhs ) -> bool { return *lhs < *rhs; } );
@@ -316,10 +411,129 @@ bool FOOTPRINT_LIST_IMPL::JoinWorkers()
     else
         m_list_timestamp = m_lib_table->GenerateTimestamp( m_library );
 
+    if( !m_cancelled && !m_library && m_errors.empty() )
+        writeCacheFile();
+
     return m_errors.empty();
 }
 
 
+std::set<wxString> FOOTPRINT_LIST_IMPL::readCacheFile()
+{
+    std::set<wxString> cachedLibs;
+
+    if( !wxFileName::FileExists( cacheFileName() ) )
+        return cachedLibs;
+
+    try
+    {
+        FILE_LINE_READER reader( cacheFileName() );
+        long             value;
+
+        if( !readField( reader ).ToLong( &value ) || value != FP_INFO_CACHE_VERSION )
+            return cachedLibs;
+
+        while( reader.ReadLine() )
+        {
+            wxString  nickname = unescapeField( reader.Line() );
+            long long timestamp;
+            long      count;
+
+            if( !readField( reader ).ToLongLong( &timestamp )
+                    || !readField( reader ).ToLong( &count ) )
+            {
+                THROW_IO_ERROR( _( "Malformed footprint info cache file" ) );
+            }
+
+            auto libTimestamp = m_lib_timestamps.find( nickname );
+            bool upToDate = libTimestamp != m_lib_timestamps.end()
+                                    && libTimestamp->second == timestamp;
+
+            for( long ii = 0; ii < count; ++ii )
+            {
+                wxString fpname = readField( reader );
+                long     padCount, uniquePadCount;
+
+                if( !readField( reader ).ToLong( &padCount )
+                        || !readField( reader ).ToLong( &uniquePadCount ) )
+                {
+                    THROW_IO_ERROR( _( "Malformed footprint info cache file" ) );
+                }
+
+                wxString keywords = readField( reader );
+                wxString doc = readField( reader );
+
+                if( upToDate )
+                {
+                    m_cached_list.push_back( std::make_unique<FOOTPRINT_INFO_IMPL>( this,
+                            nickname, fpname, doc, keywords, padCount, uniquePadCount ) );
+                }
+            }
+
+            if( upToDate )
+                cachedLibs.insert( nickname );
+        }
+    }
+    catch( const IO_ERROR& )
+    {
+        // An unreadable cache is not an error: every library is read again
+        m_cached_list.clear();
+        cachedLibs.clear();
+    }
+
+    return cachedLibs;
+}
+
+
+void FOOTPRINT_LIST_IMPL::writeCacheFile()
+{
+    wxString fileName = cacheFileName();
+    wxString tempFileName = fileName + wxT( ".tmp" );
+
+    try
+    {
+        FILE_OUTPUTFORMATTER formatter( tempFileName );
+
+        formatter.Print( 0, "%d\n", FP_INFO_CACHE_VERSION );
+
+        // m_list is sorted by library, so the footprints of a library are contiguous
+        for( size_t ii = 0; ii < m_list.size(); )
+        {
+            const wxString& nickname = m_list[ii]->GetNickname();
+            size_t          end = ii;
+
+            while( end < m_list.size() && m_list[end]->GetNickname() == nickname )
+                ++end;
+
+            formatter.Print( 0, "%s\n%lld\n%d\n", escapeField( nickname ).c_str(),
+                             m_lib_timestamps[nickname], int( end - ii ) );
+
+            for( ; ii < end; ++ii )
+            {
+                FOOTPRINT_INFO* fpinfo = m_list[ii].get();
+
+                formatter.Print( 0, "%s\n%u\n%u\n%s\n%s\n",
+                                 escapeField( fpinfo->GetFootprintName() ).c_str(),
+                                 fpinfo->GetPadCount(),
+                                 fpinfo->GetUniquePadCount(),
+                                 escapeField( fpinfo->GetKeywords() ).c_str(),
+                                 escapeField( fpinfo->GetDoc() ).c_str() );
+            }
+        }
+    }
+    catch( const IO_ERROR& )
+    {
+        // The cache is only an optimization: failing to write it is not an error
+        wxRemoveFile( tempFileName );
+        return;
+    }
+
+    // Replace the old cache only when the new one is complete
+    if( !wxRenameFile( tempFileName, fileName ) )
+        wxRemoveFile( tempFileName );
+}
+
+
 FOOTPRINT_LIST_IMPL::FOOTPRINT_LIST_IMPL() :
     m_loader( nullptr ),
     m_library( nullptr ),
@@ -22,7 +22,9 @@
 
 #include <atomic>
 #include <functional>
+#include <map>
 #include <memory>
+#include <set>
 #include <thread>
 #include <vector>
 
@@ -49,6 +51,24 @@ public:
 #endif
     }
 
+    /**
+     * Build an already loaded footprint info, from data read from the footprint info cache.
+     */
+    FOOTPRINT_INFO_IMPL( FOOTPRINT_LIST* aOwner, const wxString& aNickname,
+                         const wxString& aFootprintName, const wxString& aDoc,
+                         const wxString& aKeywords, int aPadCount, int aUniquePadCount )
+    {
+        m_owner = aOwner;
+        m_loaded = true;
+        m_nickname = aNickname;
+        m_fpname = aFootprintName;
+        m_num = 0;
+        m_pad_count = aPadCount;
+        m_unique_pad_count = aUniquePadCount;
+        m_doc = aDoc;
+        m_keywords = aKeywords;
+    }
+
 protected:
     virtual void load() override;
 };
@@ -67,6 +87,12 @@ class FOOTPRINT_LIST_IMPL : public FOOTPRINT_LIST
     std::atomic_bool         m_cancelled;
     std::mutex               m_join;
 
+    ///> Timestamps of the libraries being read, by nickname
+    std::map<wxString, long long> m_lib_timestamps;
+
+    ///> Footprints of the libraries found up to date in the footprint info cache
+    FPILIST                  m_cached_list;
+
     /**
      * Call aFunc, pushing any IO_ERRORs and std::exceptions it throws onto m_errors.
      *
@@ -87,6 +113,19 @@ protected:
      */
     void loader_job();
 
+    /**
+     * Read the footprint info cache file, keeping in m_cached_list the footprints of the
+     * libraries whose timestamp in the cache matches m_lib_timestamps.
+     * @return the nicknames of these libraries.
+     */
+    std::set<wxString> readCacheFile();
+
+    /**
+     * Write m_list and m_lib_timestamps to the footprint info cache file, so the next
+     * session does not have to enumerate the libraries which have not been changed.
+     */
+    void writeCacheFile();
+
 public:
     FOOTPRINT_LIST_IMPL();
     virtual ~FOOTPRINT_LIST_IMPL();
@@ -41,6 +41,7 @@
 #include <class_drawsegment.h>
 #include <class_edge_mod.h>
 #include <gpcb_plugin.h>
+#include <dir_watcher.h>
 
 #include <wx/dir.h>
 #include <wx/filename.h>
@@ -145,6 +146,16 @@ class GPCB_FPL_CACHE
     long long       m_cache_timestamp;  // A hash of the timestamps for all the footprint
                                         // files.
 
+    std::unique_ptr<DIR_WATCHER> m_watcher; // Tells if the library has changed since loaded
+    bool            m_has_symlinks;     // Changes in the targets of symlinks are not seen
+                                        // by m_watcher
+
+    /// Return true if m_watcher can tell alone if the footprint files have changed.
+    bool isWatched() const
+    {
+        return m_watcher && m_watcher->IsWatching() && !m_has_symlinks;
+    }
+
     MODULE* parseMODULE( LINE_READER* aLineReader );
 
     /**
@@ -230,6 +241,7 @@ GPCB_FPL_CACHE::GPCB_FPL_CACHE( GPCB_PLUGIN* aOwner, const wxString& aLibraryPat
     m_lib_path.SetPath( aLibraryPath );
     m_cache_timestamp = 0;
     m_cache_dirty = true;
+    m_has_symlinks = false;
 }
 
 
@@ -238,7 +250,8 @@ void GPCB_FPL_CACHE::Load()
     // Note: like our .pretty footprint libraries, the gpcb footprint libraries are folders,
     // and the footprints are the .fp files inside this folder.
 
-    wxDir dir( m_lib_path.GetPath() );
+    wxDir    dir( m_lib_path.GetPath() );
+    wxString wildcard = wxT( "*." ) + GedaPcbFootprintLibFileExtension;
 
     if( !dir.IsOpened() )
     {
@@ -250,12 +263,15 @@ void GPCB_FPL_CACHE::Load()
     }
     else
     {
-        m_cache_timestamp = m_lib_path.GetModificationTime().GetValue().GetValue();
+        // Watch and timestamp before reading, so files changed while being read are seen
+        m_watcher.reset( new DIR_WATCHER( m_lib_path.GetPath() ) );
+        m_has_symlinks = false;
+        m_cache_timestamp = DIR_WATCHER::Timestamp( m_lib_path.GetPath(), wildcard,
+                                                    &m_has_symlinks );
         m_cache_dirty = false;
     }
 
     wxString fpFileName;
-    wxString wildcard = wxT( "*." ) + GedaPcbFootprintLibFileExtension;
 
     if( !dir.GetFirst( &fpFileName, wildcard, wxDIR_FILES ) )
         return;
@@ -338,20 +354,27 @@ long long GPCB_FPL_CACHE::GetTimestamp()
     if( m_cache_dirty )
         return wxDateTime::Now().GetValue().GetValue();
 
-    long long files_timestamp = 0;
-
-    if( m_lib_path.DirExists() )
+    // When the library is watched, the files have not changed unless the watcher says so
+    if( isWatched() )
     {
-        files_timestamp = m_lib_path.GetModificationTime().GetValue().GetValue();
+        if( !m_watcher->IsModified() )
+            return m_cache_timestamp;
 
-        for( MODULE_CITER it = m_modules.begin();  it != m_modules.end();  ++it )
-        {
-            wxFileName moduleFile = it->second->GetFileName();
-            if( moduleFile.FileExists() )
-                files_timestamp += moduleFile.GetModificationTime().GetValue().GetValue();
-        }
+        m_cache_dirty = true;
+        return wxDateTime::Now().GetValue().GetValue();
+    }
+
+    // Without change notifications, a new, removed or renamed file is seen from the
+    // directory timestamp alone
+    if( m_watcher && m_watcher->IsModified() )
+    {
+        m_cache_dirty = true;
+        return wxDateTime::Now().GetValue().GetValue();
     }
 
+    wxString  wildcard = wxT( "*." ) + GedaPcbFootprintLibFileExtension;
+    long long files_timestamp = DIR_WATCHER::Timestamp( m_lib_path.GetPath(), wildcard );
+
     // If the new timestamp doesn't match the cache timestamp, then save ourselves the
     // expensive calls next time
     if( m_cache_timestamp != files_timestamp )
@@ -45,6 +45,7 @@
 #include <kicad_plugin.h>
 #include <pcb_parser.h>
 
+#include <dir_watcher.h>
 #include <wx/dir.h>
 #include <wx/filename.h>
 #include <wx/wfstream.h>
@@ -58,6 +59,27 @@ using namespace PCB_KEYS_T;
 #define FMT_ANGLE  BOARD_ITEM::FormatAngle
 
 
+/**
+ * Function appendXY
+ * appends "(xy x y)" to \a aOut, as Print( 0, "(xy %s %s)", FMT_IU( aX ), FMT_IU( aY ) )
+ * would, but in a single write and without temporary strings: the points of zones and
+ * polygons are the bulk of a board file.
+ */
+static void appendXY( OUTPUTFORMATTER* aOut, int aX, int aY )
+{
+    char  buf[64];
+    char* p = buf;
+
+    memcpy( p, "(xy ", 4 );
+    p = BOARD_ITEM::FormatInternalUnits( p + 4, aX );
+    *p++ = ' ';
+    p = BOARD_ITEM::FormatInternalUnits( p, aY );
+    *p++ = ')';
+
+    aOut->Append( buf, p - buf );
+}
+
+
 ///> Removes empty nets (i.e. with node count equal zero) from net classes
 void filterNetClass( const BOARD& aBoard, NETCLASS& aNetClass )
 {
@@ -121,6 +143,16 @@ class FP_CACHE
     long long       m_cache_timestamp;  // A hash of the timestamps for all the footprint
                                         // files.
 
+    std::unique_ptr<DIR_WATCHER> m_watcher; // Tells if the library has changed since loaded
+    bool            m_has_symlinks;     // Changes in the targets of symlinks are not seen
+                                        // by m_watcher
+
+    /// Return true if m_watcher can tell alone if the footprint files have changed.
+    bool isWatched() const
+    {
+        return m_watcher && m_watcher->IsWatching() && !m_has_symlinks;
+    }
+
 public:
     FP_CACHE( PCB_IO* aOwner, const wxString& aLibraryPath );
 
@@ -153,6 +185,14 @@ public:
      */
     long long GetTimestamp();
 
+    /**
+     * Function GetTimestamp
+     * Generate the timestamp of the library at \a aLibPath from the modification times
+     * of the directory and of all its footprint files, without loading it.  The cache
+     * timestamps are all computed here so they can be compared.
+     */
+    static long long GetTimestamp( const wxString& aLibPath );
+
     /**
      * Function IsModified
      * Return true if the cache is not up-to-date.
@@ -181,13 +221,12 @@ FP_CACHE::FP_CACHE( PCB_IO* aOwner, const wxString& aLibraryPath )
     m_lib_path.SetPath( aLibraryPath );
     m_cache_timestamp = 0;
     m_cache_dirty = true;
+    m_has_symlinks = false;
 }
 
 
 void FP_CACHE::Save( MODULE* aModule )
 {
-    m_cache_timestamp = 0;
-
     if( !m_lib_path.DirExists() && !m_lib_path.Mkdir() )
     {
         THROW_IO_ERROR( wxString::Format( _( "Cannot create footprint library path \"%s\"" ),
@@ -242,14 +281,17 @@ void FP_CACHE::Save( MODULE* aModule )
             THROW_IO_ERROR( msg );
         }
 #endif
-        m_cache_timestamp += fn.GetModificationTime().GetValue().GetValue();
     }
 
-    m_cache_timestamp += m_lib_path.GetModificationTime().GetValue().GetValue();
+    m_cache_timestamp = GetTimestamp( m_lib_path.GetPath() );
 
-    // If we've saved the full cache, we clear the dirty flag.
+    // If we've saved the full cache, we clear the dirty flag.  Our own changes are not
+    // changes to watch for: they are forgotten by watching again.
     if( !aModule )
+    {
         m_cache_dirty = false;
+        m_watcher.reset( new DIR_WATCHER( m_lib_path.GetPath() ) );
+    }
 }
 
 
@@ -271,7 +313,13 @@ void FP_CACHE::Load()
     }
     else
     {
-        m_cache_timestamp = m_lib_path.GetModificationTime().GetValue().GetValue();
+        // Watch and timestamp before reading, so files changed while being read are seen.
+        // All the files count, even those which fail to parse: fixing one is a change.
+        m_watcher.reset( new DIR_WATCHER( m_lib_path.GetPath() ) );
+        m_has_symlinks = false;
+        m_cache_timestamp = DIR_WATCHER::Timestamp( m_lib_path.GetPath(),
+                                                    wxT( "*." ) + KiCadFootprintFileExtension,
+                                                    &m_has_symlinks );
         m_cache_dirty = false;
     }
 
@@ -301,8 +349,6 @@ void FP_CACHE::Load()
 
                 footprint->SetFPID( LIB_ID( fpName ) );
                 m_modules.insert( fpName, new FP_CACHE_ITEM( footprint, fullPath ) );
-
-                m_cache_timestamp += fullPath.GetModificationTime().GetValue().GetValue();
             }
             catch( const IO_ERROR& ioe )
             {
@@ -359,41 +405,38 @@ bool FP_CACHE::IsModified()
 }
 
 
+long long FP_CACHE::GetTimestamp( const wxString& aLibPath )
+{
+    return DIR_WATCHER::Timestamp( aLibPath, wxT( "*." ) + KiCadFootprintFileExtension );
+}
+
+
 long long FP_CACHE::GetTimestamp()
 {
     // Avoid expensive GetModificationTime checks if we already know we're dirty
     if( m_cache_dirty )
         return wxDateTime::Now().GetValue().GetValue();
 
-    long long files_timestamp = 0;
-
-    if( m_lib_path.DirExists() )
+    // When the library is watched, the files have not changed unless the watcher says so
+    if( isWatched() )
     {
-        files_timestamp = m_lib_path.GetModificationTime().GetValue().GetValue();
+        if( !m_watcher->IsModified() )
+            return m_cache_timestamp;
 
-        for( MODULE_CITER it = m_modules.begin();  it != m_modules.end();  ++it )
-        {
-            wxFileName fn = it->second->GetFileName();
-#ifndef __WINDOWS__
-            // Timestamp the source file, not the symlink
-            if( fn.Exists( wxFILE_EXISTS_SYMLINK ) )
-            {
-                char buffer[ PATH_MAX + 1 ];
-                ssize_t pathLen = readlink( TO_UTF8( fn.GetFullPath() ), buffer, PATH_MAX );
+        m_cache_dirty = true;
+        return wxDateTime::Now().GetValue().GetValue();
+    }
 
-                if( pathLen > 0 )
-                {
-                    buffer[ pathLen ] = '\0';
-                    fn.Assign( fn.GetPath() + wxT( "/" ) + wxString::FromUTF8( buffer ) );
-                    fn.Normalize();
-                }
-            }
-#endif
-            if( fn.FileExists() )
-                files_timestamp += fn.GetModificationTime().GetValue().GetValue();
-        }
+    // Without change notifications, a new, removed or renamed file is seen from the
+    // directory timestamp alone
+    if( m_watcher && m_watcher->IsModified() )
+    {
+        m_cache_dirty = true;
+        return wxDateTime::Now().GetValue().GetValue();
     }
 
+    long long files_timestamp = GetTimestamp( m_lib_path.GetPath() );
+
     // If the new timestamp doesn't match the cache timestamp, then save ourselves the
     // expensive calls next time
     if( m_cache_timestamp != files_timestamp )
@@ -901,7 +944,8 @@ void PCB_IO::format( DRAWSEGMENT* aSegment, int aNestLevel ) const
 
             for( int ii = 0; ii < pointsCount;  ++ii )
             {
-                m_out->Print( 0, " (xy %s)", FMT_IU( outline.CPoint( ii ) ).c_str() );
+                m_out->Append( " " );
+                appendXY( m_out, outline.CPoint( ii ).x, outline.CPoint( ii ).y );
             }
 
             m_out->Print( 0, ")" );
@@ -983,8 +1027,12 @@ void PCB_IO::format( EDGE_MODULE* aModuleDrawing, int aNestLevel ) const
                     m_out->Print( 0, "\n" );
                 }
 
-                m_out->Print( nestLevel, "%s(xy %s)",
-                              nestLevel ? "" : " ", FMT_IU( outline.CPoint( ii ) ).c_str() );
+                if( nestLevel )
+                    m_out->Indent( nestLevel );
+                else
+                    m_out->Append( " " );
+
+                appendXY( m_out, outline.CPoint( ii ).x, outline.CPoint( ii ).y );
             }
 
             m_out->Print( 0, ")" );
@@ -1487,11 +1535,10 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
                 for( unsigned ii = 0; ii < poly.size(); ii++ )
                 {
                     if( newLine == 0 )
-                        m_out->Print( nested_level+1, " (xy %s)",
-                                      FMT_IU( wxPoint( poly[ii].x, poly[ii].y ) ).c_str() );
-                    else
-                        m_out->Print( 0, " (xy %s)",
-                                      FMT_IU( wxPoint( poly[ii].x, poly[ii].y ) ).c_str() );
+                        m_out->Indent( nested_level+1 );
+
+                    m_out->Append( " " );
+                    appendXY( m_out, poly[ii].x, poly[ii].y );
 
                     if( ++newLine > 4 )
                     {
@@ -1654,7 +1701,9 @@ void PCB_IO::format( TRACK* aTrack, int aNestLevel ) const
         m_out->Print( 0, " (layer %s)", m_out->Quotew( aTrack->GetLayerName() ).c_str() );
     }
 
-    m_out->Print( 0, " (net %d)", m_mapping->Translate( aTrack->GetNetCode() ) );
+    m_out->Append( " (net " );
+    m_out->AppendInt( m_mapping->Translate( aTrack->GetNetCode() ) );
+    m_out->Append( ")" );
 
     if( aTrack->GetTimeStamp() != 0 )
         m_out->Print( 0, " (tstamp %lX)", (unsigned long)aTrack->GetTimeStamp() );
@@ -1800,11 +1849,11 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
             }
 
             if( newLine == 0 )
-                m_out->Print( aNestLevel+3, "(xy %s %s)",
-                              FMT_IU( iterator->x ).c_str(), FMT_IU( iterator->y ).c_str() );
+                m_out->Indent( aNestLevel+3 );
             else
-                m_out->Print( 0, " (xy %s %s)",
-                              FMT_IU( iterator->x ).c_str(), FMT_IU( iterator->y ).c_str() );
+                m_out->Append( " " );
+
+            appendXY( m_out, iterator->x, iterator->y );
 
             if( newLine < 4 )
             {
@@ -1855,11 +1904,11 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
             }
 
             if( newLine == 0 )
-                m_out->Print( aNestLevel+3, "(xy %s %s)",
-                              FMT_IU( it->x ).c_str(), FMT_IU( it->y ).c_str() );
+                m_out->Indent( aNestLevel+3 );
             else
-                m_out->Print( 0, " (xy %s %s)",
-                              FMT_IU( it->x ) .c_str(), FMT_IU( it->y ).c_str() );
+                m_out->Append( " " );
+
+            appendXY( m_out, it->x, it->y );
 
             if( newLine < 4 )
             {
@@ -1897,9 +1946,12 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
 
         for( ZONE_SEGMENT_FILL::const_iterator it = segs.begin();  it != segs.end();  ++it )
         {
-            m_out->Print( aNestLevel+2, "(pts (xy %s) (xy %s))\n",
-                          FMT_IU( wxPoint( it->A ) ).c_str(),
-                          FMT_IU( wxPoint( it->B ) ).c_str() );
+            m_out->Indent( aNestLevel+2 );
+            m_out->Append( "(pts " );
+            appendXY( m_out, it->A.x, it->A.y );
+            m_out->Append( " " );
+            appendXY( m_out, it->B.x, it->B.y );
+            m_out->Append( ")\n" );
         }
 
         m_out->Print( aNestLevel+1, ")\n" );
@@ -2201,9 +2253,10 @@ void PCB_IO::FootprintDelete( const wxString& aLibraryPath, const wxString& aFoo
 
 long long PCB_IO::GetLibraryTimestamp( const wxString& aLibraryPath ) const
 {
-    // If we have no cache, return a number which won't match any stored timestamps
+    // If we have no cache, read the timestamps of the library files, so the timestamp can be
+    // compared to the one of a library loaded in a previous session
     if( !m_cache || !m_cache->IsPath( aLibraryPath ) )
-        return wxDateTime::Now().GetValue().GetValue();
+        return FP_CACHE::GetTimestamp( aLibraryPath );
 
     return m_cache->GetTimestamp();
 }
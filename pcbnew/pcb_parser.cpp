@@ -3159,7 +3159,7 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER()
     }
 
     if( !pts.IsEmpty() )
-        zone->SetFilledPolysList( pts );
+        zone->SetFilledPolysList( std::move( pts ) );
 
     // Ensure keepout and non copper zones do not have a net
     // (which have no sense for these zones)
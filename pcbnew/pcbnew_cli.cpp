@@ -0,0 +1,604 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file pcbnew_cli.cpp
+ * runs the pcbnew batch steps (zone fill, DRC, plot, drill files, VRML, IDF and Specctra
+ * exports, ray traced 3D render) on boards, without user interface nor event loop, and
+ * reports the time spent in each step.
+ *
+ * The boards are processed concurrently, one per thread; zones are filled and VRML layers
+ * are tesselated by all the cores as in the editor.  The plot settings saved in each board
+ * are used, and the exit status is not zero if a board cannot be loaded, an output cannot
+ * be written or DRC finds errors.
+ *
+ * usage: pcbnew_cli [--fill] [--drc] [--plot] [--layers F.Cu,B.Cu,...] [--drill] [--vrml]
+ *                   [--idf] [--specctra] [--render] [--output dir] [--jobs count] board...
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/init.h>
+#include <wx/tokenzr.h>
+
+#include <common.h>
+#include <kiway.h>
+#include <pgm_base.h>
+#include <profile.h>
+#include <project.h>
+#include <reporter.h>
+#include <wildcards_and_files_ext.h>
+#include <io_mgr.h>
+#include <class_board.h>
+#include <class_marker_pcb.h>
+#include <drc.h>
+#include <zone_filler.h>
+#include <pcbplot.h>
+#include <plotter.h>
+#include <exporters/export_idf.h>
+#include <exporters/export_vrml.h>
+#include <exporters/gendrill_Excellon_writer.h>
+#include <exporters/gerber_jobfile_writer.h>
+#include <specctra_import_export/specctra.h>
+#include <3d_rendering/3d_render_raytracing/c3d_render_raytracing.h>
+
+
+static struct PGM_PCBNEW_CLI : public PGM_BASE
+{
+    bool OnPgmInit() override { return true; }
+    void OnPgmExit() override {}
+    void MacOpenFile( const wxString& aFileName ) override {}
+} program;
+
+
+struct CLI_OPTIONS
+{
+    bool     m_fill;
+    bool     m_drc;
+    bool     m_plot;
+    bool     m_drill;
+    bool     m_vrml;
+    bool     m_idf;
+    bool     m_specctra;
+    bool     m_render;
+    wxString m_layers;      ///< layers to plot, or empty to use the board plot settings
+    wxString m_outputDir;   ///< output directory, or empty to use the board plot settings
+};
+
+
+/**
+ * Keeps the messages of a board job, indented below the step which reported them.
+ */
+class JOB_REPORTER : public REPORTER
+{
+public:
+    JOB_REPORTER( wxString* aLog ) :
+        m_log( aLog ),
+        m_errors( 0 )
+    {
+    }
+
+    REPORTER& Report( const wxString& aText, SEVERITY aSeverity = RPT_UNDEFINED ) override
+    {
+        if( aSeverity == RPT_ERROR )
+            m_errors++;
+
+        *m_log << wxT( "    " ) << aText << wxT( "\n" );
+        return *this;
+    }
+
+    bool HasMessage() const override { return !m_log->IsEmpty(); }
+
+    int GetErrorCount() const { return m_errors; }
+
+private:
+    wxString* m_log;
+    int       m_errors;
+};
+
+
+/**
+ * The steps run on one board.
+ */
+class BOARD_JOB
+{
+public:
+    BOARD_JOB( const wxString& aFileName, const CLI_OPTIONS& aOptions ) :
+        m_fileName( aFileName ),
+        m_options( aOptions ),
+        m_reporter( &m_log )
+    {
+    }
+
+    /**
+     * Run the steps selected by the options, stopping at the first one which fails.
+     * @return true if all the steps succeeded.
+     */
+    bool Run()
+    {
+        m_log << m_fileName << wxT( "\n" );
+
+        return runStep( "load", &BOARD_JOB::load )
+               && ( !m_options.m_fill || runStep( "fill", &BOARD_JOB::fill ) )
+               && ( !m_options.m_drc || runStep( "drc", &BOARD_JOB::drc ) )
+               && ( !m_options.m_plot || runStep( "plot", &BOARD_JOB::plot ) )
+               && ( !m_options.m_drill || runStep( "drill", &BOARD_JOB::drill ) )
+               && ( !m_options.m_vrml || runStep( "vrml", &BOARD_JOB::vrml ) )
+               && ( !m_options.m_idf || runStep( "idf", &BOARD_JOB::idf ) )
+               && ( !m_options.m_specctra || runStep( "specctra", &BOARD_JOB::specctra ) )
+               && ( !m_options.m_render || runStep( "render", &BOARD_JOB::render ) );
+    }
+
+    const wxString& GetLog() const { return m_log; }
+
+private:
+    bool runStep( const char* aName, bool (BOARD_JOB::*aStep)() )
+    {
+        wxString     messages;
+        PROF_COUNTER timer( aName );
+        int          errors = m_reporter.GetErrorCount();
+
+        // The step messages are reported after its time
+        std::swap( messages, m_log );
+        bool ok = ( this->*aStep )() && m_reporter.GetErrorCount() == errors;
+        timer.Stop();
+        std::swap( messages, m_log );
+
+        m_log << wxString::Format( wxT( "  %-8s %10.1f ms%s\n" ), aName, timer.msecs(),
+                                   ok ? wxT( "" ) : wxT( "  FAILED" ) );
+        m_log << messages;
+
+        return ok;
+    }
+
+    bool load()
+    {
+        IO_MGR::PCB_FILE_T format = m_fileName.EndsWith( wxT( ".brd" ) ) ? IO_MGR::LEGACY
+                                                                         : IO_MGR::KICAD_SEXP;
+
+        try
+        {
+            m_board.reset( IO_MGR::Load( format, m_fileName ) );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            m_reporter.Report( ioe.What(), REPORTER::RPT_ERROR );
+            return false;
+        }
+
+        if( !m_board )
+            return false;
+
+        m_board->BuildConnectivity();
+
+        return true;
+    }
+
+    bool fill()
+    {
+        ZONE_FILLER filler( m_board.get() );
+
+        m_reporter.Report( wxString::Format( wxT( "%d zones" ), m_board->GetAreaCount() ) );
+
+        return filler.Fill( m_board->Zones() );
+    }
+
+    bool drc()
+    {
+        DRC drc( m_board.get(), MILLIMETRES );
+
+        drc.SetSettings( true, true, true, true, false, true, wxEmptyString, false );
+        drc.RunTests();
+
+        const DRC_LIST& unconnected = drc.GetUnconnectedItems();
+        int             errors = m_board->GetMARKERCount();
+
+        m_reporter.Report( wxString::Format( wxT( "%d errors, %d unconnected items" ),
+                                             errors, (int) unconnected.size() ) );
+
+        wxFileName fn( m_board->GetFileName() );
+
+        if( !outputDir( &fn ) )
+            return false;
+
+        fn.SetName( fn.GetName() + wxT( "-drc" ) );
+        fn.SetExt( wxT( "rpt" ) );
+
+        FILE* fp = wxFopen( fn.GetFullPath(), wxT( "w" ) );
+
+        if( !fp )
+        {
+            m_reporter.Report( wxString::Format( _( "Unable to create report file \"%s\"" ),
+                                                 fn.GetFullPath() ), REPORTER::RPT_ERROR );
+            return false;
+        }
+
+        fprintf( fp, "** Drc report for %s **\n", TO_UTF8( m_board->GetFileName() ) );
+
+        fprintf( fp, "\n** Found %d DRC errors **\n", errors );
+
+        for( int ii = 0; ii < errors; ++ii )
+        {
+            const DRC_ITEM& item = m_board->GetMARKER( ii )->GetReporter();
+            fprintf( fp, "%s", TO_UTF8( item.ShowReport( MILLIMETRES ) ) );
+        }
+
+        fprintf( fp, "\n** Found %d unconnected pads **\n", (int) unconnected.size() );
+
+        for( const DRC_ITEM* item : unconnected )
+            fprintf( fp, "%s", TO_UTF8( item->ShowReport( MILLIMETRES ) ) );
+
+        fprintf( fp, "\n** End of Report **\n" );
+
+        fclose( fp );
+
+        return errors == 0 && unconnected.empty();
+    }
+
+    bool plot()
+    {
+        PCB_PLOT_PARAMS plotOpts = m_board->GetPlotOptions();
+        LSET            layers = plotOpts.GetLayerSelection();
+        wxFileName      outputFn( m_board->GetFileName() );
+
+        if( !outputDir( &outputFn ) )
+            return false;
+
+        if( !m_options.m_layers.IsEmpty() )
+        {
+            layers.reset();
+
+            wxStringTokenizer tokenizer( m_options.m_layers, wxT( "," ) );
+
+            while( tokenizer.HasMoreTokens() )
+            {
+                wxString     name = tokenizer.GetNextToken();
+                PCB_LAYER_ID layer = m_board->GetLayerID( name );
+
+                if( layer < 0 )
+                {
+                    m_reporter.Report( wxString::Format( wxT( "Unknown layer \"%s\"" ), name ),
+                                       REPORTER::RPT_ERROR );
+                    return false;
+                }
+
+                layers.set( layer );
+            }
+        }
+
+        GERBER_JOBFILE_WRITER jobfile_writer( m_board.get(), &m_reporter );
+        wxString              file_ext( GetDefaultPlotExtension( plotOpts.GetFormat() ) );
+
+        for( LSEQ seq = layers.UIOrder(); seq; ++seq )
+        {
+            PCB_LAYER_ID layer = *seq;
+
+            // As in the plot dialog, skip the disabled copper layers
+            if( ( LSET::AllCuMask() & ~m_board->GetEnabledLayers() )[layer] )
+                continue;
+
+            wxFileName fn( m_board->GetFileName() );
+
+            if( plotOpts.GetFormat() == PLOT_FORMAT_GERBER
+                && plotOpts.GetUseGerberProtelExtensions() )
+                file_ext = GetGerberProtelExtension( layer );
+
+            BuildPlotFileName( &fn, outputFn.GetPath(), m_board->GetLayerName( layer ),
+                               file_ext );
+            jobfile_writer.AddGbrFile( layer, fn.GetFullName() );
+
+            PLOTTER* plotter = StartPlotBoard( m_board.get(), &plotOpts, layer,
+                                               fn.GetFullPath(), wxEmptyString );
+
+            if( !plotter )
+            {
+                m_reporter.Report( wxString::Format( _( "Unable to create file \"%s\"." ),
+                                                     fn.GetFullPath() ), REPORTER::RPT_ERROR );
+                return false;
+            }
+
+            PlotOneBoardLayer( m_board.get(), plotter, layer, plotOpts );
+            plotter->EndPlot();
+            delete plotter;
+
+            m_reporter.Report( fn.GetFullName(), REPORTER::RPT_ACTION );
+        }
+
+        if( plotOpts.GetFormat() == PLOT_FORMAT_GERBER && plotOpts.GetCreateGerberJobFile() )
+        {
+            wxFileName fn( m_board->GetFileName() );
+
+            BuildPlotFileName( &fn, outputFn.GetPath(), "job", GerberJobFileExtension );
+            jobfile_writer.CreateJobFile( fn.GetFullPath() );
+        }
+
+        return true;
+    }
+
+    bool drill()
+    {
+        wxFileName fn( m_board->GetFileName() );
+
+        if( !outputDir( &fn ) )
+            return false;
+
+        EXCELLON_WRITER writer( m_board.get() );
+
+        writer.SetFormat( true );
+        writer.SetOptions( false, false, wxPoint( 0, 0 ), false );
+        writer.CreateDrillandMapFilesSet( fn.GetPath(), true, false, &m_reporter );
+
+        return true;
+    }
+
+    bool vrml()
+    {
+        wxFileName fn( m_board->GetFileName() );
+
+        if( !outputDir( &fn ) )
+            return false;
+
+        fn.SetExt( VrmlFileExtension );
+
+        PROJECT project;
+
+        openProject( &project );
+
+        // As in the export dialog, in mm, with the models copied to a sub directory and
+        // inlined in the board file
+        wxFileName modelPath = fn;
+        wxString   error;
+
+        modelPath.AppendDir( wxT( "shapes3D" ) );
+
+        if( !ExportBoardToVRML( m_board.get(), project.Get3DCacheManager(), fn.GetFullPath(),
+                                1.0, true, true, false, modelPath.GetPath(), 0.0, 0.0,
+                                &error ) )
+        {
+            m_reporter.Report( error, REPORTER::RPT_ERROR );
+            return false;
+        }
+
+        m_reporter.Report( fn.GetFullName(), REPORTER::RPT_ACTION );
+
+        return true;
+    }
+
+    bool idf()
+    {
+        wxFileName fn( m_board->GetFileName() );
+
+        if( !outputDir( &fn ) )
+            return false;
+
+        fn.SetExt( wxT( "emn" ) );
+
+        PROJECT  project;
+        wxString error;
+
+        openProject( &project );
+
+        // In mm, with the page origin as reference point
+        if( !ExportBoardToIDF3( m_board.get(), project.Get3DCacheManager(), fn.GetFullPath(),
+                                false, 0.0, 0.0, &error ) )
+        {
+            m_reporter.Report( error, REPORTER::RPT_ERROR );
+            return false;
+        }
+
+        m_reporter.Report( fn.GetFullName(), REPORTER::RPT_ACTION );
+
+        return true;
+    }
+
+    bool specctra()
+    {
+        wxFileName fn( m_board->GetFileName() );
+        wxString   error;
+
+        if( !outputDir( &fn ) )
+            return false;
+
+        fn.SetExt( SpecctraDsnFileExtension );
+
+        if( !ExportBoardToSpecctraFile( m_board.get(), fn.GetFullPath(), &error ) )
+        {
+            m_reporter.Report( error, REPORTER::RPT_ERROR );
+            return false;
+        }
+
+        m_reporter.Report( fn.GetFullName(), REPORTER::RPT_ACTION );
+
+        return true;
+    }
+
+    bool render()
+    {
+        wxFileName fn( m_board->GetFileName() );
+
+        if( !outputDir( &fn ) )
+            return false;
+
+        // RenderBoardToImage() adds the png extension
+        fn.SetName( fn.GetName() + wxT( "-3d" ) );
+        fn.ClearExt();
+
+        PROJECT         project;
+        RT_RENDER_STATS stats;
+
+        openProject( &project );
+
+        // The default view of the 3D viewer, from the top
+        if( !RenderBoardToImage( m_board.get(), project.Get3DCacheManager(), wxSize( 1600, 1200 ),
+                                 SFVEC3F( 0.0f ), 1.0f, fn.GetFullPath(), &stats ) )
+        {
+            m_reporter.Report( wxString::Format( _( "Unable to create file \"%s.png\"." ),
+                                                 fn.GetFullPath() ), REPORTER::RPT_ERROR );
+            return false;
+        }
+
+        m_reporter.Report( wxString::Format( wxT( "scene %.1f ms, BVH %.1f ms, trace %.1f ms, "
+                                                  "post shading %.1f ms" ),
+                                             stats.m_sceneBuildTime / 1000.0,
+                                             stats.m_acceleratorBuildTime / 1000.0,
+                                             stats.m_traceTime / 1000.0,
+                                             stats.m_postShadeTime / 1000.0 ) );
+        m_reporter.Report( fn.GetFullName() + wxT( ".png" ), REPORTER::RPT_ACTION );
+
+        return true;
+    }
+
+    /**
+     * Open the project of the board, whose 3D cache finds the footprint models.
+     */
+    void openProject( PROJECT* aProject )
+    {
+        wxFileName projectFn( m_board->GetFileName() );
+
+        projectFn.SetExt( ProjectFileExtension );
+        aProject->SetProjectFullName( projectFn.GetFullPath() );
+    }
+
+    /**
+     * Set the path of aFileName to the output directory, creating it if needed.
+     */
+    bool outputDir( wxFileName* aFileName )
+    {
+        wxString   dirName = m_options.m_outputDir.IsEmpty()
+                                    ? m_board->GetPlotOptions().GetOutputDirectory()
+                                    : m_options.m_outputDir;
+        wxFileName dir = wxFileName::DirName( dirName );
+
+        if( !EnsureFileDirectoryExists( &dir, m_board->GetFileName(), &m_reporter ) )
+            return false;
+
+        aFileName->SetPath( dir.GetPath() );
+        return true;
+    }
+
+    wxString                m_fileName;
+    const CLI_OPTIONS&      m_options;
+    std::unique_ptr<BOARD>  m_board;
+    wxString                m_log;
+    JOB_REPORTER            m_reporter;
+};
+
+
+int main( int argc, char* argv[] )
+{
+    wxInitializer initializer( argc, argv );
+    int           kifaceVersion;
+
+    if( !initializer.IsOk() )
+        return 2;
+
+    static const wxCmdLineEntryDesc desc[] =
+    {
+        { wxCMD_LINE_SWITCH, NULL, "fill", "refill the zones" },
+        { wxCMD_LINE_SWITCH, NULL, "drc", "run the design rules check and write its report" },
+        { wxCMD_LINE_SWITCH, NULL, "plot", "plot the layers selected in the board plot settings" },
+        { wxCMD_LINE_OPTION, NULL, "layers", "comma separated names of the layers to plot" },
+        { wxCMD_LINE_SWITCH, NULL, "drill", "write the Excellon drill files" },
+        { wxCMD_LINE_SWITCH, NULL, "vrml", "export the board and its footprint models to VRML" },
+        { wxCMD_LINE_SWITCH, NULL, "idf", "export the board and its footprint outlines to IDFv3" },
+        { wxCMD_LINE_SWITCH, NULL, "specctra", "export the board to a Specctra DSN file" },
+        { wxCMD_LINE_SWITCH, NULL, "render", "ray trace a 1600x1200 top view of the board to PNG" },
+        { wxCMD_LINE_OPTION, NULL, "output", "output directory, relative to the board" },
+        { wxCMD_LINE_OPTION, NULL, "jobs", "count of boards processed concurrently",
+          wxCMD_LINE_VAL_NUMBER },
+        { wxCMD_LINE_PARAM, NULL, NULL, "board", wxCMD_LINE_VAL_STRING,
+          wxCMD_LINE_PARAM_MULTIPLE },
+        { wxCMD_LINE_NONE }
+    };
+
+    wxCmdLineParser parser( desc, argc, argv );
+
+    if( parser.Parse() != 0 )
+        return 2;
+
+    CLI_OPTIONS options;
+    long        jobs = std::max( (int) std::thread::hardware_concurrency(), 1 );
+
+    bool hasLayers = parser.Found( "layers", &options.m_layers );
+
+    options.m_fill = parser.Found( "fill" );
+    options.m_drc = parser.Found( "drc" );
+    options.m_plot = parser.Found( "plot" ) || hasLayers;
+    options.m_drill = parser.Found( "drill" );
+    options.m_vrml = parser.Found( "vrml" );
+    options.m_idf = parser.Found( "idf" );
+    options.m_specctra = parser.Found( "specctra" );
+    options.m_render = parser.Found( "render" );
+    parser.Found( "output", &options.m_outputDir );
+    parser.Found( "jobs", &jobs );
+
+    // The pcbnew kiface needs the program for its settings
+    KIFACE_GETTER( &kifaceVersion, KIFACE_VERSION, &program );
+
+    // Files are written with the C locale: keep it for the whole run instead of switching
+    // it in each writer, possibly from several threads
+    LOCALE_IO toggle;
+
+    size_t                   count = parser.GetParamCount();
+    std::atomic<size_t>      next( 0 );
+    std::atomic<int>         failures( 0 );
+    std::mutex               outputLock;
+    std::vector<std::thread> workers;
+
+    for( long ii = 0; ii < std::max( 1L, std::min( jobs, (long) count ) ); ++ii )
+    {
+        workers.push_back( std::thread( [&]()
+        {
+            size_t i = next.fetch_add( 1 );
+
+            while( i < count )
+            {
+                BOARD_JOB job( parser.GetParam( i ), options );
+
+                if( !job.Run() )
+                    failures.fetch_add( 1 );
+
+                {
+                    std::lock_guard<std::mutex> lock( outputLock );
+                    fputs( TO_UTF8( job.GetLog() ), stdout );
+                    fflush( stdout );
+                }
+
+                i = next.fetch_add( 1 );
+            }
+        } ) );
+    }
+
+    for( size_t ii = 0; ii < workers.size(); ++ii )
+        workers[ ii ].join();
+
+    return failures.load() ? 1 : 0;
+}
@@ -845,7 +845,7 @@ bool PNS_KICAD_IFACE::syncZone( PNS::NODE* aWorld, ZONE_CONTAINER* aZone )
 
 bool PNS_KICAD_IFACE::syncGraphicalItem( PNS::NODE* aWorld, DRAWSEGMENT* aItem )
 {
-    std::vector<SHAPE_SEGMENT*> segs;
+    std::vector<SHAPE*> shapes;
 
     if( aItem->GetLayer() != Edge_Cuts )
         return false;
@@ -853,15 +853,21 @@ bool PNS_KICAD_IFACE::syncGraphicalItem( PNS::NODE* aWorld, DRAWSEGMENT* aItem )
     switch( aItem->GetShape() )
     {
         case S_ARC:
+        case S_CIRCLE:
         {
-            SHAPE_ARC arc( aItem->GetCenter(), aItem->GetArcStart(), (double) aItem->GetAngle() / 10.0 );
-
-            auto l = arc.ConvertToPolyline();
-
-            for( int i = 0; i < l.SegmentCount(); i++ )
+            // The arcs are kept exact rather than approximated by segments.  A hull follows
+            // half a circle at most, so longer arcs and circles are split.
+            bool     isCircle = aItem->GetShape() == S_CIRCLE;
+            VECTOR2I center( aItem->GetCenter() );
+            VECTOR2I start( isCircle ? aItem->GetEnd() : aItem->GetArcStart() );
+            double   angle = isCircle ? 360.0 : (double) aItem->GetAngle() / 10.0;
+            int      count = std::max( 1, (int) std::ceil( std::abs( angle ) / 180.0 ) );
+
+            for( int i = 0; i < count; i++ )
             {
-                SHAPE_SEGMENT *seg = new SHAPE_SEGMENT( l.CSegment(i), aItem->GetWidth() );
-                segs.push_back( seg );
+                SHAPE_ARC* arc = new SHAPE_ARC( center, start, angle / count, aItem->GetWidth() );
+                shapes.push_back( arc );
+                start = arc->GetP1();
             }
 
             break;
@@ -870,23 +876,7 @@ bool PNS_KICAD_IFACE::syncGraphicalItem( PNS::NODE* aWorld, DRAWSEGMENT* aItem )
         case S_SEGMENT:
         {
             SHAPE_SEGMENT *seg = new SHAPE_SEGMENT( aItem->GetStart(), aItem->GetEnd(), aItem->GetWidth() );
-            segs.push_back( seg );
-
-            break;
-        }
-
-        case S_CIRCLE:
-        {
-            // SHAPE_CIRCLE has no ConvertToPolyline() method, so use a 360.0 SHAPE_ARC
-            SHAPE_ARC circle( aItem->GetCenter(), aItem->GetEnd(), 360.0 );
-
-            auto l = circle.ConvertToPolyline();
-
-            for( int i = 0; i < l.SegmentCount(); i++ )
-            {
-                SHAPE_SEGMENT *seg = new SHAPE_SEGMENT( l.CSegment(i), aItem->GetWidth() );
-                segs.push_back( seg );
-            }
+            shapes.push_back( seg );
 
             break;
         }
@@ -901,7 +891,7 @@ bool PNS_KICAD_IFACE::syncGraphicalItem( PNS::NODE* aWorld, DRAWSEGMENT* aItem )
                     wxPoint end_pt = aItem->GetBezierPoints()[jj];
                     SHAPE_SEGMENT *seg = new SHAPE_SEGMENT(
                         VECTOR2I( start_pt ), VECTOR2I( end_pt ), aItem->GetWidth() );
-                    segs.push_back( seg );
+                    shapes.push_back( seg );
                     start_pt = end_pt;
                 }
             }
@@ -911,14 +901,14 @@ bool PNS_KICAD_IFACE::syncGraphicalItem( PNS::NODE* aWorld, DRAWSEGMENT* aItem )
             break;
     }
 
-    for( auto seg : segs )
+    for( auto shape : shapes )
     {
         std::unique_ptr< PNS::SOLID > solid( new PNS::SOLID );
 
         solid->SetLayers( LAYER_RANGE( F_Cu, B_Cu ) );
         solid->SetNet( -1 );
         solid->SetParent( nullptr );
-        solid->SetShape( seg );
+        solid->SetShape( shape );
         solid->SetRoutable( false );
 
         aWorld->Add( std::move( solid ) );
@@ -22,6 +22,7 @@
 #include <math/vector2d.h>
 
 #include <geometry/shape.h>
+#include <geometry/shape_arc.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_rect.h>
 #include <geometry/shape_circle.h>
@@ -65,6 +66,12 @@ const SHAPE_LINE_CHAIN SOLID::Hull( int aClearance, int aWalkaroundThickness ) c
         return ConvexHull( *convex, cl );
     }
 
+    case SH_ARC:
+    {
+        SHAPE_ARC* arc = static_cast<SHAPE_ARC*>( m_shape );
+        return ArcHull( *arc, aClearance, aWalkaroundThickness );
+    }
+
     default:
         break;
     }
@@ -25,6 +25,8 @@
 #include "pns_router.h"
 
 #include <geometry/shape_segment.h>
+#include <geometry/geometry_utils.h>
+#include <convert_to_biu.h>
 
 #include <cmath>
 
@@ -86,6 +88,85 @@ const SHAPE_LINE_CHAIN SegmentHull ( const SHAPE_SEGMENT& aSeg, int aClearance,
 }
 
 
+const SHAPE_LINE_CHAIN ArcHull( const SHAPE_ARC& aArc, int aClearance,
+                                int aWalkaroundThickness )
+{
+    int    d = aArc.GetWidth() / 2 + aClearance + aWalkaroundThickness / 2 + HULL_MARGIN;
+    int    r = aArc.GetRadius();
+    double angle = aArc.GetCentralAngle();
+
+    if( std::abs( angle ) > 180.0 || r <= d )
+    {
+        int   cl = aClearance + ( aWalkaroundThickness + 1 ) / 2;
+        BOX2I box = aArc.BBox();
+
+        return OctagonalHull( box.GetPosition(), box.GetSize(), cl + 1, 0.2 * cl );
+    }
+
+    // The outer side is made of tangents to the circle, so it does not cut into the
+    // clearance, and the inner side of chords.  Half steps of 22.5 degrees at most keep
+    // the tangents close to the circle.
+    int    n = std::max( GetArcToSegmentCount( r + d, ARC_HIGH_DEF, angle ),
+                         (int) std::ceil( std::abs( angle ) / 45.0 ) );
+    double step = angle / n * M_PI / 180.0;
+    double start = aArc.GetStartAngle() * M_PI / 180.0;
+    double outer = ( r + d ) / cos( step / 2.0 );
+    double inner = r - d;
+    double x = 2.0 / ( 1.0 + M_SQRT2 ) * d;
+    double dir = angle < 0.0 ? -1.0 : 1.0;
+
+    const VECTOR2D c( aArc.GetCenter() );
+    const VECTOR2D p0( aArc.GetP0() );
+    const VECTOR2D p1( aArc.GetP1() );
+    const VECTOR2D u0 = ( p0 - c ) * ( 1.0 / ( p0 - c ).EuclideanNorm() );
+    const VECTOR2D u1 = ( p1 - c ) * ( 1.0 / ( p1 - c ).EuclideanNorm() );
+    const VECTOR2D t0 = u0.Perpendicular() * -dir;     // away from the arc at its start
+    const VECTOR2D t1 = u1.Perpendicular() * dir;      // away from the arc at its end
+
+    SHAPE_LINE_CHAIN s;
+
+    auto append = [&]( const VECTOR2D& aP )
+    {
+        s.Append( KiROUND( aP.x ), KiROUND( aP.y ) );
+    };
+
+    s.SetClosed( true );
+
+    append( p0 + u0 * d );
+
+    for( int i = 1; i <= n; i++ )
+    {
+        double a = start + step * ( i - 0.5 );
+        append( c + VECTOR2D( cos( a ), sin( a ) ) * outer );
+    }
+
+    append( p1 + u1 * d );
+    append( p1 + u1 * d + t1 * ( x / 2 ) );
+    append( p1 + t1 * d + u1 * ( x / 2 ) );
+    append( p1 + t1 * d - u1 * ( x / 2 ) );
+    append( p1 - u1 * d + t1 * ( x / 2 ) );
+    append( p1 - u1 * d );
+
+    for( int i = n - 1; i > 0; i-- )
+    {
+        double a = start + step * i;
+        append( c + VECTOR2D( cos( a ), sin( a ) ) * inner );
+    }
+
+    append( p0 - u0 * d );
+    append( p0 - u0 * d + t0 * ( x / 2 ) );
+    append( p0 + t0 * d - u0 * ( x / 2 ) );
+    append( p0 + t0 * d + u0 * ( x / 2 ) );
+    append( p0 + u0 * d + t0 * ( x / 2 ) );
+
+    // make sure the hull outline is always clockwise
+    if( s.CSegment( 0 ).Side( aArc.GetP0() ) < 0 )
+        return s.Reverse();
+    else
+        return s;
+}
+
+
 static void MoveDiagonal( SEG& aDiagonal, const SHAPE_LINE_CHAIN& aVertices, int aClearance )
 {
     int dist;
@@ -24,6 +24,7 @@
 
 #include <math/vector2d.h>
 #include <math/box2.h>
+#include <geometry/shape_arc.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_segment.h>
 #include <geometry/shape_rect.h>
@@ -44,6 +45,20 @@ const SHAPE_LINE_CHAIN OctagonalHull( const VECTOR2I& aP0, const VECTOR2I& aSize
 const SHAPE_LINE_CHAIN SegmentHull( const SHAPE_SEGMENT& aSeg, int aClearance,
                                     int aWalkaroundThickness );
 
+/**
+ * Function ArcHull()
+ *
+ * Creates a hull following both sides of an arc, with octagonal ends.  Arcs longer than
+ * a half circle, or too small for the hull to have an inner side, get an octagonal hull
+ * around their bounding box instead.
+ * @param aArc The arc, with its width.
+ * @param aClearance The minimum distance between arc and hull.
+ * @param aWalkaroundThickness The width of the line walking around the arc.
+ * @return A closed line chain describing the hull.
+ */
+const SHAPE_LINE_CHAIN ArcHull( const SHAPE_ARC& aArc, int aClearance,
+                                int aWalkaroundThickness );
+
 /**
  * Function ConvexHull()
  *
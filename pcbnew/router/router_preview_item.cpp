@@ -24,6 +24,7 @@
 #include <view/view.h>
 
 #include <geometry/shape_rect.h>
+#include <geometry/shape_arc.h>
 #include "class_track.h"
 #include <pcb_painter.h>
 
@@ -286,9 +287,31 @@ void ROUTER_PREVIEW_ITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
         break;
     }
 
+    case SH_ARC:
+    {
+        const SHAPE_ARC* arc = (const SHAPE_ARC*) m_shape;
+        double startAngle = arc->GetStartAngle() * M_PI / 180.0;
+        double endAngle = startAngle + arc->GetCentralAngle() * M_PI / 180.0;
+
+        if( endAngle < startAngle )
+            std::swap( startAngle, endAngle );
+
+        if( m_clearance > 0 )
+        {
+            gal->DrawArcSegment( arc->GetCenter(), arc->GetRadius(), startAngle, endAngle,
+                                 arc->GetWidth() + 2 * m_clearance );
+        }
+
+        gal->SetLayerDepth( m_depth );
+        gal->SetStrokeColor( m_color );
+        gal->SetFillColor( m_color );
+        gal->DrawArcSegment( arc->GetCenter(), arc->GetRadius(), startAngle, endAngle,
+                             arc->GetWidth() );
+        break;
+    }
+
     case SH_POLY_SET:
     case SH_COMPOUND:
-    case SH_ARC:
         break;          // Not yet in use
         }
     }
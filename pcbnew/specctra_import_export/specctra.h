@@ -3980,6 +3980,21 @@ public:
 
 }           // namespace DSN
 
+
+/**
+ * Function ExportBoardToSpecctraFile
+ * exports a board to a specctra dsn file.  This is the work done by
+ * PCB_EDIT_FRAME::ExportSpecctraFile(); it needs no frame and reports errors to the caller.
+ * The footprints on the back side are flipped during the export, then flipped back.
+ *
+ * @param aBoard = the board to export
+ * @param aFullFilename = the full filename of the dsn file
+ * @param aErrorMsg = if not NULL, receives the reason of a failure
+ * @return true if Ok.
+ */
+bool ExportBoardToSpecctraFile( BOARD* aBoard, const wxString& aFullFilename,
+                                wxString* aErrorMsg = NULL );
+
 #endif      // SPECCTRA_H_
 
 //EOF
@@ -108,14 +108,11 @@ void PCB_EDIT_FRAME::ExportToSpecctra( wxCommandEvent& event )
 }
 
 
-bool PCB_EDIT_FRAME::ExportSpecctraFile( const wxString& aFullFilename )
+bool ExportBoardToSpecctraFile( BOARD* aBoard, const wxString& aFullFilename,
+                                wxString* aErrorMsg )
 {
     SPECCTRA_DB     db;
     bool            ok = true;
-    wxString        errorText;
-
-    BASE_SCREEN*    screen = GetScreen();
-    bool            wasModified = screen->IsModify();
 
     db.SetPCB( SPECCTRA_DB::MakePCB() );
 
@@ -124,12 +121,12 @@ bool PCB_EDIT_FRAME::ExportSpecctraFile( const wxString& aFullFilename )
     // DSN Images (=KiCad MODULES and pads) must be presented from the
     // top view.  So we temporarily flip any modules which are on the back
     // side of the board to the front, and record this in the MODULE's flag field.
-    db.FlipMODULEs( GetBoard() );
+    db.FlipMODULEs( aBoard );
 
     try
     {
-        GetBoard()->SynchronizeNetsAndNetClasses();
-        db.FromBOARD( GetBoard() );
+        aBoard->SynchronizeNetsAndNetClasses();
+        db.FromBOARD( aBoard );
         db.ExportPCB(  aFullFilename, true );
 
         // if an exception is thrown by FromBOARD or ExportPCB(), then
@@ -140,11 +137,23 @@ bool PCB_EDIT_FRAME::ExportSpecctraFile( const wxString& aFullFilename )
         ok = false;
 
         // copy the error string to safe place, ioe is in this scope only.
-        errorText = ioe.What();
+        if( aErrorMsg )
+            *aErrorMsg = ioe.What();
     }
 
     // done assuredly, even if an exception was thrown and caught.
-    db.RevertMODULEs( GetBoard() );
+    db.RevertMODULEs( aBoard );
+
+    return ok;
+}
+
+
+bool PCB_EDIT_FRAME::ExportSpecctraFile( const wxString& aFullFilename )
+{
+    wxString        errorText;
+    BASE_SCREEN*    screen = GetScreen();
+    bool            wasModified = screen->IsModify();
+    bool            ok = ExportBoardToSpecctraFile( GetBoard(), aFullFilename, &errorText );
 
     // The two calls below to MODULE::Flip(), both set the
     // modified flag, yet their actions cancel each other out, so it should
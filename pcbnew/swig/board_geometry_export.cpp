@@ -0,0 +1,176 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file  board_geometry_export.cpp
+ */
+
+#include <board_geometry_export.h>
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <class_zone.h>
+
+
+/**
+ * Create a bytearray of aCount uninitialized records, to be filled through aRecords:
+ * the geometry is copied only once, directly into the Python object.
+ */
+template <typename RECORD>
+static PyObject* newRecordArray( size_t aCount, RECORD** aRecords )
+{
+    PyObject* array = PyByteArray_FromStringAndSize( NULL, aCount * sizeof( RECORD ) );
+
+    if( array )
+        *aRecords = reinterpret_cast<RECORD*>( PyByteArray_AS_STRING( array ) );
+
+    return array;
+}
+
+
+PyObject* ExportTrackGeometry( BOARD* aBoard )
+{
+    TRACK_RECORD* record = NULL;
+    PyObject*     array = newRecordArray( aBoard->m_Track.GetCount(), &record );
+
+    if( !array )
+        return NULL;
+
+    for( TRACK* track = aBoard->m_Track; track; track = track->Next() )
+    {
+        PCB_LAYER_ID layer = track->GetLayer();
+        PCB_LAYER_ID endLayer = layer;
+
+        if( track->Type() == PCB_VIA_T )
+            static_cast<VIA*>( track )->LayerPair( &layer, &endLayer );
+
+        record->m_StartX   = track->GetStart().x;
+        record->m_StartY   = track->GetStart().y;
+        record->m_EndX     = track->GetEnd().x;
+        record->m_EndY     = track->GetEnd().y;
+        record->m_Width    = track->GetWidth();
+        record->m_Layer    = layer;
+        record->m_EndLayer = endLayer;
+        record->m_NetCode  = track->GetNetCode();
+        record->m_Type     = track->Type();
+        ++record;
+    }
+
+    return array;
+}
+
+
+PyObject* ExportPadGeometry( BOARD* aBoard )
+{
+    size_t count = 0;
+
+    for( MODULE* module = aBoard->m_Modules; module; module = module->Next() )
+        count += module->PadsList().GetCount();
+
+    PAD_RECORD* record = NULL;
+    PyObject*   array = newRecordArray( count, &record );
+
+    if( !array )
+        return NULL;
+
+    int moduleIndex = 0;
+
+    for( MODULE* module = aBoard->m_Modules; module; module = module->Next(), ++moduleIndex )
+    {
+        for( D_PAD* pad = module->PadsList(); pad; pad = pad->Next() )
+        {
+            record->m_PosX        = pad->GetPosition().x;
+            record->m_PosY        = pad->GetPosition().y;
+            record->m_SizeX       = pad->GetSize().x;
+            record->m_SizeY       = pad->GetSize().y;
+            record->m_Orientation = KiROUND( pad->GetOrientation() );
+            record->m_Shape       = pad->GetShape();
+            record->m_Attribute   = pad->GetAttribute();
+            record->m_DrillX      = pad->GetDrillSize().x;
+            record->m_DrillY      = pad->GetDrillSize().y;
+            record->m_NetCode     = pad->GetNetCode();
+            record->m_Module      = moduleIndex;
+            ++record;
+        }
+    }
+
+    return array;
+}
+
+
+PyObject* ExportZoneGeometry( BOARD* aBoard, bool aFilled )
+{
+    auto polySet = [&]( int aZone ) -> const SHAPE_POLY_SET&
+    {
+        const ZONE_CONTAINER* zone = aBoard->GetArea( aZone );
+
+        return aFilled ? zone->GetFilledPolysList() : *zone->Outline();
+    };
+
+    size_t count = 0;
+
+    for( int ii = 0; ii < aBoard->GetAreaCount(); ii++ )
+    {
+        const SHAPE_POLY_SET& polys = polySet( ii );
+
+        for( int jj = 0; jj < polys.OutlineCount(); jj++ )
+        {
+            for( const SHAPE_LINE_CHAIN& contour : polys.CPolygon( jj ) )
+                count += contour.PointCount();
+        }
+    }
+
+    ZONE_VERTEX_RECORD* record = NULL;
+    PyObject*           array = newRecordArray( count, &record );
+
+    if( !array )
+        return NULL;
+
+    for( int ii = 0; ii < aBoard->GetAreaCount(); ii++ )
+    {
+        const SHAPE_POLY_SET& polys = polySet( ii );
+
+        for( int jj = 0; jj < polys.OutlineCount(); jj++ )
+        {
+            const SHAPE_POLY_SET::POLYGON& polygon = polys.CPolygon( jj );
+
+            for( size_t kk = 0; kk < polygon.size(); kk++ )
+            {
+                for( int ll = 0; ll < polygon[kk].PointCount(); ll++ )
+                {
+                    const VECTOR2I& point = polygon[kk].CPoint( ll );
+
+                    record->m_Zone    = ii;
+                    record->m_Polygon = jj;
+                    record->m_Contour = kk;
+                    record->m_X       = point.x;
+                    record->m_Y       = point.y;
+                    ++record;
+                }
+            }
+        }
+    }
+
+    return array;
+}
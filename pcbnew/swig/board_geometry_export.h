@@ -0,0 +1,109 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file  board_geometry_export.h
+ * @brief Bulk export of the board geometry to Python buffers.
+ *
+ * Reading the geometry of a board item by item from Python costs a SWIG call per item
+ * and per coordinate.  These functions copy the geometry of all the tracks, pads or zones
+ * of a board at once into a Python bytearray of fixed size records, which can be read
+ * without any wrapper object through the buffer protocol, e.g. with numpy.frombuffer()
+ * or the struct module.
+ *
+ * All the record fields are native 32 bit integers, with no padding.  The field names
+ * and the struct format of the records are defined on the Python side, and must be kept
+ * in sync with the records below (see board_geometry_export.i).
+ */
+
+#ifndef BOARD_GEOMETRY_EXPORT_H
+#define BOARD_GEOMETRY_EXPORT_H
+
+#include <Python.h>
+#include <cstdint>
+
+class BOARD;
+
+#ifndef SWIG
+
+/// A track segment or a via
+struct TRACK_RECORD
+{
+    int32_t m_StartX;
+    int32_t m_StartY;
+    int32_t m_EndX;
+    int32_t m_EndY;
+    int32_t m_Width;
+    int32_t m_Layer;
+    int32_t m_EndLayer;     ///< same as m_Layer for segments, bottom layer for vias
+    int32_t m_NetCode;
+    int32_t m_Type;         ///< PCB_TRACE_T or PCB_VIA_T
+};
+
+
+/// A pad, in board coordinates
+struct PAD_RECORD
+{
+    int32_t m_PosX;
+    int32_t m_PosY;
+    int32_t m_SizeX;
+    int32_t m_SizeY;
+    int32_t m_Orientation;  ///< in 0.1 degrees
+    int32_t m_Shape;        ///< PAD_SHAPE_T
+    int32_t m_Attribute;    ///< PAD_ATTR_T
+    int32_t m_DrillX;
+    int32_t m_DrillY;
+    int32_t m_NetCode;
+    int32_t m_Module;       ///< index of the footprint in the board footprint list
+};
+
+
+/// A vertex of a zone polygon
+struct ZONE_VERTEX_RECORD
+{
+    int32_t m_Zone;         ///< index of the zone in the board zone list
+    int32_t m_Polygon;      ///< index of the polygon in the zone
+    int32_t m_Contour;      ///< 0 for the outline of the polygon, 1 + hole index for holes
+    int32_t m_X;
+    int32_t m_Y;
+};
+
+#endif
+
+/**
+ * @return a bytearray of TRACK_RECORDs, for all the track segments and vias of aBoard.
+ */
+PyObject* ExportTrackGeometry( BOARD* aBoard );
+
+/**
+ * @return a bytearray of PAD_RECORDs, for all the pads of aBoard.
+ */
+PyObject* ExportPadGeometry( BOARD* aBoard );
+
+/**
+ * @return a bytearray of ZONE_VERTEX_RECORDs, for all the zones of aBoard.
+ * @param aFilled selects the filled areas of the zones rather than their outlines.
+ */
+PyObject* ExportZoneGeometry( BOARD* aBoard, bool aFilled = false );
+
+#endif      // BOARD_GEOMETRY_EXPORT_H
@@ -0,0 +1,71 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file board_geometry_export.i
+ * @brief bulk export of the board geometry to Python buffers
+ */
+
+%include board_geometry_export.h
+%{
+#include <board_geometry_export.h>
+%}
+
+// The fields of the records filled by the functions above, in the order of the C++
+// structs.  Each field is a native 32 bit integer.
+%pythoncode
+%{
+    TRACK_RECORD_FIELDS = ( 'start_x', 'start_y', 'end_x', 'end_y', 'width',
+                            'layer', 'end_layer', 'net', 'type' )
+
+    PAD_RECORD_FIELDS = ( 'pos_x', 'pos_y', 'size_x', 'size_y', 'orientation',
+                          'shape', 'attribute', 'drill_x', 'drill_y', 'net', 'module' )
+
+    ZONE_VERTEX_RECORD_FIELDS = ( 'zone', 'polygon', 'contour', 'x', 'y' )
+
+    def RecordFormat(fields):
+        """
+        Return the struct module format of the records having the given fields,
+        e.g. RecordFormat(TRACK_RECORD_FIELDS)
+        """
+        return '=%di' % len(fields)
+
+    def RecordDtype(fields):
+        """
+        Return the numpy dtype of the records having the given fields, to view the
+        result of an export without copying it:
+            numpy.frombuffer(ExportTrackGeometry(board), RecordDtype(TRACK_RECORD_FIELDS))
+        """
+        import numpy
+        return numpy.dtype([(name, numpy.int32) for name in fields])
+
+    def IterRecords(buffer, fields):
+        """
+        Iterate over the records of an export as tuples, without numpy
+        """
+        import struct
+        record = struct.Struct(RecordFormat(fields))
+
+        for offset in range(0, len(buffer), record.size):
+            yield record.unpack_from(buffer, offset)
+%}
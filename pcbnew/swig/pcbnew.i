@@ -121,6 +121,7 @@ HANDLE_EXCEPTIONS(LoadBoard)
 
 
 %include board.i
+%include board_geometry_export.i
 %include footprint.i
 %include plugins.i
 %include units.i
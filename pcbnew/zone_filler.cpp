@@ -121,7 +121,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
 
     for( ssize_t ii = 0; ii < parallelThreadCount; ++ii )
     {
-        fillWorkers.push_back( std::thread( [ this, toFill ]()
+        fillWorkers.push_back( std::thread( [ this, &toFill ]()
         {
             size_t i = m_next.fetch_add( 1 );
             while( i < toFill.size() )
@@ -130,8 +130,8 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
                 ZONE_CONTAINER* zone = toFill[i].m_zone;
                 fillSingleZone( zone, rawPolys, finalPolys );
 
-                zone->SetRawPolysList( rawPolys );
-                zone->SetFilledPolysList( finalPolys );
+                zone->SetRawPolysList( std::move( rawPolys ) );
+                zone->SetFilledPolysList( std::move( finalPolys ) );
                 zone->SetIsFilled( true );
 
                 if( m_progressReporter )
@@ -169,17 +169,21 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
 
     for( auto& zone : toFill )
     {
-        std::sort( zone.m_islands.begin(), zone.m_islands.end(), std::greater<int>() );
-        SHAPE_POLY_SET poly = zone.m_zone->GetFilledPolysList();
-
-        for( auto idx : zone.m_islands )
+        // Only copy the (shared) fill if there is something to remove from it
+        if( !zone.m_islands.empty() )
         {
-            poly.DeletePolygon( idx );
-        }
+            std::sort( zone.m_islands.begin(), zone.m_islands.end(), std::greater<int>() );
+            SHAPE_POLY_SET poly = zone.m_zone->GetFilledPolysList();
+
+            for( auto idx : zone.m_islands )
+            {
+                poly.DeletePolygon( idx );
+            }
 
-        zone.m_zone->SetFilledPolysList( poly );
+            zone.m_zone->SetFilledPolysList( std::move( poly ) );
+        }
 
-        if( aCheck && zone.m_lastPolys.GetHash() != poly.GetHash() )
+        if( aCheck && zone.m_lastPolys.GetHash() != zone.m_zone->GetFilledPolysList().GetHash() )
             outOfDate = true;
     }
 
@@ -224,7 +228,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
 
     for( ssize_t ii = 0; ii < parallelThreadCount; ++ii )
     {
-        triangulationWorkers.push_back( std::thread( [ this, toFill ]()
+        triangulationWorkers.push_back( std::thread( [ this, &toFill ]()
         {
             size_t i = m_next.fetch_add( 1 );
             while( i < toFill.size() )
@@ -317,6 +321,20 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
 }
 
 
+/**
+ * @return the number of segments per circle to approximate the arcs of the clearance
+ * area of aPad within aErrorMax, at most aMaxSegCount.  The largest arcs are the ends of
+ * round and oval pads, and the rounded corners of pads are smaller.
+ */
+static int padSegmentCount( const D_PAD* aPad, int aClearance, int aErrorMax,
+                            int aMaxSegCount )
+{
+    int radius = std::min( aPad->GetSize().x, aPad->GetSize().y ) / 2 + aClearance;
+
+    return GetCircleToSegmentCount( radius, aErrorMax, aMaxSegCount );
+}
+
+
 void ZONE_FILLER::buildZoneFeatureHoleList( const ZONE_CONTAINER* aZone,
         SHAPE_POLY_SET& aFeatures ) const
 {
@@ -336,6 +354,11 @@ void ZONE_FILLER::buildZoneFeatureHoleList( const ZONE_CONTAINER* aZone,
      */
     correctionFactor = GetCircletoPolyCorrectionFactor( segsPerCircle );
 
+    // The arcs of pads and tracks, the most numerous holes, are approximated within the
+    // max error matching the zone setting: the small ones need fewer than segsPerCircle
+    // segments, and every extra vertex slows down the boolean operations of the fill.
+    int arcErrorMax = segsPerCircle > SEGMENT_COUNT_CROSSOVER ? ARC_HIGH_DEF : ARC_LOW_DEF;
+
     aFeatures.RemoveAllContours();
 
     int outline_half_thickness = aZone->GetMinThickness() / 2;
@@ -442,10 +465,12 @@ void ZONE_FILLER::buildZoneFeatureHoleList( const ZONE_CONTAINER* aZone,
                             aFeatures.Append( outline );
                     }
                     else
-                        pad->TransformShapeWithClearanceToPolygon( aFeatures,
-                                clearance,
-                                segsPerCircle,
-                                correctionFactor );
+                    {
+                        int segs = padSegmentCount( pad, clearance, arcErrorMax, segsPerCircle );
+
+                        pad->TransformShapeWithClearanceToPolygon( aFeatures, clearance, segs,
+                                GetCircletoPolyCorrectionFactor( segs ) );
+                    }
                 }
 
                 continue;
@@ -487,8 +512,12 @@ void ZONE_FILLER::buildZoneFeatureHoleList( const ZONE_CONTAINER* aZone,
                             aFeatures.Append( convex_hull[ii] );
                     }
                     else
-                        pad->TransformShapeWithClearanceToPolygon( aFeatures,
-                                gap, segsPerCircle, correctionFactor );
+                    {
+                        int segs = padSegmentCount( pad, gap, arcErrorMax, segsPerCircle );
+
+                        pad->TransformShapeWithClearanceToPolygon( aFeatures, gap, segs,
+                                GetCircletoPolyCorrectionFactor( segs ) );
+                    }
                 }
             }
         }
@@ -511,10 +540,11 @@ void ZONE_FILLER::buildZoneFeatureHoleList( const ZONE_CONTAINER* aZone,
         if( item_boundingbox.Intersects( zone_boundingbox ) )
         {
             int clearance = std::max( zone_clearance, item_clearance );
-            track->TransformShapeWithClearanceToPolygon( aFeatures,
-                    clearance,
-                    segsPerCircle,
-                    correctionFactor );
+            int segs = GetCircleToSegmentCount( track->GetWidth() / 2 + clearance, arcErrorMax,
+                                                segsPerCircle );
+
+            track->TransformShapeWithClearanceToPolygon( aFeatures, clearance, segs,
+                    GetCircletoPolyCorrectionFactor( segs ) );
         }
     }
 
@@ -722,7 +752,9 @@ void ZONE_FILLER::computeRawFilledAreas( const ZONE_CONTAINER* aZone,
     if( s_DumpZonesWhenFilling )
         dumper->BeginGroup( "clipper-zone" );
 
-    SHAPE_POLY_SET solidAreas = aSmoothedOutline;
+    // The solid areas go through several boolean operations: keep them in Clipper's
+    // format between the operations
+    SHAPE_POLY_SET::BOOLEAN_PIPELINE solidAreas( aSmoothedOutline );
 
     solidAreas.Inflate( -outline_half_thickness, segsPerCircle );
     solidAreas.Simplify( SHAPE_POLY_SET::PM_FAST );
@@ -730,28 +762,31 @@ void ZONE_FILLER::computeRawFilledAreas( const ZONE_CONTAINER* aZone,
     SHAPE_POLY_SET holes;
 
     if( s_DumpZonesWhenFilling )
-        dumper->Write( &solidAreas, "solid-areas" );
+        dumper->Write( solidAreas.Result(), "solid-areas" );
 
     buildZoneFeatureHoleList( aZone, holes );
 
     if( s_DumpZonesWhenFilling )
         dumper->Write( &holes, "feature-holes" );
 
-    holes.Simplify( SHAPE_POLY_SET::PM_FAST );
+    SHAPE_POLY_SET::BOOLEAN_PIPELINE simplifiedHoles( holes );
+
+    simplifiedHoles.Simplify( SHAPE_POLY_SET::PM_FAST );
 
     if( s_DumpZonesWhenFilling )
-        dumper->Write( &holes, "feature-holes-postsimplify" );
+        dumper->Write( simplifiedHoles.Result(), "feature-holes-postsimplify" );
 
     // Generate the filled areas (currently, without thermal shapes, which will
     // be created later).
     // Use SHAPE_POLY_SET::PM_STRICTLY_SIMPLE to generate strictly simple polygons
     // needed by Gerber files and Fracture()
-    solidAreas.BooleanSubtract( holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    solidAreas.BooleanSubtract( simplifiedHoles, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+
+    SHAPE_POLY_SET areas_fractured = solidAreas.Result();
 
     if( s_DumpZonesWhenFilling )
-        dumper->Write( &solidAreas, "solid-areas-minus-holes" );
+        dumper->Write( &areas_fractured, "solid-areas-minus-holes" );
 
-    SHAPE_POLY_SET areas_fractured = solidAreas;
     areas_fractured.Fracture( SHAPE_POLY_SET::PM_FAST );
 
     if( s_DumpZonesWhenFilling )
@@ -783,7 +818,7 @@ void ZONE_FILLER::computeRawFilledAreas( const ZONE_CONTAINER* aZone,
             dumper->Write( &thermalHoles, "thermal-holes" );
 
         // put these areas in m_FilledPolysList
-        SHAPE_POLY_SET th_fractured = solidAreas;
+        SHAPE_POLY_SET th_fractured = solidAreas.Result();
         th_fractured.Fracture( SHAPE_POLY_SET::PM_FAST );
 
         if( s_DumpZonesWhenFilling )
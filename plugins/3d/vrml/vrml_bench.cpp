@@ -0,0 +1,156 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file vrml_bench.cpp
+ * measures the time spent parsing VRML files. The files given on the command
+ * line are parsed; with no arguments a large synthetic IndexedFaceSet is used.
+ *
+ * usage: vrml_bench [file.wrl ...]
+ */
+
+#include <cstdio>
+#include <sstream>
+#include <wx/init.h>
+#include <wx/string.h>
+#include "richio.h"
+#include "profile.h"
+#include "plugins/3dapi/ifsg_api.h"
+#include "wrlproc.h"
+#include "vrml1_base.h"
+#include "vrml2_base.h"
+
+
+SCENEGRAPH* LoadVRML( const wxString& aFileName, bool useInline );
+
+
+// build a VRML2 file with a grid of aSize x aSize points and two triangles per cell
+static std::string makeModel( int aSize )
+{
+    std::ostringstream ostr;
+    ostr.precision( 7 );
+
+    ostr << "#VRML V2.0 utf8\n";
+    ostr << "Shape { geometry IndexedFaceSet {\n";
+    ostr << "coord Coordinate { point [\n";
+
+    for( int j = 0; j < aSize; ++j )
+    {
+        for( int i = 0; i < aSize; ++i )
+            ostr << i * 0.0254 << " " << j * 0.0254 << " " << ( i ^ j ) * 1e-3 << ", ";
+
+        ostr << "\n";
+    }
+
+    ostr << "] }\ncoordIndex [\n";
+
+    for( int j = 0; j < aSize - 1; ++j )
+    {
+        for( int i = 0; i < aSize - 1; ++i )
+        {
+            int n = j * aSize + i;
+            ostr << n << "," << n + 1 << "," << n + aSize << ",-1,";
+            ostr << n + 1 << "," << n + aSize + 1 << "," << n + aSize << ",-1,";
+        }
+
+        ostr << "\n";
+    }
+
+    ostr << "] } }\n";
+
+    return ostr.str();
+}
+
+
+static bool parse( LINE_READER* aReader )
+{
+    WRLPROC proc( aReader );
+    bool ok;
+
+    if( proc.GetVRMLType() == VRML_V1 )
+    {
+        WRL1BASE base;
+        ok = base.Read( proc );
+    }
+    else
+    {
+        WRL2BASE base;
+        ok = base.Read( proc );
+    }
+
+    if( !ok )
+        fprintf( stderr, "%s\n", proc.GetError().c_str() );
+
+    return ok;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    wxInitializer initializer;
+
+    if( argc < 2 )
+    {
+        std::string model = makeModel( 1000 );
+        STRING_LINE_READER reader( model, wxT( "synthetic" ) );
+
+        PROF_COUNTER cnt( "parse synthetic model (1M points)" );
+        bool ok = parse( &reader );
+        cnt.Show();
+
+        return ok ? 0 : 1;
+    }
+
+    for( int i = 1; i < argc; ++i )
+    {
+        wxString fname = wxString::FromUTF8Unchecked( argv[i] );
+
+        try
+        {
+            FILE_LINE_READER reader( fname, 0, 8388608 );
+
+            PROF_COUNTER cnt( std::string( "parse " ) + argv[i] );
+
+            if( !parse( &reader ) )
+                return 1;
+
+            cnt.Show();
+        }
+        catch( const IO_ERROR& e )
+        {
+            fprintf( stderr, "%s\n", (const char*) e.What().ToUTF8() );
+            return 1;
+        }
+
+        PROF_COUNTER cnt( std::string( "load " ) + argv[i] );
+        SCENEGRAPH* scene = LoadVRML( fname, false );
+        cnt.Show();
+
+        if( NULL == scene )
+            return 1;
+
+        S3D::DestroyNode( (SGNODE*) scene );
+    }
+
+    return 0;
+}
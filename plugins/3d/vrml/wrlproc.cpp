@@ -21,8 +21,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <climits>
+#include <cmath>
 #include <iostream>
 #include <sstream>
+#include <stdint.h>
 #include <wx/filename.h>
 #include <wx/string.h>
 #include <wx/log.h>
@@ -46,6 +49,162 @@
     } } while( 0 )
 
 
+// exact powers of 10 in double precision
+static const double pow10tab[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+// true if the character may follow a value (see ReadGlob)
+static inline bool isValueEnd( char aChar )
+{
+    return aChar <= 0x20 || ',' == aChar || '[' == aChar || ']' == aChar
+        || '{' == aChar || '}' == aChar;
+}
+
+
+// Parse a decimal number without using the locale or any intermediate strings.
+// Only numbers whose mantissa fits in 53 bits and whose power of 10 is at most
+// 22 are accepted, so the value is obtained with a single rounding of a product
+// or quotient of exact doubles; anything else including hexadecimal numbers is
+// rejected and must be handled by the stream based readers.
+static bool parseNumber( const char*& aPtr, const char* aEnd, double& aValue, bool aInteger )
+{
+    const char* cp = aPtr;
+    bool neg = false;
+
+    if( cp < aEnd && ( '-' == *cp || '+' == *cp ) )
+        neg = ( '-' == *cp++ );
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exp10 = 0;
+    const char* start = cp;
+
+    while( cp < aEnd && *cp >= '0' && *cp <= '9' )
+    {
+        if( ++digits > 19 )
+            return false;
+
+        mantissa = mantissa * 10 + ( *cp++ - '0' );
+
+        if( 0 == mantissa )
+            digits = 0;
+    }
+
+    bool hasDigits = cp > start;
+
+    if( !aInteger && cp < aEnd && '.' == *cp )
+    {
+        start = ++cp;
+
+        while( cp < aEnd && *cp >= '0' && *cp <= '9' )
+        {
+            if( ++digits > 19 )
+                return false;
+
+            mantissa = mantissa * 10 + ( *cp++ - '0' );
+            --exp10;
+
+            if( 0 == mantissa )
+                digits = 0;
+        }
+
+        hasDigits = hasDigits || cp > start;
+    }
+
+    if( !hasDigits )
+        return false;
+
+    if( !aInteger && cp < aEnd && ( 'e' == *cp || 'E' == *cp ) )
+    {
+        ++cp;
+        bool negExp = false;
+
+        if( cp < aEnd && ( '-' == *cp || '+' == *cp ) )
+            negExp = ( '-' == *cp++ );
+
+        if( cp == aEnd || *cp < '0' || *cp > '9' )
+            return false;
+
+        int exponent = 0;
+
+        while( cp < aEnd && *cp >= '0' && *cp <= '9' )
+        {
+            exponent = exponent * 10 + ( *cp++ - '0' );
+
+            if( exponent > 1000 )
+                return false;
+        }
+
+        exp10 += negExp ? -exponent : exponent;
+    }
+
+    if( cp < aEnd && !isValueEnd( *cp ) )
+        return false;
+
+    if( mantissa > ( (uint64_t) 1 << 53 ) || exp10 > 22 || exp10 < -22 )
+        return false;
+
+    double value = (double) mantissa;
+
+    if( exp10 < 0 )
+        value /= pow10tab[-exp10];
+    else
+        value *= pow10tab[exp10];
+
+    aValue = neg ? -value : value;
+    aPtr = cp;
+    return true;
+}
+
+
+// Round a value parsed by parseNumber() to float.  The double is the correctly rounded
+// value of the decimal, and rounding it again to float gives the same float as strtof()
+// does in a single rounding, except when the double is exactly halfway between two
+// floats: the decimal may then be on either side of the midpoint.  Those values are
+// rejected and left to the stream based readers.
+static bool toFloat( double aValue, float& aFloat )
+{
+    float value = (float) aValue;
+
+    if( std::isinf( value ) )
+        return false;
+
+    if( (double) value != aValue )
+    {
+        float next = std::nextafter( value, aValue > value ? HUGE_VALF : -HUGE_VALF );
+
+        // the sum of two adjacent floats and its half are exact in double precision
+        if( 0.5 * ( (double) value + (double) next ) == aValue )
+            return false;
+    }
+
+    aFloat = value;
+    return true;
+}
+
+
+// skip the blank space and at most one comma after a value
+static inline const char* skipSeparator( const char* aPtr, const char* aEnd )
+{
+    while( aPtr < aEnd && *aPtr <= 0x20 )
+        ++aPtr;
+
+    if( aPtr < aEnd && ',' == *aPtr )
+    {
+        ++aPtr;
+
+        while( aPtr < aEnd && *aPtr <= 0x20 )
+            ++aPtr;
+    }
+
+    return aPtr;
+}
+
+
 WRLPROC::WRLPROC( LINE_READER* aLineReader )
 {
     m_fileVersion = VRML_INVALID;
@@ -218,6 +377,97 @@ RETRY:
 }
 
 
+size_t WRLPROC::scanMFFloat( std::vector< float >& aMFFloat )
+{
+    const char* sp = m_buf.data();
+    const char* cp = sp + m_bufpos;
+    const char* ep = sp + m_buf.size();
+    size_t nvals = 0;
+    double value;
+    float  fvalue;
+
+    while( cp < ep && ']' != *cp )
+    {
+        const char* vp = cp;
+
+        if( !parseNumber( cp, ep, value, false ) || !toFloat( value, fvalue ) )
+        {
+            cp = vp;
+            break;
+        }
+
+        aMFFloat.push_back( fvalue );
+        cp = skipSeparator( cp, ep );
+        ++nvals;
+    }
+
+    m_bufpos = cp - sp;
+    return nvals;
+}
+
+
+size_t WRLPROC::scanMFInt( std::vector< int >& aMFInt32 )
+{
+    const char* sp = m_buf.data();
+    const char* cp = sp + m_bufpos;
+    const char* ep = sp + m_buf.size();
+    size_t nvals = 0;
+    double value;
+
+    while( cp < ep && ']' != *cp )
+    {
+        const char* vp = cp;
+
+        if( !parseNumber( cp, ep, value, true ) || value > INT_MAX || value < INT_MIN )
+        {
+            cp = vp;
+            break;
+        }
+
+        aMFInt32.push_back( (int) value );
+        cp = skipSeparator( cp, ep );
+        ++nvals;
+    }
+
+    m_bufpos = cp - sp;
+    return nvals;
+}
+
+
+size_t WRLPROC::scanMFVec3f( std::vector< WRLVEC3F >& aMFVec3f )
+{
+    const char* sp = m_buf.data();
+    const char* cp = sp + m_bufpos;
+    const char* ep = sp + m_buf.size();
+    size_t nvals = 0;
+    double value;
+    float  fvalue[3];
+
+    while( cp < ep && ']' != *cp )
+    {
+        // a triplet may be split across lines; in that case it is left for ReadSFVec3f
+        const char* vp = cp;
+        int i = 0;
+
+        for( ; i < 3 && cp < ep && ']' != *cp && parseNumber( cp, ep, value, false )
+               && toFloat( value, fvalue[i] ); ++i )
+            cp = skipSeparator( cp, ep );
+
+        if( i < 3 )
+        {
+            cp = vp;
+            break;
+        }
+
+        aMFVec3f.push_back( WRLVEC3F( fvalue[0], fvalue[1], fvalue[2] ) );
+        ++nvals;
+    }
+
+    m_bufpos = cp - sp;
+    return nvals;
+}
+
+
 WRLVERSION WRLPROC::GetVRMLType( void )
 {
     return m_fileVersion;
@@ -1444,6 +1694,10 @@ bool WRLPROC::ReadMFFloat( std::vector< float >& aMFFloat )
         if( ']' == m_buf[m_bufpos] )
             break;
 
+        // parse the plain numbers on the current line in bulk
+        if( scanMFFloat( aMFFloat ) > 0 )
+            continue;
+
         if( !ReadSFFloat( temp ) )
         {
             std::ostringstream ostr;
@@ -1556,6 +1810,10 @@ bool WRLPROC::ReadMFInt( std::vector< int >& aMFInt32 )
         if( ']' == m_buf[m_bufpos] )
             break;
 
+        // parse the plain numbers on the current line in bulk
+        if( scanMFInt( aMFInt32 ) > 0 )
+            continue;
+
         if( !ReadSFInt( temp ) )
         {
             std::ostringstream ostr;
@@ -1892,6 +2150,10 @@ bool WRLPROC::ReadMFVec3f( std::vector< WRLVEC3F >& aMFVec3f )
         if( ']' == m_buf[m_bufpos] )
             break;
 
+        // parse the plain numbers on the current line in bulk
+        if( scanMFVec3f( aMFVec3f ) > 0 )
+            continue;
+
         if( !ReadSFVec3f( lvec3f ) )
         {
             std::ostringstream ostr;
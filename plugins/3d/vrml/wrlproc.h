@@ -58,6 +58,15 @@ private:
     // parameters are updated as appropriate.
     bool getRawLine( void );
 
+    // The scan* functions parse as many values as possible of an array
+    // directly from the current line and advance m_bufpos past them; they
+    // stop at the end of the line, at ']' or at any text which is not a plain
+    // decimal number so that the caller may continue with the generic
+    // readers. The number of values parsed is returned.
+    size_t scanMFFloat( std::vector< float >& aMFFloat );
+    size_t scanMFInt( std::vector< int >& aMFInt32 );
+    size_t scanMFVec3f( std::vector< WRLVEC3F >& aMFVec3f );
+
 public:
     WRLPROC( LINE_READER* aLineReader );
     ~WRLPROC();
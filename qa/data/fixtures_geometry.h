@@ -295,4 +295,38 @@ struct IteratorFixture {
     ~IteratorFixture(){}
 };
 
+/**
+ * Fixture for the test suites building polygons from squares, e.g. the Fracture suite.
+ */
+struct SquareFixture
+{
+    /**
+     * @return a closed square of side aSize, from (aX, aY) to (aX + aSize, aY + aSize).
+     */
+    static SHAPE_LINE_CHAIN square( int aX, int aY, int aSize )
+    {
+        SHAPE_LINE_CHAIN chain;
+
+        chain.Append( aX, aY );
+        chain.Append( aX, aY + aSize );
+        chain.Append( aX + aSize, aY + aSize );
+        chain.Append( aX + aSize, aY );
+        chain.SetClosed( true );
+
+        return chain;
+    }
+
+    /**
+     * @return a polygon set holding the single outline square( 0, 0, 1000 ).
+     */
+    static SHAPE_POLY_SET squareSet()
+    {
+        SHAPE_POLY_SET poly;
+
+        poly.AddOutline( square( 0, 0, 1000 ) );
+
+        return poly;
+    }
+};
+
 #endif //__FIXTURES_H
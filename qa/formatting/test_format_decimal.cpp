@@ -0,0 +1,147 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <boost/test/unit_test.hpp>
+#include <format_number.h>
+
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+
+/**
+ * BOARD_ITEM::FormatInternalUnits() writes FormatDecimal( aValue, 6 ), the nanometers in
+ * millimeters, and BOARD_ITEM::FormatAngle() writes FormatDecimal( aAngle, 1 ) for integer
+ * tenths of degree: these tests compare them with the printf() formatting they replaced.
+ */
+BOOST_AUTO_TEST_SUITE( FormatBoardUnits )
+
+static std::string formatDecimal( long long aValue, int aDecimals )
+{
+    char buf[64];
+
+    return std::string( buf, FormatDecimal( buf, aValue, aDecimals ) );
+}
+
+
+/**
+ * The former printf() formatting of FormatInternalUnits(), in millimeters.
+ */
+static std::string printfInternalUnits( int aValue )
+{
+    char   buf[50];
+    int    len;
+    double mm = aValue / 1e6;
+
+    if( mm != 0.0 && std::fabs( mm ) <= 0.0001 )
+    {
+        len = snprintf( buf, sizeof( buf ), "%.10f", mm );
+
+        while( --len > 0 && buf[len] == '0' )
+            buf[len] = '\0';
+
+        if( buf[len] == '.' )
+            buf[len] = '\0';
+        else
+            ++len;
+    }
+    else
+    {
+        len = snprintf( buf, sizeof( buf ), "%.10g", mm );
+    }
+
+    return std::string( buf, len );
+}
+
+
+/**
+ * The printf() formatting of FormatAngle(), in degrees.
+ */
+static std::string printfAngle( double aAngle )
+{
+    char buf[50];
+
+    return std::string( buf, snprintf( buf, sizeof( buf ), "%.10g", aAngle / 10.0 ) );
+}
+
+
+/**
+ * Checks the internal units on the limits of int, the values around the decimal point
+ * and 0.0001 mm, and random values.
+ */
+BOOST_AUTO_TEST_CASE( InternalUnitsLikePrintf )
+{
+    const int values[] = { 0, 1, 9, 10, 99, 100, 101, 1000, 99999, 100000, 100001,
+                           999999, 1000000, 1000001, 1250000, 25400000, 123456789,
+                           INT_MAX };
+
+    for( int value : values )
+    {
+        BOOST_CHECK_EQUAL( formatDecimal( value, 6 ), printfInternalUnits( value ) );
+        BOOST_CHECK_EQUAL( formatDecimal( -value, 6 ), printfInternalUnits( -value ) );
+    }
+
+    BOOST_CHECK_EQUAL( formatDecimal( INT_MIN, 6 ), printfInternalUnits( INT_MIN ) );
+
+    for( int value = -2000000; value <= 2000000; value += 7 )
+        BOOST_CHECK_EQUAL( formatDecimal( value, 6 ), printfInternalUnits( value ) );
+
+    std::mt19937 rng( 1 );
+
+    for( int i = 0; i < 200000; ++i )
+    {
+        int value = (int) rng() >> ( rng() % 32 );
+
+        BOOST_CHECK_EQUAL( formatDecimal( value, 6 ), printfInternalUnits( value ) );
+    }
+}
+
+
+/**
+ * Checks the integer tenths of degree, which are written by FormatDecimal() as long as
+ * they have at most 10 digits.
+ */
+BOOST_AUTO_TEST_CASE( AngleLikePrintf )
+{
+    for( int angle = -7200; angle <= 7200; ++angle )
+        BOOST_CHECK_EQUAL( formatDecimal( angle, 1 ), printfAngle( angle ) );
+
+    const long long angles[] = { 9999999999LL, -9999999999LL, 1000000000LL, 123456789LL };
+
+    for( long long angle : angles )
+        BOOST_CHECK_EQUAL( formatDecimal( angle, 1 ), printfAngle( angle ) );
+
+    std::mt19937_64 rng( 2 );
+
+    for( int i = 0; i < 200000; ++i )
+    {
+        long long angle = (long long) ( rng() % 20000000000ULL ) - 9999999999LL;
+
+        BOOST_CHECK_EQUAL( formatDecimal( angle, 1 ), printfAngle( angle ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,217 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <boost/test/unit_test.hpp>
+#include <format_number.h>
+
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+
+
+BOOST_AUTO_TEST_SUITE( FormatNumber )
+
+static std::string formatInt( long long aValue, int aWidth = 0 )
+{
+    char buf[64];
+
+    return std::string( buf, FormatInt( buf, aValue, aWidth ) );
+}
+
+
+static std::string printfInt( long long aValue, int aWidth = 0 )
+{
+    char buf[64];
+
+    return std::string( buf, snprintf( buf, sizeof( buf ), "%0*lld", aWidth, aValue ) );
+}
+
+
+static std::string formatFixed( double aValue, int aDigits )
+{
+    char buf[400];
+
+    return std::string( buf, FormatFixed( buf, aValue, aDigits ) );
+}
+
+
+static std::string printfFixed( double aValue, int aDigits )
+{
+    char buf[400];
+
+    return std::string( buf, snprintf( buf, sizeof( buf ), "%.*f", aDigits, aValue ) );
+}
+
+
+/**
+ * Checks FormatInt() against printf() on the limits of long long and zero padded widths.
+ */
+BOOST_AUTO_TEST_CASE( IntLikePrintf )
+{
+    const long long values[] = { 0, 1, -1, 9, -9, 10, -10, 123456789, -123456789,
+                                 INT_MAX, INT_MIN, LLONG_MAX, LLONG_MIN };
+
+    for( long long value : values )
+    {
+        for( int width = 0; width < 24; ++width )
+            BOOST_CHECK_EQUAL( formatInt( value, width ), printfInt( value, width ) );
+    }
+
+    std::mt19937_64 rng( 1 );
+
+    for( int i = 0; i < 100000; ++i )
+    {
+        long long value = (long long) rng() >> ( rng() % 64 );
+        int       width = rng() % 12;
+
+        BOOST_CHECK_EQUAL( formatInt( value, width ), printfInt( value, width ) );
+    }
+}
+
+
+/**
+ * Checks that the exact ties are rounded to even, as printf() does, and the values next
+ * to them away from the tie.
+ */
+BOOST_AUTO_TEST_CASE( FixedRoundingTies )
+{
+    const double ties[] = { 0.5, 1.5, 2.5, 3.5, -0.5, -1.5, -2.5, 0.125, 0.375, -0.625,
+                            1.0625, 2.03125, 4503599627370495.5 };
+
+    for( double value : ties )
+    {
+        for( int digits = 0; digits < 10; ++digits )
+        {
+            BOOST_CHECK_EQUAL( formatFixed( value, digits ), printfFixed( value, digits ) );
+            BOOST_CHECK_EQUAL( formatFixed( std::nextafter( value, 0.0 ), digits ),
+                               printfFixed( std::nextafter( value, 0.0 ), digits ) );
+            BOOST_CHECK_EQUAL( formatFixed( std::nextafter( value, 2 * value ), digits ),
+                               printfFixed( std::nextafter( value, 2 * value ), digits ) );
+        }
+    }
+
+    BOOST_CHECK_EQUAL( formatFixed( 2.5, 0 ), "2" );
+    BOOST_CHECK_EQUAL( formatFixed( 0.125, 2 ), "0.12" );
+    BOOST_CHECK_EQUAL( formatFixed( 0.375, 2 ), "0.38" );
+
+    // 2.675 is stored below the tie, 1.005 too
+    BOOST_CHECK_EQUAL( formatFixed( 2.675, 2 ), "2.67" );
+    BOOST_CHECK_EQUAL( formatFixed( 1.005, 2 ), "1.00" );
+
+    // the exact ties k / 2^n with n <= the digits, which printf() rounds to even
+    std::mt19937_64 rng( 2 );
+
+    for( int i = 0; i < 100000; ++i )
+    {
+        int    digits = rng() % 10;
+        double value = std::ldexp( (double) (long long) ( rng() % 2000000001 ) - 1e9,
+                                   -(int) ( rng() % ( digits + 1 ) ) - 1 );
+
+        BOOST_CHECK_EQUAL( formatFixed( value, digits ), printfFixed( value, digits ) );
+    }
+}
+
+
+/**
+ * Checks that negative zero and the negative values rounded to zero keep their sign.
+ */
+BOOST_AUTO_TEST_CASE( FixedNegativeZero )
+{
+    for( int digits = 0; digits < 10; ++digits )
+    {
+        BOOST_CHECK_EQUAL( formatFixed( -0.0, digits ), printfFixed( -0.0, digits ) );
+        BOOST_CHECK_EQUAL( formatFixed( 0.0, digits ), printfFixed( 0.0, digits ) );
+        BOOST_CHECK_EQUAL( formatFixed( -1e-12, digits ), printfFixed( -1e-12, digits ) );
+        BOOST_CHECK_EQUAL( formatFixed( -DBL_MIN, digits ), printfFixed( -DBL_MIN, digits ) );
+    }
+
+    BOOST_CHECK_EQUAL( formatFixed( -0.0, 3 ), "-0.000" );
+    BOOST_CHECK_EQUAL( formatFixed( -0.0004, 3 ), "-0.000" );
+}
+
+
+/**
+ * Checks the values around the limit of the integer path, and the large values written
+ * by the stream formatting.
+ */
+BOOST_AUTO_TEST_CASE( FixedLargeValues )
+{
+    const double values[] = { 4.5e15, 9007199254740992.0, 1e17, 1e20, 123456789012345678.0,
+                              1e100, 1e300, DBL_MAX };
+
+    for( double value : values )
+    {
+        for( int digits = 0; digits < 12; ++digits )
+        {
+            BOOST_CHECK_EQUAL( formatFixed( value, digits ), printfFixed( value, digits ) );
+            BOOST_CHECK_EQUAL( formatFixed( -value, digits ), printfFixed( -value, digits ) );
+        }
+    }
+
+    // the largest scaled values of the integer path, for each count of digits
+    for( int digits = 0; digits < 10; ++digits )
+    {
+        double value = 4.5e15 / std::pow( 10.0, digits );
+
+        for( int i = 0; i < 100; ++i )
+        {
+            value = std::nextafter( value, 0.0 );
+            BOOST_CHECK_EQUAL( formatFixed( value, digits ), printfFixed( value, digits ) );
+        }
+    }
+}
+
+
+/**
+ * Checks FormatFixed() against printf() on random values of all magnitudes.
+ */
+BOOST_AUTO_TEST_CASE( FixedLikePrintf )
+{
+    std::mt19937_64 rng( 3 );
+
+    for( int i = 0; i < 200000; ++i )
+    {
+        double   value;
+        uint64_t bits = rng();
+
+        memcpy( &value, &bits, sizeof( value ) );
+
+        // keep the values of usual magnitudes more often than the raw bit patterns
+        if( i % 4 )
+            value = std::ldexp( (double) (long long) rng(), -(int) ( rng() % 90 ) );
+
+        if( std::isnan( value ) || std::isinf( value ) )
+            continue;
+
+        int digits = rng() % 10;
+
+        BOOST_CHECK_EQUAL( formatFixed( value, digits ), printfFixed( value, digits ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+/**
+ * @file fracture_bench.cpp
+ * measures the time spent fracturing a square outline holding a grid of square holes,
+ * as found in copper zones with many thermal reliefs and clearance holes.
+ *
+ * usage: qa_fracture_bench [hole count per row]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <profile.h>
+#include <geometry/shape_poly_set.h>
+#include <geometry/shape_line_chain.h>
+
+#include <qa/data/fixtures_geometry.h>
+
+
+int main( int argc, char* argv[] )
+{
+    int count = argc > 1 ? atoi( argv[1] ) : 100;
+
+    const int pitch = 1000;
+    const int size = 400;
+
+    SHAPE_POLY_SET poly;
+
+    poly.AddOutline( SquareFixture::square( 0, 0, ( count + 1 ) * pitch ) );
+
+    // Offset every other row so holes do not all share the same left-most X
+    for( int j = 1; j <= count; j++ )
+    {
+        for( int i = 1; i <= count; i++ )
+            poly.AddHole( SquareFixture::square( i * pitch + ( j % 2 ) * pitch / 2, j * pitch,
+                                                size ) );
+    }
+
+    PROF_COUNTER fracture( "fracture" );
+    poly.Fracture( SHAPE_POLY_SET::PM_FAST );
+    fracture.Stop();
+
+    printf( "%d holes, %d points in fractured outline\n", count * count,
+            poly.Outline( 0 ).PointCount() );
+    fracture.Show();
+
+    return poly.OutlineCount() == 1 && poly.HoleCount( 0 ) == 0 ? 0 : 1;
+}
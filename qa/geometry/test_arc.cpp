@@ -0,0 +1,179 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <geometry/shape_arc.h>
+#include <geometry/shape_line_chain.h>
+
+
+BOOST_AUTO_TEST_SUITE( Arc )
+
+/**
+ * Checks the exact distances between a quarter of circle and points or segments.
+ */
+BOOST_AUTO_TEST_CASE( Distance )
+{
+    SHAPE_ARC arc( VECTOR2I( 0, 0 ), VECTOR2I( 1000, 0 ), 90.0 );
+
+    BOOST_CHECK_EQUAL( arc.GetP1(), VECTOR2I( 0, 1000 ) );
+
+    // facing the arc, or beyond its ends
+    BOOST_CHECK_EQUAL( arc.Distance( VECTOR2I( 0, 2000 ) ), 1000 );
+    BOOST_CHECK_EQUAL( arc.Distance( VECTOR2I( 300, 400 ) ), 500 );
+    BOOST_CHECK_EQUAL( arc.Distance( VECTOR2I( 1000, -500 ) ), 500 );
+
+    BOOST_CHECK_EQUAL( arc.Distance( SEG( VECTOR2I( 2000, -500 ), VECTOR2I( 2000, 500 ) ) ), 1000 );
+    BOOST_CHECK_EQUAL( arc.Distance( SEG( VECTOR2I( -500, 500 ), VECTOR2I( -500, -500 ) ) ), 707 );
+    BOOST_CHECK_EQUAL( arc.Distance( SEG( VECTOR2I( 500, 500 ), VECTOR2I( 1000, 1000 ) ) ), 0 );
+
+    BOOST_CHECK( arc.Collide( SEG( VECTOR2I( 500, 500 ), VECTOR2I( 1000, 1000 ) ) ) );
+    BOOST_CHECK( !arc.Collide( SEG( VECTOR2I( -500, -500 ), VECTOR2I( -400, -400 ) ), 100 ) );
+
+    const BOX2I bbox = arc.BBox();
+
+    BOOST_CHECK_EQUAL( bbox.GetOrigin(), VECTOR2I( 0, 0 ) );
+    BOOST_CHECK_EQUAL( bbox.GetEnd(), VECTOR2I( 1000, 1000 ) );
+}
+
+
+/**
+ * Checks the exact distances between two arcs, and that both widths count in collisions.
+ */
+BOOST_AUTO_TEST_CASE( ArcToArc )
+{
+    SHAPE_ARC arc( VECTOR2I( 0, 0 ), VECTOR2I( 1000, 0 ), 90.0 );
+
+    // facing each other on the line joining the centers
+    SHAPE_ARC facing( VECTOR2I( 3000, 0 ), VECTOR2I( 2000, 0 ), -90.0 );
+
+    BOOST_CHECK_EQUAL( arc.Distance( facing ), 1000 );
+    BOOST_CHECK_EQUAL( facing.Distance( arc ), 1000 );
+
+    // crossing at ( 500, 866 )
+    SHAPE_ARC crossing( VECTOR2I( 1000, 0 ), VECTOR2I( 1000, 1000 ), 90.0 );
+
+    BOOST_CHECK_EQUAL( arc.Distance( crossing ), 0 );
+
+    // same center, common angle at the end of the quarter
+    SHAPE_ARC concentric( VECTOR2I( 0, 0 ), VECTOR2I( 0, 1500 ), 90.0 );
+
+    BOOST_CHECK_EQUAL( arc.Distance( concentric ), 500 );
+
+    // the width of either arc takes half of the gap
+    const SHAPE* a = &arc;
+    const SHAPE* b = &facing;
+
+    facing.SetWidth( 400 );
+
+    BOOST_CHECK( a->Collide( b, 850 ) );
+    BOOST_CHECK( b->Collide( a, 850 ) );
+    BOOST_CHECK( !a->Collide( b, 750 ) );
+
+    arc.SetWidth( 400 );
+
+    BOOST_CHECK( a->Collide( b, 650 ) );
+    BOOST_CHECK( !b->Collide( a, 550 ) );
+}
+
+
+/**
+ * Checks that a line chain collides with the exact arc rather than with the segments
+ * approximating it, and that the arc can be approximated again.
+ */
+BOOST_AUTO_TEST_CASE( LineChain )
+{
+    const int radius = 100000;
+    SHAPE_ARC        arc( VECTOR2I( 0, 0 ), VECTOR2I( radius, 0 ), 180.0 );
+    SHAPE_LINE_CHAIN chain;
+
+    chain.Append( -2 * radius, 0 );
+    chain.Append( 2 * radius, 0 );
+    chain.Append( radius, 0 );
+    chain.Append( arc, 1000.0 );
+    chain.Append( -2 * radius, 0 );
+
+    int coarseCount = chain.PointCount();
+
+    BOOST_CHECK_EQUAL( chain.ArcIndex( 0 ), -1 );
+    BOOST_CHECK_EQUAL( chain.ArcIndex( 2 ), 0 );
+    BOOST_CHECK_EQUAL( chain.ArcIndex( coarseCount - 3 ), 0 );
+    BOOST_CHECK_EQUAL( chain.ArcIndex( coarseCount - 2 ), -1 );
+    BOOST_CHECK_EQUAL( chain.CPoint( -2 ), arc.GetP1() );
+
+    // the top of the arc is between two points of its approximation
+    BOOST_CHECK_EQUAL( chain.Distance( VECTOR2I( 0, radius + 10 ), true ), 10 );
+    BOOST_CHECK( chain.Collide( VECTOR2I( 0, radius + 10 ), 20 ) );
+
+    const SHAPE_LINE_CHAIN fine = chain.ConvertArcs( 10.0 );
+
+    BOOST_CHECK_GT( fine.PointCount(), 5 * coarseCount );
+    BOOST_CHECK_EQUAL( fine.ArcIndex( 2 ), 0 );
+    BOOST_CHECK_EQUAL( fine.CPoint( -1 ), chain.CPoint( -1 ) );
+
+    const SHAPE_LINE_CHAIN reversed = chain.Reverse();
+
+    BOOST_CHECK_EQUAL( reversed.ArcIndex( 0 ), -1 );
+    BOOST_CHECK_EQUAL( reversed.ArcIndex( 1 ), 0 );
+    BOOST_CHECK_EQUAL( reversed.Arc( 0 ).GetP0(), arc.GetP1() );
+    BOOST_CHECK_EQUAL( reversed.Distance( VECTOR2I( 0, radius + 10 ), true ), 10 );
+
+    // moving a point of the arc makes it a plain polyline
+    chain.Remove( 4 );
+
+    for( int i = 0; i < chain.SegmentCount(); i++ )
+        BOOST_CHECK_EQUAL( chain.ArcIndex( i ), -1 );
+}
+
+
+/**
+ * Checks that the points of an arc given by reference for editing, at either end of the
+ * line chain, make it a plain polyline.
+ */
+BOOST_AUTO_TEST_CASE( EditEndPoints )
+{
+    SHAPE_ARC        arc( VECTOR2I( 0, 0 ), VECTOR2I( 1000, 0 ), 180.0 );
+    SHAPE_LINE_CHAIN chain;
+
+    chain.Append( arc, 10.0 );
+    chain.Append( -1000, -1000 );
+    chain.SetClosed( true );
+
+    BOOST_CHECK_EQUAL( chain.ArcIndex( 0 ), 0 );
+    chain.Point( 0 ) += VECTOR2I( 0, 10 );
+    BOOST_CHECK_EQUAL( chain.ArcIndex( 0 ), -1 );
+
+    // the arc ends the chain
+    SHAPE_LINE_CHAIN open;
+
+    open.Append( 2000, 0 );
+    open.Append( 1000, 0 );
+    open.Append( arc, 10.0 );
+
+    BOOST_CHECK_EQUAL( open.ArcIndex( -1 ), 0 );
+    open.LastPoint() += VECTOR2I( 0, 10 );
+
+    for( int i = 0; i < open.SegmentCount(); i++ )
+        BOOST_CHECK_EQUAL( open.ArcIndex( i ), -1 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,147 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <boost/test/unit_test.hpp>
+#include <common.h>
+#include <geometry/shape_poly_set.h>
+#include <geometry/geometry_utils.h>
+#include <convert_basic_shapes_to_polygon.h>
+
+#include <cmath>
+
+
+BOOST_AUTO_TEST_SUITE( ArcApprox )
+
+// ARC_HIGH_DEF and ARC_APPROX_SEGMENTS_COUNT_HIGHT_DEF, in pcbnew units (nm)
+static const int errorMax = 5000;
+static const int maxSegCount = 32;
+
+
+/**
+ * Checks that the count is a multiple of 4, from 8 to the max count, and keeps the error
+ * below the max error until the max count is reached.
+ */
+BOOST_AUTO_TEST_CASE( SegmentCount )
+{
+    for( int radius = 100; radius < 20000000; radius += radius / 8 + 1 )
+    {
+        int count = GetCircleToSegmentCount( radius, errorMax, maxSegCount );
+
+        BOOST_CHECK_EQUAL( count % 4, 0 );
+        BOOST_CHECK( count >= 8 && count <= maxSegCount );
+
+        if( count < maxSegCount )
+            BOOST_CHECK_LE( radius * ( 1.0 - cos( M_PI / count ) ), errorMax );
+    }
+
+    BOOST_CHECK_EQUAL( GetCircleToSegmentCount( 1000, errorMax, maxSegCount ), 8 );
+    BOOST_CHECK_EQUAL( GetCircleToSegmentCount( 500000, errorMax, maxSegCount ), 24 );
+    BOOST_CHECK_EQUAL( GetCircleToSegmentCount( 10000000, errorMax, maxSegCount ), 32 );
+    BOOST_CHECK_EQUAL( GetCircleToSegmentCount( 10000000, errorMax, 16 ), 16 );
+}
+
+
+/**
+ * Builds the clearance holes of a grid of vias and tracks as the zone filler does, once
+ * with the fixed count per circle and once with the count given by the max error, and
+ * checks that the second needs fewer vertices, before and after the subtraction from the
+ * zone, while keeping the clearance.
+ */
+BOOST_AUTO_TEST_CASE( HoleVertexCount )
+{
+    const int clearance = 200000;
+    const int viaRadius = 300000 + clearance;
+    const int trackWidth = 250000 + 2 * clearance;
+    const int pitch = 2000000;
+    const int count = 10;
+
+    SHAPE_POLY_SET fixed;
+    SHAPE_POLY_SET byError;
+
+    int viaSegs = GetCircleToSegmentCount( viaRadius, errorMax, maxSegCount );
+    int trackSegs = GetCircleToSegmentCount( trackWidth / 2, errorMax, maxSegCount );
+
+    for( int i = 0; i < count; i++ )
+    {
+        for( int j = 0; j < count; j++ )
+        {
+            wxPoint center( i * pitch, j * pitch );
+            wxPoint start( center.x + pitch / 4, center.y );
+            wxPoint end( center.x + 3 * pitch / 4, center.y );
+
+            TransformCircleToPolygon( fixed, center,
+                    KiROUND( viaRadius * GetCircletoPolyCorrectionFactor( maxSegCount ) ),
+                    maxSegCount );
+            TransformOvalClearanceToPolygon( fixed, start, end, trackWidth, maxSegCount,
+                    GetCircletoPolyCorrectionFactor( maxSegCount ) );
+
+            TransformCircleToPolygon( byError, center,
+                    KiROUND( viaRadius * GetCircletoPolyCorrectionFactor( viaSegs ) ),
+                    viaSegs );
+            TransformOvalClearanceToPolygon( byError, start, end, trackWidth, trackSegs,
+                    GetCircletoPolyCorrectionFactor( trackSegs ) );
+
+            // the via hole is outside of the clearance circle, within the max error (and the
+            // rounding of the corners to integers)
+            const SHAPE_LINE_CHAIN& via = byError.COutline( byError.OutlineCount() - 2 );
+            VECTOR2I                viaCenter( center.x, center.y );
+
+            BOOST_CHECK_GE( via.Distance( viaCenter, true ), viaRadius - 2 );
+
+            for( int k = 0; k < via.PointCount(); k++ )
+            {
+                BOOST_CHECK_LE( ( via.CPoint( k ) - viaCenter ).EuclideanNorm(),
+                                viaRadius + errorMax );
+            }
+        }
+    }
+
+    BOOST_TEST_MESSAGE( "hole vertices: " << fixed.TotalVertices() << " with "
+                        << maxSegCount << " segments per circle, " << byError.TotalVertices()
+                        << " within the max error" );
+
+    BOOST_CHECK_LT( byError.TotalVertices() * 4, fixed.TotalVertices() * 3 );
+
+    // the zone area left by the holes
+    SHAPE_POLY_SET zoneFixed;
+    SHAPE_POLY_SET zoneByError;
+
+    zoneFixed.NewOutline();
+    zoneFixed.Append( -pitch, -pitch );
+    zoneFixed.Append( count * pitch, -pitch );
+    zoneFixed.Append( count * pitch, count * pitch );
+    zoneFixed.Append( -pitch, count * pitch );
+    zoneByError = zoneFixed;
+
+    zoneFixed.BooleanSubtract( fixed, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    zoneByError.BooleanSubtract( byError, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+
+    BOOST_TEST_MESSAGE( "zone vertices: " << zoneFixed.TotalVertices() << " with "
+                        << maxSegCount << " segments per circle, "
+                        << zoneByError.TotalVertices() << " within the max error" );
+
+    BOOST_CHECK_LT( zoneByError.TotalVertices() * 5, zoneFixed.TotalVertices() * 4 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,98 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <boost/test/unit_test.hpp>
+#include <geometry/shape_poly_set.h>
+#include <geometry/shape_line_chain.h>
+
+#include <qa/data/fixtures_geometry.h>
+
+
+BOOST_FIXTURE_TEST_SUITE( BooleanPipeline, SquareFixture )
+
+static void checkSame( const SHAPE_POLY_SET& aExpected, const SHAPE_POLY_SET& aActual )
+{
+    BOOST_REQUIRE_EQUAL( aActual.OutlineCount(), aExpected.OutlineCount() );
+
+    for( int ii = 0; ii < aExpected.OutlineCount(); ii++ )
+    {
+        const SHAPE_POLY_SET::POLYGON& expected = aExpected.CPolygon( ii );
+        const SHAPE_POLY_SET::POLYGON& actual = aActual.CPolygon( ii );
+
+        BOOST_REQUIRE_EQUAL( actual.size(), expected.size() );
+
+        for( size_t jj = 0; jj < expected.size(); jj++ )
+        {
+            BOOST_REQUIRE_EQUAL( actual[jj].PointCount(), expected[jj].PointCount() );
+
+            for( int kk = 0; kk < expected[jj].PointCount(); kk++ )
+                BOOST_CHECK_EQUAL( actual[jj].CPoint( kk ), expected[jj].CPoint( kk ) );
+        }
+    }
+}
+
+
+/**
+ * Checks that chaining operations in a pipeline gives exactly the polygons given by the same
+ * operations done on a SHAPE_POLY_SET, including the vertex order.
+ */
+BOOST_AUTO_TEST_CASE( SameAsSetOperations )
+{
+    SHAPE_POLY_SET outline;
+    SHAPE_POLY_SET holes;
+    SHAPE_POLY_SET more;
+
+    outline.AddOutline( square( 0, 0, 100000 ) );
+    outline.AddOutline( square( 90000, 90000, 50000 ) );
+
+    for( int i = 0; i < 20; i++ )
+    {
+        holes.AddOutline( square( 5000 * i, 3000 * i, 4000 + 100 * i ) );
+        more.AddOutline( square( 100000 - 4000 * i, 2500 * i, 3000 ) );
+    }
+
+    SHAPE_POLY_SET expected = outline;
+
+    expected.Inflate( -1000, 16 );
+    expected.Simplify( SHAPE_POLY_SET::PM_FAST );
+    expected.BooleanSubtract( holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    expected.BooleanAdd( more, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET::BOOLEAN_PIPELINE pipeline( outline );
+    SHAPE_POLY_SET::BOOLEAN_PIPELINE morePipeline( more );
+
+    pipeline.Inflate( -1000, 16 );
+    pipeline.Simplify( SHAPE_POLY_SET::PM_FAST );
+    pipeline.BooleanSubtract( holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    pipeline.BooleanAdd( morePipeline, SHAPE_POLY_SET::PM_FAST );
+
+    checkSame( expected, pipeline.Result() );
+
+    expected.BooleanIntersection( outline, SHAPE_POLY_SET::PM_FAST );
+    pipeline.BooleanIntersection( outline, SHAPE_POLY_SET::PM_FAST );
+
+    checkSame( expected, pipeline.Result() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
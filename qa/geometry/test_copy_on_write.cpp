@@ -0,0 +1,97 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <boost/test/unit_test.hpp>
+#include <geometry/shape_poly_set.h>
+#include <geometry/shape_line_chain.h>
+
+#include <qa/data/fixtures_geometry.h>
+
+
+BOOST_FIXTURE_TEST_SUITE( CopyOnWrite, SquareFixture )
+
+/**
+ * Checks that modifying a copy, or the original, does not change the other one.
+ */
+BOOST_AUTO_TEST_CASE( CopiesAreIndependent )
+{
+    SHAPE_POLY_SET original = squareSet();
+    SHAPE_POLY_SET copy( original );
+    SHAPE_POLY_SET assigned;
+
+    assigned = original;
+
+    copy.Vertex( 0 ) = VECTOR2I( 10, 10 );
+    original.Append( 500, -500 );
+    assigned.DeletePolygon( 0 );
+
+    BOOST_CHECK_EQUAL( original.Outline( 0 ).PointCount(), 5 );
+    BOOST_CHECK_EQUAL( original.CVertex( 0 ), VECTOR2I( 0, 0 ) );
+
+    BOOST_CHECK_EQUAL( copy.Outline( 0 ).PointCount(), 4 );
+    BOOST_CHECK_EQUAL( copy.CVertex( 0 ), VECTOR2I( 10, 10 ) );
+
+    BOOST_CHECK_EQUAL( assigned.OutlineCount(), 0 );
+    BOOST_CHECK_EQUAL( original.OutlineCount(), 1 );
+}
+
+
+/**
+ * Checks that a moved set takes the polygons, and the moved-from set is left empty.
+ */
+BOOST_AUTO_TEST_CASE( Move )
+{
+    SHAPE_POLY_SET original = squareSet();
+    SHAPE_POLY_SET moved( std::move( original ) );
+
+    BOOST_CHECK_EQUAL( moved.Outline( 0 ).PointCount(), 4 );
+    BOOST_CHECK_EQUAL( original.OutlineCount(), 0 );
+
+    original = std::move( moved );
+
+    BOOST_CHECK_EQUAL( original.Outline( 0 ).PointCount(), 4 );
+    BOOST_CHECK_EQUAL( moved.OutlineCount(), 0 );
+
+    // The moved-from set is still usable
+    moved.AddOutline( original.COutline( 0 ) );
+    BOOST_CHECK_EQUAL( moved.Outline( 0 ).PointCount(), 4 );
+}
+
+
+/**
+ * Checks that chamfering does not modify the set, even when it has null segments.
+ */
+BOOST_AUTO_TEST_CASE( ChamferKeepsSet )
+{
+    SHAPE_POLY_SET poly = squareSet();
+
+    poly.Append( 1000, 0, -1, -1, true );
+
+    SHAPE_POLY_SET chamfered = poly.Chamfer( 100 );
+
+    BOOST_CHECK_EQUAL( poly.COutline( 0 ).PointCount(), 5 );
+    BOOST_CHECK_EQUAL( chamfered.COutline( 0 ).PointCount(), 8 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
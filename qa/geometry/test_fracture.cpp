@@ -0,0 +1,100 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <geometry/shape_poly_set.h>
+#include <geometry/shape_line_chain.h>
+
+#include <cmath>
+
+#include <qa/data/fixtures_geometry.h>
+
+
+BOOST_FIXTURE_TEST_SUITE( Fracture, SquareFixture )
+
+/**
+ * Checks the exact outline built for a polygon whose second hole is bridged to the first
+ * one rather than to the outline.
+ */
+BOOST_AUTO_TEST_CASE( BridgeToHole )
+{
+    SHAPE_POLY_SET poly;
+
+    poly.NewOutline();
+    poly.Append( 0, 0 );
+    poly.Append( 1000, 0 );
+    poly.Append( 1000, 1000 );
+    poly.Append( 0, 1000 );
+
+    poly.AddHole( square( 200, 200, 200 ) );
+    poly.AddHole( square( 600, 300, 200 ) );
+
+    poly.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    const VECTOR2I expected[] =
+    {
+        { 1000, 1000 }, { 0, 1000 }, { 0, 200 }, { 200, 200 }, { 200, 400 }, { 400, 400 },
+        { 400, 300 }, { 600, 300 }, { 600, 500 }, { 800, 500 }, { 800, 300 }, { 600, 300 },
+        { 400, 300 }, { 400, 200 }, { 200, 200 }, { 0, 200 }, { 0, 0 }, { 1000, 0 }
+    };
+
+    BOOST_REQUIRE_EQUAL( poly.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( poly.HoleCount( 0 ), 0 );
+    BOOST_REQUIRE_EQUAL( poly.Outline( 0 ).PointCount(),
+                         (int) ( sizeof( expected ) / sizeof( expected[0] ) ) );
+
+    for( int i = 0; i < poly.Outline( 0 ).PointCount(); i++ )
+        BOOST_CHECK_EQUAL( poly.Outline( 0 ).CPoint( i ), expected[i] );
+}
+
+
+/**
+ * Checks that a grid of holes, with many holes sharing the same left-most X, is merged
+ * into a single outline enclosing the same area.
+ */
+BOOST_AUTO_TEST_CASE( HoleGrid )
+{
+    const int count = 30;
+    const int pitch = 1000;
+    const int size = 400;
+
+    SHAPE_POLY_SET poly;
+
+    poly.AddOutline( square( 0, 0, ( count + 1 ) * pitch ) );
+
+    for( int i = 1; i <= count; i++ )
+    {
+        for( int j = 1; j <= count; j++ )
+            poly.AddHole( square( i * pitch, j * pitch, size ) );
+    }
+
+    double area = std::abs( poly.Outline( 0 ).Area() ) - count * count * (double) size * size;
+
+    poly.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_REQUIRE_EQUAL( poly.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( poly.HoleCount( 0 ), 0 );
+    BOOST_CHECK_EQUAL( std::abs( poly.Outline( 0 ).Area() ), area );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,47 @@
+import unittest
+import pcbnew
+
+
+class TestGeometryExport(unittest.TestCase):
+
+    def setUp(self):
+        self.pcb = pcbnew.LoadBoard("data/complex_hierarchy.kicad_pcb")
+
+    def test_tracks(self):
+        records = list(pcbnew.IterRecords(pcbnew.ExportTrackGeometry(self.pcb),
+                                          pcbnew.TRACK_RECORD_FIELDS))
+        tracks = list(self.pcb.GetTracks())
+
+        self.assertEqual(len(records), len(tracks))
+
+        for record, track in zip(records, tracks):
+            fields = dict(zip(pcbnew.TRACK_RECORD_FIELDS, record))
+            self.assertEqual(fields['start_x'], track.GetStart().x)
+            self.assertEqual(fields['end_y'], track.GetEnd().y)
+            self.assertEqual(fields['width'], track.GetWidth())
+            self.assertEqual(fields['net'], track.GetNetCode())
+            self.assertEqual(fields['type'], track.Type())
+
+    def test_pads(self):
+        records = list(pcbnew.IterRecords(pcbnew.ExportPadGeometry(self.pcb),
+                                          pcbnew.PAD_RECORD_FIELDS))
+        pads = [pad for module in self.pcb.GetModules() for pad in module.Pads()]
+
+        self.assertEqual(len(records), len(pads))
+
+        for record, pad in zip(records, pads):
+            fields = dict(zip(pcbnew.PAD_RECORD_FIELDS, record))
+            self.assertEqual(fields['pos_x'], pad.GetPosition().x)
+            self.assertEqual(fields['size_y'], pad.GetSize().y)
+            self.assertEqual(fields['shape'], pad.GetShape())
+
+    def test_zones(self):
+        records = list(pcbnew.IterRecords(pcbnew.ExportZoneGeometry(self.pcb),
+                                          pcbnew.ZONE_VERTEX_RECORD_FIELDS))
+        count = sum(self.pcb.GetArea(ii).GetNumCorners()
+                    for ii in range(self.pcb.GetAreaCount()))
+
+        self.assertEqual(len(records), count)
+
+if __name__ == '__main__':
+    unittest.main()
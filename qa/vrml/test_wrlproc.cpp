@@ -0,0 +1,137 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <boost/test/unit_test.hpp>
+#include <wrlproc.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+
+BOOST_AUTO_TEST_SUITE( WrlProc )
+
+/**
+ * Its nearest double is exactly halfway between two floats, while the decimal is above
+ * the midpoint: (float) strtod() rounds it down to even, strtof() up.
+ */
+static const char doubleRounding[] = "0.007493860321119428";
+
+
+static std::vector<float> readMFFloat( const std::string& aValues )
+{
+    STRING_LINE_READER reader( "#VRML V2.0 utf8\n" + aValues + "\n", wxT( "test" ) );
+    WRLPROC            proc( &reader );
+    std::vector<float> values;
+
+    BOOST_REQUIRE( proc.ReadMFFloat( values ) );
+
+    return values;
+}
+
+
+static std::vector<WRLVEC3F> readMFVec3f( const std::string& aValues )
+{
+    STRING_LINE_READER    reader( "#VRML V2.0 utf8\n" + aValues + "\n", wxT( "test" ) );
+    WRLPROC               proc( &reader );
+    std::vector<WRLVEC3F> values;
+
+    BOOST_REQUIRE( proc.ReadMFVec3f( values ) );
+
+    return values;
+}
+
+
+/**
+ * Checks that the value rounded twice through a double is read as strtof() reads it.
+ */
+BOOST_AUTO_TEST_CASE( DoubleRounding )
+{
+    const float expected = strtof( doubleRounding, NULL );
+
+    BOOST_REQUIRE( (float) strtod( doubleRounding, NULL ) != expected );
+
+    std::vector<float> floats = readMFFloat( std::string( "[ 0.5, " ) + doubleRounding
+                                             + ", 0.25 " + doubleRounding + " ]" );
+
+    BOOST_REQUIRE_EQUAL( floats.size(), 4 );
+    BOOST_CHECK_EQUAL( floats[0], 0.5f );
+    BOOST_CHECK_EQUAL( floats[1], expected );
+    BOOST_CHECK_EQUAL( floats[2], 0.25f );
+    BOOST_CHECK_EQUAL( floats[3], expected );
+
+    std::vector<WRLVEC3F> points = readMFVec3f( std::string( "[ 1 2 3, " ) + doubleRounding
+                                                + " 4 5, 6 " + doubleRounding + " 7 ]" );
+
+    BOOST_REQUIRE_EQUAL( points.size(), 3 );
+    BOOST_CHECK_EQUAL( points[0].x, 1.0f );
+    BOOST_CHECK_EQUAL( points[1].x, expected );
+    BOOST_CHECK_EQUAL( points[1].y, 4.0f );
+    BOOST_CHECK_EQUAL( points[2].y, expected );
+    BOOST_CHECK_EQUAL( points[2].z, 7.0f );
+}
+
+
+/**
+ * Checks the values read in bulk against strtof() on random decimals of 1 to 17 digits,
+ * with and without exponent.
+ */
+BOOST_AUTO_TEST_CASE( MFFloatLikeStrtof )
+{
+    std::mt19937_64          rng( 1 );
+    std::vector<std::string> texts;
+    std::string              line = "[";
+
+    for( int i = 0; i < 100000; ++i )
+    {
+        std::string digits;
+        int         count = 1 + rng() % 17;
+
+        for( int j = 0; j < count; ++j )
+            digits += (char) ( '0' + rng() % 10 );
+
+        size_t      point = rng() % ( digits.size() + 1 );
+        std::string text = digits.substr( 0, point ) + "." + digits.substr( point );
+
+        if( rng() % 3 == 0 )
+            text += "e" + std::to_string( (int) ( rng() % 41 ) - 20 );
+
+        if( rng() % 2 )
+            text = "-" + text;
+
+        texts.push_back( text );
+        line += " " + text + ( i % 10 == 9 ? ",\n" : "," );
+    }
+
+    std::vector<float> floats = readMFFloat( line + " ]" );
+
+    BOOST_REQUIRE_EQUAL( floats.size(), texts.size() );
+
+    for( size_t i = 0; i < texts.size(); ++i )
+        BOOST_CHECK_EQUAL( floats[i], strtof( texts[i].c_str(), NULL ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -33,10 +33,12 @@
 
 #include <sstream>
 #include <string>
+#include <cstring>
 #include <iomanip>
 #include <cmath>
 #include <vrml_layer.h>
 #include <trigo.h>
+#include <format_number.h>       // FormatInt, FormatFixed
 
 #ifndef CALLBACK
 #define CALLBACK
@@ -47,39 +49,111 @@
 // minimum sides to a circle
 #define MIN_NSIDES 6
 
-static void FormatDoublet( double x, double y, int precision, std::string& strx, std::string& stry )
+/**
+ * Formats the numbers written to a VRML file into a local buffer, which is written to
+ * the output stream by blocks.  This avoids the temporary strings and the locale lookups
+ * of the formatted stream output, which dominate the time spent writing large layers.
+ */
+class VRML_WRITER
 {
-    std::ostringstream ostr;
+public:
+    VRML_WRITER( std::ostream& aStream ) :
+        m_stream( aStream ),
+        m_end( m_buffer )
+    {
+    }
 
-    ostr << std::fixed << std::setprecision( precision );
+    ~VRML_WRITER()
+    {
+        Flush();
+    }
 
-    ostr << x;
-    strx = ostr.str();
+    VRML_WRITER& operator<<( const char* aText )
+    {
+        size_t len = strlen( aText );
 
-    ostr.str( "" );
-    ostr << y;
-    stry = ostr.str();
+        reserve( len );
 
-    while( *strx.rbegin() == '0' )
-        strx.erase( strx.size() - 1 );
+        if( len > sizeof( m_buffer ) )
+        {
+            m_stream.write( aText, len );
+        }
+        else
+        {
+            memcpy( m_end, aText, len );
+            m_end += len;
+        }
 
-    while( *stry.rbegin() == '0' )
-        stry.erase( stry.size() - 1 );
-}
+        return *this;
+    }
 
+    VRML_WRITER& operator<<( char aChar )
+    {
+        reserve( 1 );
+        *m_end++ = aChar;
 
-static void FormatSinglet( double x, int precision, std::string& strx )
-{
-    std::ostringstream ostr;
+        return *this;
+    }
 
-    ostr << std::fixed << std::setprecision( precision );
+    VRML_WRITER& operator<<( int aValue )
+    {
+        reserve( 12 );
+        m_end = FormatInt( m_end, aValue );
 
-    ostr << x;
-    strx = ostr.str();
+        return *this;
+    }
 
-    while( *strx.rbegin() == '0' )
-        strx.erase( strx.size() - 1 );
-}
+    /**
+     * Writes aValue with aPrecision decimals and without its trailing zeros, i.e. as
+     * std::fixed << std::setprecision( aPrecision ) followed by the removal of the
+     * trailing '0' characters.
+     */
+    void Fixed( double aValue, int aPrecision )
+    {
+        // FormatFixed() writes all the integer digits: flush the buffer when it could
+        // not hold the largest doubles
+        reserve( 320 + aPrecision );
+
+        char* end = FormatFixed( m_end, aValue, aPrecision );
+
+        if( aPrecision > 0 )
+        {
+            while( end[-1] == '0' )
+                --end;
+        }
+
+        m_end = end;
+    }
+
+    /**
+     * Writes the coordinates of a vertex, separated by spaces.
+     */
+    void Vertex( double aX, double aY, double aZ, int aPrecision )
+    {
+        Fixed( aX, aPrecision );
+        *this << ' ';
+        Fixed( aY, aPrecision );
+        *this << ' ';
+        Fixed( aZ, aPrecision );
+    }
+
+    void Flush()
+    {
+        m_stream.write( m_buffer, m_end - m_buffer );
+        m_end = m_buffer;
+    }
+
+private:
+    void reserve( size_t aSize )
+    {
+        if( m_end + aSize > m_buffer + sizeof( m_buffer ) )
+            Flush();
+    }
+
+    std::ostream& m_stream;
+    char          m_buffer[16384];
+    char*         m_end;
+};
 
 
 int VRML_LAYER::calcNSides( double aRadius, double aAngle )
@@ -269,6 +343,30 @@ void VRML_LAYER::Clear( void )
 }
 
 
+// copy the contours of another object
+void VRML_LAYER::CopyContours( const VRML_LAYER& aSource )
+{
+    Clear();
+
+    for( unsigned int i = 0; i < aSource.vertices.size(); ++i )
+    {
+        VERTEX_3D* vertex = new VERTEX_3D( *aSource.vertices[i] );
+
+        vertex->i = i;
+        vertex->o = -1;
+        vertices.push_back( vertex );
+    }
+
+    for( unsigned int i = 0; i < aSource.contours.size(); ++i )
+        contours.push_back( new std::list<int>( *aSource.contours[i] ) );
+
+    pth = aSource.pth;
+    areas = aSource.areas;
+    idx = aSource.idx;
+    fix = aSource.fix;
+}
+
+
 // clear ephemeral data in between invocations of the tesselation routine
 void VRML_LAYER::clearTmp( void )
 {
@@ -1014,11 +1112,9 @@ bool VRML_LAYER::WriteVertices( double aZcoord, std::ostream& aOutFile, int aPre
     if( !vp )
         return false;
 
-    std::string strx, stry, strz;
-    FormatDoublet( vp->x + offsetX, vp->y + offsetY, aPrecision, strx, stry );
-    FormatSinglet( aZcoord, aPrecision, strz );
+    VRML_WRITER out( aOutFile );
 
-    aOutFile << strx << " " << stry << " " << strz;
+    out.Vertex( vp->x + offsetX, vp->y + offsetY, aZcoord, aPrecision );
 
     for( i = 1, j = ordmap.size(); i < j; ++i )
     {
@@ -1027,14 +1123,12 @@ bool VRML_LAYER::WriteVertices( double aZcoord, std::ostream& aOutFile, int aPre
         if( !vp )
             return false;
 
-        FormatDoublet( vp->x + offsetX, vp->y + offsetY, aPrecision, strx, stry );
-
-        if( i & 1 )
-            aOutFile << ", " << strx << " " << stry << " " << strz;
-        else
-            aOutFile << ",\n" << strx << " " << stry << " " << strz;
+        out << ( ( i & 1 ) ? ", " : ",\n" );
+        out.Vertex( vp->x + offsetX, vp->y + offsetY, aZcoord, aPrecision );
     }
 
+    out.Flush();
+
     return !aOutFile.fail();
 }
 
@@ -1066,11 +1160,9 @@ bool VRML_LAYER::Write3DVertices( double aTopZ, double aBottomZ,
     if( !vp )
         return false;
 
-    std::string strx, stry, strz;
-    FormatDoublet( vp->x + offsetX, vp->y + offsetY, aPrecision, strx, stry );
-    FormatSinglet( aTopZ, aPrecision, strz );
+    VRML_WRITER out( aOutFile );
 
-    aOutFile << strx << " " << stry << " " << strz;
+    out.Vertex( vp->x + offsetX, vp->y + offsetY, aTopZ, aPrecision );
 
     for( i = 1, j = ordmap.size(); i < j; ++i )
     {
@@ -1079,49 +1171,29 @@ bool VRML_LAYER::Write3DVertices( double aTopZ, double aBottomZ,
         if( !vp )
             return false;
 
-        FormatDoublet( vp->x + offsetX, vp->y + offsetY, aPrecision, strx, stry );
-
-        if( i & 1 )
-            aOutFile << ", " << strx << " " << stry << " " << strz;
-        else
-            aOutFile << ",\n" << strx << " " << stry << " " << strz;
+        out << ( ( i & 1 ) ? ", " : ",\n" );
+        out.Vertex( vp->x + offsetX, vp->y + offsetY, aTopZ, aPrecision );
     }
 
     // repeat for the bottom layer
     vp = getVertexByIndex( ordmap[0], pholes );
-    FormatDoublet( vp->x + offsetX, vp->y + offsetY, aPrecision, strx, stry );
-    FormatSinglet( aBottomZ, aPrecision, strz );
 
-    bool endl;
+    bool endl = !( i & 1 );
 
-    if( i & 1 )
-    {
-        aOutFile << ", " << strx << " " << stry << " " << strz;
-        endl = false;
-    }
-    else
-    {
-        aOutFile << ",\n" << strx << " " << stry << " " << strz;
-        endl = true;
-    }
+    out << ( endl ? ",\n" : ", " );
+    out.Vertex( vp->x + offsetX, vp->y + offsetY, aBottomZ, aPrecision );
 
     for( i = 1, j = ordmap.size(); i < j; ++i )
     {
         vp = getVertexByIndex( ordmap[i], pholes );
-        FormatDoublet( vp->x + offsetX, vp->y + offsetY, aPrecision, strx, stry );
 
-        if( endl )
-        {
-            aOutFile << ", " << strx << " " << stry << " " << strz;
-            endl = false;
-        }
-        else
-        {
-            aOutFile << ",\n" << strx << " " << stry << " " << strz;
-            endl = true;
-        }
+        out << ( endl ? ", " : ",\n" );
+        out.Vertex( vp->x + offsetX, vp->y + offsetY, aBottomZ, aPrecision );
+        endl = !endl;
     }
 
+    out.Flush();
+
     return !aOutFile.fail();
 }
 
@@ -1140,13 +1212,14 @@ bool VRML_LAYER::WriteIndices( bool aTopFlag, std::ostream& aOutFile )
     // go through the triplet list and write out the indices based on order
     std::list<TRIPLET_3D>::const_iterator   tbeg    = triplets.begin();
     std::list<TRIPLET_3D>::const_iterator   tend    = triplets.end();
+    VRML_WRITER out( aOutFile );
 
     int i = 1;
 
     if( aTopFlag )
-        aOutFile << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
+        out << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
     else
-        aOutFile << tbeg->i2 << ", " << tbeg->i1 << ", " << tbeg->i3  << ", -1";
+        out << tbeg->i2 << ", " << tbeg->i1 << ", " << tbeg->i3  << ", -1";
 
     ++tbeg;
 
@@ -1157,21 +1230,23 @@ bool VRML_LAYER::WriteIndices( bool aTopFlag, std::ostream& aOutFile )
             i = 1;
 
             if( aTopFlag )
-                aOutFile << ",\n" << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
+                out << ",\n" << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
             else
-                aOutFile << ",\n" << tbeg->i2 << ", " << tbeg->i1 << ", " << tbeg->i3  << ", -1";
+                out << ",\n" << tbeg->i2 << ", " << tbeg->i1 << ", " << tbeg->i3  << ", -1";
         }
         else
         {
             if( aTopFlag )
-                aOutFile << ", " << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
+                out << ", " << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
             else
-                aOutFile << ", " << tbeg->i2 << ", " << tbeg->i1 << ", " << tbeg->i3  << ", -1";
+                out << ", " << tbeg->i2 << ", " << tbeg->i1 << ", " << tbeg->i3  << ", -1";
         }
 
         ++tbeg;
     }
 
+    out.Flush();
+
     return !aOutFile.fail();
 }
 
@@ -1187,6 +1262,7 @@ bool VRML_LAYER::Write3DIndices( std::ostream& aOutFile, bool aIncludePlatedHole
 
     char mark;
     bool holes_only = triplets.empty();
+    VRML_WRITER out( aOutFile );
 
     int i = 1;
     int idx2 = ordmap.size();    // index to the bottom vertices
@@ -1200,7 +1276,7 @@ bool VRML_LAYER::Write3DIndices( std::ostream& aOutFile, bool aIncludePlatedHole
         std::list<TRIPLET_3D>::const_iterator   tend    = triplets.end();
 
         // print out the top vertices
-        aOutFile << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
+        out << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
         ++tbeg;
 
         while( tbeg != tend )
@@ -1208,11 +1284,11 @@ bool VRML_LAYER::Write3DIndices( std::ostream& aOutFile, bool aIncludePlatedHole
             if( (i++ & 7) == 4 )
             {
                 i = 1;
-                aOutFile << ",\n" << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
+                out << ",\n" << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
             }
             else
             {
-                aOutFile << ", " << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
+                out << ", " << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
             }
 
             ++tbeg;
@@ -1226,11 +1302,11 @@ bool VRML_LAYER::Write3DIndices( std::ostream& aOutFile, bool aIncludePlatedHole
             if( (i++ & 7) == 4 )
             {
                 i = 1;
-                aOutFile << ",\n" << (tbeg->i2 + idx2) << ", " << (tbeg->i1 + idx2) << ", " << (tbeg->i3  + idx2) << ", -1";
+                out << ",\n" << (tbeg->i2 + idx2) << ", " << (tbeg->i1 + idx2) << ", " << (tbeg->i3  + idx2) << ", -1";
             }
             else
             {
-                aOutFile << ", " << (tbeg->i2 + idx2) << ", " << (tbeg->i1 + idx2) << ", " << (tbeg->i3  + idx2) << ", -1";
+                out << ", " << (tbeg->i2 + idx2) << ", " << (tbeg->i1 + idx2) << ", " << (tbeg->i3  + idx2) << ", -1";
             }
 
             ++tbeg;
@@ -1285,13 +1361,13 @@ bool VRML_LAYER::Write3DIndices( std::ostream& aOutFile, bool aIncludePlatedHole
                 if( (i++ & 3) == 2 )
                 {
                     i = 1;
-                    aOutFile << mark << "\n" << curPoint << ", " << lastPoint << ", " << curPoint + idx2;
-                    aOutFile << ", -1, " << curPoint + idx2 << ", " << lastPoint << ", " << lastPoint + idx2 << ", -1";
+                    out << mark << "\n" << curPoint << ", " << lastPoint << ", " << curPoint + idx2;
+                    out << ", -1, " << curPoint + idx2 << ", " << lastPoint << ", " << lastPoint + idx2 << ", -1";
                 }
                 else
                 {
-                    aOutFile << mark << " " << curPoint << ", " << lastPoint << ", " << curPoint + idx2;
-                    aOutFile << ", -1, " << curPoint + idx2 << ", " << lastPoint << ", " << lastPoint + idx2 << ", -1";
+                    out << mark << " " << curPoint << ", " << lastPoint << ", " << curPoint + idx2;
+                    out << ", -1, " << curPoint + idx2 << ", " << lastPoint << ", " << lastPoint + idx2 << ", -1";
                 }
             }
             else
@@ -1299,13 +1375,13 @@ bool VRML_LAYER::Write3DIndices( std::ostream& aOutFile, bool aIncludePlatedHole
                 if( (i++ & 3) == 2 )
                 {
                     i = 1;
-                    aOutFile << mark << "\n" << curPoint << ", " << curPoint + idx2 << ", " << lastPoint;
-                    aOutFile << ", -1, " << curPoint + idx2 << ", " << lastPoint + idx2 << ", " << lastPoint << ", -1";
+                    out << mark << "\n" << curPoint << ", " << curPoint + idx2 << ", " << lastPoint;
+                    out << ", -1, " << curPoint + idx2 << ", " << lastPoint + idx2 << ", " << lastPoint << ", -1";
                 }
                 else
                 {
-                    aOutFile << mark << " " << curPoint << ", " << curPoint + idx2 << ", " << lastPoint;
-                    aOutFile << ", -1, " << curPoint + idx2 << ", " << lastPoint + idx2 << ", " << lastPoint << ", -1";
+                    out << mark << " " << curPoint << ", " << curPoint + idx2 << ", " << lastPoint;
+                    out << ", -1, " << curPoint + idx2 << ", " << lastPoint + idx2 << ", " << lastPoint << ", -1";
                 }
             }
 
@@ -1324,26 +1400,26 @@ bool VRML_LAYER::Write3DIndices( std::ostream& aOutFile, bool aIncludePlatedHole
         {
             if( (i++ & 3) == 2 )
             {
-                aOutFile << ",\n" << curPoint << ", " << lastPoint << ", " << curPoint + idx2;
-                aOutFile << ", -1, " << curPoint + idx2 << ", " << lastPoint << ", " << lastPoint + idx2 << ", -1";
+                out << ",\n" << curPoint << ", " << lastPoint << ", " << curPoint + idx2;
+                out << ", -1, " << curPoint + idx2 << ", " << lastPoint << ", " << lastPoint + idx2 << ", -1";
             }
             else
             {
-                aOutFile << ", " << curPoint << ", " << lastPoint << ", " << curPoint + idx2;
-                aOutFile << ", -1, " << curPoint + idx2 << ", " << lastPoint << ", " << lastPoint + idx2 << ", -1";
+                out << ", " << curPoint << ", " << lastPoint << ", " << curPoint + idx2;
+                out << ", -1, " << curPoint + idx2 << ", " << lastPoint << ", " << lastPoint + idx2 << ", -1";
             }
         }
         else
         {
             if( (i++ & 3) == 2 )
             {
-                aOutFile << ",\n" << curPoint << ", " << curPoint + idx2 << ", " << lastPoint;
-                aOutFile << ", -1, " << curPoint + idx2 << ", " << lastPoint + idx2 << ", " << lastPoint << ", -1";
+                out << ",\n" << curPoint << ", " << curPoint + idx2 << ", " << lastPoint;
+                out << ", -1, " << curPoint + idx2 << ", " << lastPoint + idx2 << ", " << lastPoint << ", -1";
             }
             else
             {
-                aOutFile << ", " << curPoint << ", " << curPoint + idx2 << ", " << lastPoint;
-                aOutFile << ", -1, " << curPoint + idx2 << ", " << lastPoint + idx2 << ", " << lastPoint << ", -1";
+                out << ", " << curPoint << ", " << curPoint + idx2 << ", " << lastPoint;
+                out << ", -1, " << curPoint + idx2 << ", " << lastPoint + idx2 << ", " << lastPoint << ", -1";
             }
         }
 
@@ -1351,6 +1427,8 @@ bool VRML_LAYER::Write3DIndices( std::ostream& aOutFile, bool aIncludePlatedHole
         ++curContour;
     }
 
+    out.Flush();
+
     return !aOutFile.fail();
 }
 
@@ -180,6 +180,16 @@ public:
      */
     void Clear( void );
 
+    /**
+     * Function CopyContours
+     * replaces all data by a copy of the contours of another object.  The tesselation
+     * renumbers the vertices of the holes object it is given, so layers which are
+     * tesselated concurrently must each use their own copy of the holes.
+     *
+     * @param aSource is the object whose contours are copied
+     */
+    void CopyContours( const VRML_LAYER& aSource );
+
     /**
      * Function GetSize
      * returns the total number of vertices indexed